@@ -0,0 +1,280 @@
+/*********************                                                        */
+/*! \file smt-switch-bench.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Micro-benchmarks of the core smt-switch API for every available
+**        solver configuration.
+**
+** Benchmarks are named <benchmark>/<solver configuration>/<size>, e.g.
+** make_term/Z3(logging=0). Run with --benchmark_out=<file>
+** --benchmark_out_format=json to keep the results for regression tracking
+** (see the run-benchmarks target).
+**/
+
+#include <sstream>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "available_solvers.h"
+#include "identity_walker.h"
+#include "smt.h"
+#include "substitution_walker.h"
+#include "term_translator.h"
+
+using namespace smt;
+using namespace smt_tests;
+using namespace std;
+
+namespace {
+
+const uint64_t BV_WIDTH = 32;
+const size_t NUM_LEAVES = 8;
+
+/** Create a bit-vector DAG with NUM_LEAVES symbols and num_ops operators
+ *  Each operator combines the previous term with one from halfway back,
+ *  so subterms are shared like in real queries.
+ *  @param s the solver to build the DAG with
+ *  @param num_ops the number of operator applications
+ *  @param leaves filled with the symbols of the DAG
+ *  @return the root of the DAG
+ */
+Term make_dag(SmtSolver & s, size_t num_ops, TermVec & leaves)
+{
+  Sort bvsort = s->make_sort(BV, BV_WIDTH);
+  for (size_t i = 0; i < NUM_LEAVES; ++i)
+  {
+    leaves.push_back(s->make_symbol("leaf" + std::to_string(i), bvsort));
+  }
+
+  const PrimOp ops[] = { BVAdd, BVMul, BVXor, BVOr };
+  TermVec terms = leaves;
+  for (size_t i = 0; i < num_ops; ++i)
+  {
+    size_t n = terms.size();
+    terms.push_back(s->make_term(ops[i % 4], terms[n - 1], terms[n / 2]));
+  }
+  return terms.back();
+}
+
+/** Count the distinct subterms of a term with TermIter */
+size_t count_subterms(const Term & root)
+{
+  UnorderedTermSet visited;
+  TermVec to_visit({ root });
+  while (to_visit.size())
+  {
+    Term t = to_visit.back();
+    to_visit.pop_back();
+    if (visited.insert(t).second)
+    {
+      for (auto c : t)
+      {
+        to_visit.push_back(c);
+      }
+    }
+  }
+  return visited.size();
+}
+
+void make_term_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  Sort bvsort = s->make_sort(BV, BV_WIDTH);
+  Term x = s->make_symbol("x", bvsort);
+  // a growing chain, so every call creates a new term
+  Term acc = x;
+  for (auto _ : state)
+  {
+    acc = s->make_term(BVAdd, acc, x);
+  }
+  benchmark::DoNotOptimize(acc);
+  state.SetItemsProcessed(state.iterations());
+}
+
+void make_symbol_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  Sort bvsort = s->make_sort(BV, BV_WIDTH);
+  size_t i = 0;
+  for (auto _ : state)
+  {
+    Term x = s->make_symbol("x" + std::to_string(i++), bvsort);
+    benchmark::DoNotOptimize(x);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void term_iter_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  TermVec leaves;
+  Term root = make_dag(s, state.range(0), leaves);
+  size_t n = 0;
+  for (auto _ : state)
+  {
+    n = count_subterms(root);
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+/** Transfer a DAG to another solver of the same configuration
+ *  state.range(1) != 0 lets the TermTranslator use the native translation
+ */
+void transfer_term_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  SmtSolver to = create_solver(sc);
+  TermVec leaves;
+  Term root = make_dag(s, state.range(0), leaves);
+  for (auto _ : state)
+  {
+    // a new translator each time, otherwise everything is cached
+    TermTranslator tt =
+        state.range(1) ? TermTranslator(to, s) : TermTranslator(to);
+    Term t = tt.transfer_term(root);
+    benchmark::DoNotOptimize(t);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/** Rebuild a DAG with an IdentityWalker
+ *  state.range(1) is the CacheKind of the walker
+ */
+void identity_walker_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  TermVec leaves;
+  Term root = make_dag(s, state.range(0), leaves);
+  IdentityWalker iw(s, true, static_cast<CacheKind>(state.range(1)));
+  for (auto _ : state)
+  {
+    Term t = iw.visit(root);
+    benchmark::DoNotOptimize(t);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void substitution_walker_bench(benchmark::State & state,
+                               SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  TermVec leaves;
+  Term root = make_dag(s, state.range(0), leaves);
+  UnorderedTermMap smap;
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    smap[leaves[i]] = leaves[(i + 1) % leaves.size()];
+  }
+  for (auto _ : state)
+  {
+    // the walker's cache is persistent, so it must be new each time
+    SubstitutionWalker sw(s, smap);
+    Term t = sw.visit(root);
+    benchmark::DoNotOptimize(t);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void get_value_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  s->set_opt("produce-models", "true");
+  TermVec leaves;
+  Term root = make_dag(s, 100, leaves);
+  s->assert_formula(s->make_term(
+      Distinct, root, s->make_term(0, s->make_sort(BV, BV_WIDTH))));
+  Result r = s->check_sat();
+  if (!r.is_sat())
+  {
+    state.SkipWithError(("expected sat, got " + r.to_string()).c_str());
+    return;
+  }
+  for (auto _ : state)
+  {
+    Term v = s->get_value(root);
+    benchmark::DoNotOptimize(v);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/** Push a context, assert a formula in it and pop it */
+void push_pop_bench(benchmark::State & state, SolverConfiguration sc)
+{
+  SmtSolver s = create_solver(sc);
+  s->set_opt("incremental", "true");
+  Sort bvsort = s->make_sort(BV, BV_WIDTH);
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term f = s->make_term(BVUlt, x, y);
+  for (auto _ : state)
+  {
+    s->push();
+    s->assert_formula(f);
+    s->pop();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/** Register a benchmark for one solver configuration
+ *  Errors of the solver, e.g. an unsupported option, are reported
+ *  for that benchmark only.
+ */
+benchmark::internal::Benchmark * register_bench(
+    const string & name,
+    void (*fn)(benchmark::State &, SolverConfiguration),
+    SolverConfiguration sc)
+{
+  ostringstream ss;
+  ss << name << "/" << sc;
+  return benchmark::RegisterBenchmark(
+      ss.str().c_str(), [fn, sc](benchmark::State & state) {
+        try
+        {
+          fn(state, sc);
+        }
+        catch (SmtException & e)
+        {
+          state.SkipWithError(e.what());
+        }
+      });
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  for (auto sc : filter_non_generic_solver_configurations({ THEORY_BV }))
+  {
+    register_bench("make_term", make_term_bench, sc);
+    register_bench("make_symbol", make_symbol_bench, sc);
+    register_bench("term_iter", term_iter_bench, sc)->Range(64, 4096);
+    register_bench("transfer_term", transfer_term_bench, sc)
+        ->ArgsProduct({ { 64, 512, 4096 }, { 0, 1 } })
+        ->ArgNames({ "ops", "native" });
+    register_bench("identity_walker", identity_walker_bench, sc)
+        ->ArgsProduct({ { 64, 512, 4096 }, { HASH_CACHE, ID_CACHE } })
+        ->ArgNames({ "ops", "cache" });
+    register_bench("substitution_walker", substitution_walker_bench, sc)
+        ->Range(64, 4096);
+    register_bench("get_value", get_value_bench, sc);
+    register_bench("push_pop", push_pop_bench, sc);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
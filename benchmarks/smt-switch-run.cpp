@@ -0,0 +1,679 @@
+/*********************                                                        */
+/*! \file smt-switch-run.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Runs SMT-LIB files through the SmtLibReader with the available
+**        solvers and reports the parse time, solve time, peak memory and
+**        result of each run as CSV or JSON.
+**
+** Each run is done in a separate process, so that the peak memory is
+** that of the run alone, and a run that crashes or times out doesn't
+** affect the others. With --native, the files are also given to a
+** solver executable, to measure the overhead of smt-switch.
+**/
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "available_solvers.h"
+#include "printing_solver.h"
+#include "smt.h"
+#include "smtlib_reader.h"
+
+using namespace smt;
+using namespace smt_tests;
+using namespace std;
+
+namespace {
+
+const char * USAGE =
+    "Usage: smt-switch-run [options] <file or directory>...\n"
+    "Runs every .smt2 file (directories are searched recursively)\n"
+    "with each selected solver and wrapper.\n"
+    "\n"
+    "Options:\n"
+    "  --solver NAME       solver to run, e.g. z3, can be repeated\n"
+    "                      (default: all available)\n"
+    "  --wrappers LIST     comma-separated wrappers to run the solvers\n"
+    "                      through: none, logging, printing (default: none)\n"
+    "  --print-to FILE     where the printing wrapper writes the SMT-LIB\n"
+    "                      commands (default: /dev/null)\n"
+    "  --native CMD        also run CMD <file> for each file, e.g. \"z3\"\n"
+    "  --timeout SECONDS   wall-clock limit per run (default: none)\n"
+    "  --format csv|json   output format (default: csv)\n"
+    "  --out FILE          write the results to FILE (default: stdout)\n"
+    "  --help              print this message\n";
+
+/** The measurements of one run of a file */
+struct RunRecord
+{
+  string file;
+  string solver;
+  string wrapper;
+  string status;  ///< ok, error, timeout or crash
+  string result;  ///< result of the last check-sat
+  uint64_t num_check_sats = 0;
+  double parse_s = -1;  ///< -1 if not measured (native runs)
+  double solve_s = -1;
+  double total_s = 0;
+  long peak_rss_kb = 0;
+  string message;
+};
+
+/** SmtLibReader that times the check-sat commands instead of
+ *  printing their results
+ */
+class TimingReader : public SmtLibReader
+{
+ public:
+  TimingReader(SmtSolver & solver) : SmtLibReader(solver), num_check_sats(0)
+  {
+  }
+
+  Result check_sat() override
+  {
+    auto start = chrono::steady_clock::now();
+    last_result = solver_->check_sat();
+    solve_time += chrono::steady_clock::now() - start;
+    num_check_sats++;
+    return last_result;
+  }
+
+  Result check_sat_assuming(const TermVec & assumptions) override
+  {
+    auto start = chrono::steady_clock::now();
+    last_result = solver_->check_sat_assuming(assumptions);
+    solve_time += chrono::steady_clock::now() - start;
+    num_check_sats++;
+    return last_result;
+  }
+
+  Result last_result;
+  uint64_t num_check_sats;
+  chrono::steady_clock::duration solve_time{};
+};
+
+/** The result of a child process, see run_child */
+struct ChildOutcome
+{
+  string output;  ///< everything the child wrote to the pipe
+  int status;     ///< as returned by wait
+  bool timed_out;
+  double wall_s;
+  long peak_rss_kb;
+};
+
+/** Run body in a child process and wait for it
+ *  @param body run by the child with the write end of a pipe,
+ *         the child exits when it returns
+ *  @param timeout seconds after which the child is killed, 0 for none
+ *  @return the output and resource usage of the child
+ */
+ChildOutcome run_child(const function<void(int)> & body, double timeout)
+{
+  int fds[2];
+  if (pipe(fds))
+  {
+    throw SmtException(string("pipe failed: ") + strerror(errno));
+  }
+
+  // don't let the child repeat buffered output
+  cout.flush();
+  cerr.flush();
+
+  auto start = chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid < 0)
+  {
+    throw SmtException(string("fork failed: ") + strerror(errno));
+  }
+  if (pid == 0)
+  {
+    // own process group, so that a timeout also kills its children
+    setpgid(0, 0);
+    close(fds[0]);
+    body(fds[1]);
+    _exit(0);
+  }
+  // also set here, so that the group exists before the parent kills it,
+  // whichever of the two runs first
+  setpgid(pid, pid);
+  close(fds[1]);
+
+  ChildOutcome co;
+  co.timed_out = false;
+  auto deadline = start + chrono::duration<double>(timeout);
+  char buf[4096];
+  while (true)
+  {
+    int wait_ms = -1;
+    if (timeout > 0)
+    {
+      auto left = chrono::duration_cast<chrono::milliseconds>(
+          deadline - chrono::steady_clock::now());
+      wait_ms = max<int64_t>(left.count(), 0);
+    }
+    struct pollfd pfd = { fds[0], POLLIN, 0 };
+    int ready = poll(&pfd, 1, wait_ms);
+    if (ready < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (ready == 0)
+    {
+      co.timed_out = true;
+      if (kill(-pid, SIGKILL) < 0)
+      {
+        // there is no such group if setpgid failed, the child itself
+        // must still be killed, or wait4 below blocks
+        kill(pid, SIGKILL);
+      }
+      break;
+    }
+    ssize_t n = read(fds[0], buf, sizeof(buf));
+    if (n <= 0)
+    {
+      break;
+    }
+    co.output.append(buf, n);
+  }
+  close(fds[0]);
+
+  struct rusage ru;
+  while (wait4(pid, &co.status, 0, &ru) < 0 && errno == EINTR)
+  {
+  }
+  co.wall_s = chrono::duration<double>(chrono::steady_clock::now() - start)
+                  .count();
+  // kilobytes on Linux
+  co.peak_rss_kb = ru.ru_maxrss;
+  return co;
+}
+
+/** Set the status of a record from how the child terminated
+ *  @return true iff the child exited normally
+ */
+bool set_exit_status(const ChildOutcome & co, RunRecord & rec)
+{
+  if (co.timed_out)
+  {
+    rec.status = "timeout";
+    return false;
+  }
+  if (WIFSIGNALED(co.status))
+  {
+    rec.status = "crash";
+    rec.message = "killed by signal ";
+    rec.message += strsignal(WTERMSIG(co.status));
+    return false;
+  }
+  rec.status = "ok";
+  return true;
+}
+
+/** Replace the separators of the child's report in a message */
+string sanitize(string s)
+{
+  replace(s.begin(), s.end(), '\t', ' ');
+  replace(s.begin(), s.end(), '\n', ' ');
+  return s;
+}
+
+/** Parse and solve a file with smt-switch
+ *  @param file the SMT-LIB file
+ *  @param sc the solver configuration
+ *  @param wrapper none, logging or printing
+ *  @param print_to the file the printing wrapper writes to
+ *  @param timeout seconds per run, 0 for none
+ *  @return the record of the run
+ */
+RunRecord run_reader(const string & file,
+                     SolverConfiguration sc,
+                     const string & wrapper,
+                     const string & print_to,
+                     double timeout)
+{
+  auto body = [&](int fd) {
+    // reported as: result, #check-sats, parse seconds, solve seconds, error
+    ostringstream report;
+    try
+    {
+      SmtSolver s = create_solver(sc);
+      ofstream printed;
+      if (wrapper == "printing")
+      {
+        printed.open(print_to);
+        s = create_printing_solver(s, &printed, DEFAULT_STYLE);
+      }
+      s->set_opt("incremental", "true");
+      TimingReader reader(s);
+      auto start = chrono::steady_clock::now();
+      int res = reader.parse(file);
+      double total =
+          chrono::duration<double>(chrono::steady_clock::now() - start)
+              .count();
+      double solve = chrono::duration<double>(reader.solve_time).count();
+      report << (reader.num_check_sats ? reader.last_result.to_string() : "")
+             << "\t" << reader.num_check_sats << "\t"
+             << total - solve << "\t" << solve << "\t"
+             << (res ? "syntax error" : "");
+    }
+    catch (std::exception & e)
+    {
+      report << "\t0\t-1\t-1\t" << sanitize(e.what());
+    }
+    string r = report.str();
+    if (write(fd, r.data(), r.size()) < 0)
+    {
+      _exit(1);
+    }
+  };
+
+  RunRecord rec;
+  rec.file = file;
+  rec.solver = to_string(sc.solver_enum);
+  rec.wrapper = wrapper;
+  ChildOutcome co = run_child(body, timeout);
+  rec.total_s = co.wall_s;
+  rec.peak_rss_kb = co.peak_rss_kb;
+  if (!set_exit_status(co, rec))
+  {
+    return rec;
+  }
+
+  istringstream report(co.output);
+  string num, parse, solve;
+  getline(report, rec.result, '\t');
+  getline(report, num, '\t');
+  getline(report, parse, '\t');
+  getline(report, solve, '\t');
+  getline(report, rec.message);
+  if (num.empty())
+  {
+    rec.status = "error";
+    rec.message = "no report from the run";
+    return rec;
+  }
+  rec.num_check_sats = stoull(num);
+  rec.parse_s = stod(parse);
+  rec.solve_s = stod(solve);
+  if (!rec.message.empty())
+  {
+    rec.status = "error";
+  }
+  return rec;
+}
+
+/** Quote a string for /bin/sh */
+string shell_quote(const string & s)
+{
+  string res = "'";
+  for (char c : s)
+  {
+    if (c == '\'')
+    {
+      res += "'\\''";
+    }
+    else
+    {
+      res += c;
+    }
+  }
+  return res + "'";
+}
+
+/** Run a solver executable on a file
+ *  The result is the last sat, unsat or unknown line of its output.
+ *  @param file the SMT-LIB file
+ *  @param cmd the command to run, the file is appended as argument
+ *  @param timeout seconds per run, 0 for none
+ *  @return the record of the run
+ */
+RunRecord run_native(const string & file, const string & cmd, double timeout)
+{
+  string full_cmd = cmd + " " + shell_quote(file);
+  auto body = [&full_cmd](int fd) {
+    dup2(fd, STDOUT_FILENO);
+    execl("/bin/sh", "sh", "-c", full_cmd.c_str(), (char *)nullptr);
+    _exit(127);
+  };
+
+  RunRecord rec;
+  rec.file = file;
+  rec.solver = cmd;
+  rec.wrapper = "native";
+  ChildOutcome co = run_child(body, timeout);
+  rec.total_s = co.wall_s;
+  rec.peak_rss_kb = co.peak_rss_kb;
+  if (!set_exit_status(co, rec))
+  {
+    return rec;
+  }
+
+  istringstream out(co.output);
+  string line;
+  while (getline(out, line))
+  {
+    if (line == "sat" || line == "unsat" || line == "unknown")
+    {
+      rec.result = line;
+      rec.num_check_sats++;
+    }
+    else if (line.rfind("(error", 0) == 0)
+    {
+      rec.status = "error";
+      rec.message = line;
+    }
+  }
+  if (WEXITSTATUS(co.status) && rec.message.empty())
+  {
+    rec.status = "error";
+    rec.message = "exit code " + std::to_string(WEXITSTATUS(co.status));
+  }
+  return rec;
+}
+
+/** @return the .smt2 files in paths, directories are searched recursively */
+vector<string> collect_files(const vector<string> & paths)
+{
+  namespace fs = std::filesystem;
+  vector<string> files;
+  for (const auto & p : paths)
+  {
+    if (fs::is_directory(p))
+    {
+      vector<string> dir_files;
+      for (const auto & entry : fs::recursive_directory_iterator(p))
+      {
+        if (entry.is_regular_file() && entry.path().extension() == ".smt2")
+        {
+          dir_files.push_back(entry.path().string());
+        }
+      }
+      sort(dir_files.begin(), dir_files.end());
+      files.insert(files.end(), dir_files.begin(), dir_files.end());
+    }
+    else if (fs::exists(p))
+    {
+      files.push_back(p);
+    }
+    else
+    {
+      throw IncorrectUsageException("No such file or directory: " + p);
+    }
+  }
+  return files;
+}
+
+/** @return the available solver with this name (case-insensitive) */
+SolverEnum lookup_solver(string name)
+{
+  transform(name.begin(), name.end(), name.begin(), ::toupper);
+  for (auto se : available_solver_enums())
+  {
+    if (to_string(se) == name)
+    {
+      return se;
+    }
+  }
+  throw IncorrectUsageException("Solver not available: " + name);
+}
+
+string csv_field(const string & s)
+{
+  if (s.find_first_of(",\"\n") == string::npos)
+  {
+    return s;
+  }
+  string res = "\"";
+  for (char c : s)
+  {
+    res += c;
+    if (c == '"')
+    {
+      res += '"';
+    }
+  }
+  return res + "\"";
+}
+
+string json_string(const string & s)
+{
+  ostringstream res;
+  res << '"';
+  for (unsigned char c : s)
+  {
+    if (c == '"' || c == '\\')
+    {
+      res << '\\' << c;
+    }
+    else if (c < 0x20)
+    {
+      res << "\\u" << hex << setw(4) << setfill('0') << (int)c << dec;
+    }
+    else
+    {
+      res << c;
+    }
+  }
+  res << '"';
+  return res.str();
+}
+
+void write_csv(ostream & out, const vector<RunRecord> & records)
+{
+  out << "file,solver,wrapper,status,result,check_sats,parse_s,solve_s,"
+         "total_s,peak_rss_kb,message"
+      << endl;
+  for (const auto & r : records)
+  {
+    out << csv_field(r.file) << "," << csv_field(r.solver) << ","
+        << r.wrapper << "," << r.status << "," << r.result << ","
+        << r.num_check_sats << ",";
+    if (r.parse_s >= 0)
+    {
+      out << r.parse_s << "," << r.solve_s;
+    }
+    else
+    {
+      out << ",";
+    }
+    out << "," << r.total_s << "," << r.peak_rss_kb << ","
+        << csv_field(r.message) << endl;
+  }
+}
+
+void write_json(ostream & out, const vector<RunRecord> & records)
+{
+  out << "[";
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    const RunRecord & r = records[i];
+    out << (i ? ",\n " : "\n ") << "{\"file\": " << json_string(r.file)
+        << ", \"solver\": " << json_string(r.solver)
+        << ", \"wrapper\": " << json_string(r.wrapper)
+        << ", \"status\": " << json_string(r.status)
+        << ", \"result\": " << json_string(r.result)
+        << ", \"check_sats\": " << r.num_check_sats << ", \"parse_s\": ";
+    if (r.parse_s >= 0)
+    {
+      out << r.parse_s << ", \"solve_s\": " << r.solve_s;
+    }
+    else
+    {
+      out << "null, \"solve_s\": null";
+    }
+    out << ", \"total_s\": " << r.total_s
+        << ", \"peak_rss_kb\": " << r.peak_rss_kb
+        << ", \"message\": " << json_string(r.message) << "}";
+  }
+  out << "\n]" << endl;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  vector<SolverEnum> solvers;
+  vector<string> wrappers;
+  vector<string> paths;
+  string print_to = "/dev/null";
+  string native_cmd;
+  string format = "csv";
+  string out_file;
+  double timeout = 0;
+
+  try
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      string arg = argv[i];
+      auto next = [&]() -> string {
+        if (i + 1 >= argc)
+        {
+          throw IncorrectUsageException("Missing value for " + arg);
+        }
+        return argv[++i];
+      };
+
+      if (arg == "--help" || arg == "-h")
+      {
+        cout << USAGE;
+        return 0;
+      }
+      else if (arg == "--solver")
+      {
+        solvers.push_back(lookup_solver(next()));
+      }
+      else if (arg == "--wrappers")
+      {
+        istringstream list(next());
+        string w;
+        while (getline(list, w, ','))
+        {
+          if (w != "none" && w != "logging" && w != "printing")
+          {
+            throw IncorrectUsageException("Unknown wrapper: " + w);
+          }
+          wrappers.push_back(w);
+        }
+      }
+      else if (arg == "--print-to")
+      {
+        print_to = next();
+      }
+      else if (arg == "--native")
+      {
+        native_cmd = next();
+      }
+      else if (arg == "--timeout")
+      {
+        timeout = stod(next());
+      }
+      else if (arg == "--format")
+      {
+        format = next();
+        if (format != "csv" && format != "json")
+        {
+          throw IncorrectUsageException("Unknown format: " + format);
+        }
+      }
+      else if (arg == "--out")
+      {
+        out_file = next();
+      }
+      else if (arg.rfind("--", 0) == 0)
+      {
+        throw IncorrectUsageException("Unknown option: " + arg);
+      }
+      else
+      {
+        paths.push_back(arg);
+      }
+    }
+
+    if (paths.empty())
+    {
+      throw IncorrectUsageException("No input files");
+    }
+    if (solvers.empty())
+    {
+      solvers = available_solver_enums();
+    }
+    if (wrappers.empty())
+    {
+      wrappers.push_back("none");
+    }
+
+    vector<RunRecord> records;
+    for (const auto & file : collect_files(paths))
+    {
+      for (auto se : solvers)
+      {
+        for (const auto & w : wrappers)
+        {
+          SolverConfiguration sc(se, w == "logging");
+          records.push_back(run_reader(file, sc, w, print_to, timeout));
+        }
+      }
+      if (!native_cmd.empty())
+      {
+        records.push_back(run_native(file, native_cmd, timeout));
+      }
+    }
+
+    ofstream of;
+    if (!out_file.empty())
+    {
+      of.open(out_file);
+      if (!of)
+      {
+        throw IncorrectUsageException("Could not open " + out_file);
+      }
+    }
+    ostream & out = out_file.empty() ? cout : of;
+    if (format == "json")
+    {
+      write_json(out, records);
+    }
+    else
+    {
+      write_csv(out, records);
+    }
+  }
+  catch (IncorrectUsageException & e)
+  {
+    cerr << "smt-switch-run: " << e.what() << endl << endl << USAGE;
+    return 1;
+  }
+  catch (std::exception & e)
+  {
+    cerr << "smt-switch-run: " << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -16,9 +16,7 @@
 
 #pragma once
 
-#include <signal.h>
-#include <unistd.h>
-
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -26,6 +24,7 @@
 
 #include "bitwuzla_sort.h"
 #include "bitwuzla_term.h"
+#include "deadline_timer.h"
 #include "exceptions.h"
 #include "result.h"
 #include "smt.h"
@@ -44,7 +43,10 @@ class BzlaSolver : public AbsSmtSolver
         bzla(bitwuzla_new()),
         context_level(0),
         time_limit(0),
-        terminate_bzla(false)
+        timelimit_id(0),
+        terminate_bzla(false),
+        num_interrupts(0),
+        check_interrupts(0)
   {
     // set termination function -- throw an exception
     auto throw_exception = [](const char * msg) -> void {
@@ -53,22 +55,24 @@ class BzlaSolver : public AbsSmtSolver
     bitwuzla_set_abort_callback(throw_exception);
 
     // this termination callback is used to support a time limit option
-    // used in conjunction with C alarm function. See timelimit_start()
-    // and timelimit_end() helper functions
+    // used in conjunction with the shared DeadlineTimer (see
+    // timelimit_start() and timelimit_end() helper functions) and
+    // interrupt()
     auto terminate = [](void * state) -> int32_t {
-      bool terminate_bzla = *reinterpret_cast<bool *>(state);
-      if (terminate_bzla)
+      BzlaSolver * solver = reinterpret_cast<BzlaSolver *>(state);
+      if (solver->terminate_bzla || solver->interrupted())
       {
         return 1;
       }
       return 0;
     };
-    bitwuzla_set_termination_callback(bzla, terminate, &terminate_bzla);
+    bitwuzla_set_termination_callback(bzla, terminate, this);
   };
   BzlaSolver(const BzlaSolver &) = delete;
   BzlaSolver & operator=(const BzlaSolver &) = delete;
   ~BzlaSolver()
   {
+    DeadlineTimer::get().cancel(timelimit_id);
     // need to destruct all stored terms in symbol_table
     symbol_table.clear();
     bitwuzla_delete(bzla);
@@ -78,6 +82,7 @@ class BzlaSolver : public AbsSmtSolver
   void assert_formula(const Term & t) override;
   Result check_sat() override;
   Result check_sat_assuming(const TermVec & assumptions) override;
+  void interrupt() override;
   Result check_sat_assuming_list(const TermList & assumptions) override;
   Result check_sat_assuming_set(const UnorderedTermSet & assumptions) override;
   void push(uint64_t num = 1) override;
@@ -124,6 +129,7 @@ class BzlaSolver : public AbsSmtSolver
                  const Sort & sort,
                  uint64_t base = 10) const override;
   Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
   Term make_symbol(const std::string name, const Sort & sort) override;
   Term get_symbol(const std::string & name) override;
   Term make_param(const std::string name, const Sort & sort) override;
@@ -135,6 +141,11 @@ class BzlaSolver : public AbsSmtSolver
                  const Term & t1,
                  const Term & t2) const override;
   Term make_term(Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
   void reset() override;
   void reset_assertions() override;
   Term substitute(const Term term,
@@ -157,12 +168,26 @@ class BzlaSolver : public AbsSmtSolver
   uint64_t context_level;
 
   uint64_t time_limit;
-  bool terminate_bzla;  ///< used if time limit is reached
+  DeadlineTimer::Id timelimit_id;    ///< deadline of the running query
+  std::atomic<bool> terminate_bzla;  ///< used if time limit is reached
+  std::atomic<uint64_t> num_interrupts;    ///< calls to interrupt()
+  std::atomic<uint64_t> check_interrupts;  ///< num_interrupts at check entry
+
+  /** true iff interrupt() was called after the current check was entered,
+   *  including while its assumptions were added. Earlier calls don't count.
+   */
+  bool interrupted() const { return num_interrupts != check_interrupts; }
 
   // helper functions
+
+  /** builds a Bitwuzla term for op applied to bitwuzla_terms */
+  const BitwuzlaTerm * make_bzla_term(
+      Op op, const std::vector<const BitwuzlaTerm *> & bitwuzla_terms) const;
+
   template <class I>
   inline Result check_sat_assuming_internal(I it, const I & end)
   {
+    check_interrupts = num_interrupts.load();
     std::shared_ptr<BzlaTerm> bt;
     while (it != end)
     {
@@ -186,6 +211,10 @@ class BzlaSolver : public AbsSmtSolver
     {
       return Result(UNKNOWN, "Time limit reached.");
     }
+    else if (interrupted())
+    {
+      return Result(UNKNOWN, "Interrupted.");
+    }
     else
     {
       return Result(UNKNOWN);
@@ -193,8 +222,8 @@ class BzlaSolver : public AbsSmtSolver
   }
 
   /** Helper function for managing time limits (if one is set)
-   *  Registers a signal handler to use with alarm
-   *  and a termination callback function.
+   *  Schedules a deadline that makes the termination callback
+   *  stop the query.
    */
   void timelimit_start();
 
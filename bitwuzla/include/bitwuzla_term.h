@@ -76,6 +76,9 @@ class BzlaTerm : public AbsTerm
    */
   TermIter begin() override;
   TermIter end() override;
+  std::size_t num_children() override;
+  Term get_child(std::size_t i) override;
+  void get_children(TermVec & out) override;
   std::string print_value_as(SortKind sk) override;
 
   // getters for solver-specific objects
@@ -21,17 +21,6 @@
 using namespace std;
 
 namespace smt {
-Bitwuzla * running_bzla = nullptr;  ///< used for calling terminate
-                                    ///< if a time limit is reached
-
-void bzla_timelimit_handler(int signum)
-{
-  assert(running_bzla != nullptr);
-  void * state = bitwuzla_get_termination_callback_state(running_bzla);
-  bool * statebool = reinterpret_cast<bool *>(state);
-  *statebool = true;
-  bitwuzla_terminate(running_bzla);
-}
 
 const std::unordered_map<PrimOp, BitwuzlaKind> op2bkind(
     { /* Core Theory */
@@ -112,6 +101,10 @@ void BzlaSolver::set_opt(const string option, const string value)
   {
     time_limit = stoi(value);
   }
+  else if (option == "random-seed")
+  {
+    bitwuzla_set_option(bzla, BITWUZLA_OPT_SEED, stoul(value));
+  }
   else
   {
     throw SmtException("Bitwuzla backend does not support option: " + option);
@@ -132,6 +125,7 @@ void BzlaSolver::assert_formula(const Term & t)
 
 Result BzlaSolver::check_sat()
 {
+  check_interrupts = num_interrupts.load();
   timelimit_start();
   BitwuzlaResult r = bitwuzla_check_sat(bzla);
   bool tl_triggered = timelimit_end();
@@ -150,6 +144,10 @@ Result BzlaSolver::check_sat()
     {
       return Result(UNKNOWN, "Time limit reached.");
     }
+    else if (interrupted())
+    {
+      return Result(UNKNOWN, "Interrupted.");
+    }
     return Result(UNKNOWN);
   }
 }
@@ -159,6 +157,8 @@ Result BzlaSolver::check_sat_assuming(const TermVec & assumptions)
   return check_sat_assuming_internal(assumptions.begin(), assumptions.end());
 }
 
+void BzlaSolver::interrupt() { num_interrupts++; }
+
 Result BzlaSolver::check_sat_assuming_list(const TermList & assumptions)
 {
   return check_sat_assuming_internal(assumptions.begin(), assumptions.end());
@@ -456,6 +456,30 @@ Term BzlaSolver::make_term(const std::string val,
       bitwuzla_mk_bv_value(bzla, bsort->sort, val.c_str(), baseit->second));
 }
 
+Term BzlaSolver::import_value(const TermValue & val, const Sort & sort) const
+{
+  TermValue v = cast_value_for_import(val, sort);
+  if (v.kind == BOOL)
+  {
+    return make_term(v.get_bool());
+  }
+  else if (v.kind != BV)
+  {
+    throw NotImplementedException(
+        "Bitwuzla does not support creating values for sort kind"
+        + to_string(v.kind));
+  }
+
+  shared_ptr<BzlaSort> bsort = static_pointer_cast<BzlaSort>(sort);
+  if (v.width <= 64)
+  {
+    return make_shared<BzlaTerm>(
+        bitwuzla_mk_bv_value_uint64(bzla, bsort->sort, v.get_uint64()));
+  }
+  return make_shared<BzlaTerm>(bitwuzla_mk_bv_value(
+      bzla, bsort->sort, v.num_to_string(2).c_str(), BITWUZLA_BV_BASE_BIN));
+}
+
 Term BzlaSolver::make_term(const Term & val, const Sort & sort) const
 {
   SortKind sk = sort->get_sort_kind();
@@ -624,7 +648,42 @@ Term BzlaSolver::make_term(Op op, const TermVec & terms) const
   {
     bitwuzla_terms.push_back(static_pointer_cast<BzlaTerm>(t)->term);
   }
+  return make_shared<BzlaTerm>(make_bzla_term(op, bitwuzla_terms));
+}
+
+void BzlaSolver::make_terms(const TermVec & leaves,
+                            const vector<Op> & ops,
+                            const vector<size_t> & child_offsets,
+                            const vector<size_t> & children,
+                            TermVec & out) const
+{
+  check_make_terms_args(leaves.size(), ops, child_offsets, children);
+
+  // work on Bitwuzla terms directly and only wrap the results
+  vector<const BitwuzlaTerm *> nodes;
+  nodes.reserve(leaves.size() + ops.size());
+  for (const auto & l : leaves)
+  {
+    nodes.push_back(static_pointer_cast<BzlaTerm>(l)->term);
+  }
 
+  out.reserve(out.size() + ops.size());
+  vector<const BitwuzlaTerm *> bitwuzla_terms;
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    bitwuzla_terms.clear();
+    for (size_t j = child_offsets[i]; j < child_offsets[i + 1]; ++j)
+    {
+      bitwuzla_terms.push_back(nodes[children[j]]);
+    }
+    nodes.push_back(make_bzla_term(ops[i], bitwuzla_terms));
+    out.push_back(make_shared<BzlaTerm>(nodes.back()));
+  }
+}
+
+const BitwuzlaTerm * BzlaSolver::make_bzla_term(
+    Op op, const vector<const BitwuzlaTerm *> & bitwuzla_terms) const
+{
   auto it = op2bkind.find(op.prim_op);
   if (it == op2bkind.end())
   {
@@ -635,8 +694,8 @@ Term BzlaSolver::make_term(Op op, const TermVec & terms) const
 
   if (!op.num_idx)
   {
-    return make_shared<BzlaTerm>(bitwuzla_mk_term(
-        bzla, bkind, bitwuzla_terms.size(), bitwuzla_terms.data()));
+    return bitwuzla_mk_term(
+        bzla, bkind, bitwuzla_terms.size(), bitwuzla_terms.data());
   }
   else
   {
@@ -646,12 +705,12 @@ Term BzlaSolver::make_term(Op op, const TermVec & terms) const
     {
       indices.push_back(op.idx1);
     }
-    return make_shared<BzlaTerm>(bitwuzla_mk_term_indexed(bzla,
-                                                          bkind,
-                                                          bitwuzla_terms.size(),
-                                                          bitwuzla_terms.data(),
-                                                          indices.size(),
-                                                          indices.data()));
+    return bitwuzla_mk_term_indexed(bzla,
+                                    bkind,
+                                    bitwuzla_terms.size(),
+                                    bitwuzla_terms.data(),
+                                    indices.size(),
+                                    indices.data());
   }
 }
 
@@ -743,11 +802,11 @@ void BzlaSolver::timelimit_start()
 {
   if (time_limit)
   {
-    signal(SIGALRM, bzla_timelimit_handler);
-    assert(running_bzla == nullptr);
-    assert(!terminate_bzla);
-    running_bzla = bzla;
-    alarm(time_limit);
+    // a previous query might have thrown before timelimit_end
+    DeadlineTimer::get().cancel(timelimit_id);
+    terminate_bzla = false;
+    timelimit_id = DeadlineTimer::get().schedule(
+        std::chrono::seconds(time_limit), [this]() { terminate_bzla = true; });
   }
 }
 
@@ -756,10 +815,11 @@ bool BzlaSolver::timelimit_end()
   bool res = false;
   if (time_limit)
   {
+    // waits for the deadline callback if it is running
+    DeadlineTimer::get().cancel(timelimit_id);
+    timelimit_id = 0;
     res |= terminate_bzla;
     terminate_bzla = false;
-    running_bzla = nullptr;
-    alarm(0);
   }
   return res;
 }
@@ -271,6 +271,35 @@ TermIter BzlaTerm::end()
       vector<const BitwuzlaTerm *>(children, children + size), size));
 }
 
+size_t BzlaTerm::num_children()
+{
+  size_t size;
+  bitwuzla_term_get_children(term, &size);
+  return size;
+}
+
+Term BzlaTerm::get_child(size_t i)
+{
+  size_t size;
+  const BitwuzlaTerm ** children = bitwuzla_term_get_children(term, &size);
+  if (i >= size)
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return make_shared<BzlaTerm>(children[i]);
+}
+
+void BzlaTerm::get_children(TermVec & out)
+{
+  size_t size;
+  const BitwuzlaTerm ** children = bitwuzla_term_get_children(term, &size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    out.push_back(make_shared<BzlaTerm>(children[i]));
+  }
+}
+
 string BzlaTerm::print_value_as(SortKind sk)
 {
   if (!is_value())
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -25,6 +26,7 @@
 #include "boolector_sort.h"
 #include "boolector_term.h"
 
+#include "deadline_timer.h"
 #include "exceptions.h"
 #include "result.h"
 #include "smt.h"
@@ -45,11 +47,15 @@ class BoolectorSolver : public AbsSmtSolver
       throw InternalSolverException(msg);
     };
     boolector_set_abort(throw_exception);
+
+    // termination callback used to support interrupt() and time limits
+    boolector_set_term(btor, terminate_callback, this);
   };
   BoolectorSolver(const BoolectorSolver &) = delete;
   BoolectorSolver & operator=(const BoolectorSolver &) = delete;
   ~BoolectorSolver()
   {
+    DeadlineTimer::get().cancel(timelimit_id);
     // need to destruct all stored terms in the symbol_table
     symbol_table.clear();
     boolector_delete(btor);
@@ -61,6 +67,7 @@ class BoolectorSolver : public AbsSmtSolver
   Result check_sat_assuming(const TermVec & assumptions) override;
   Result check_sat_assuming_list(const TermList & assumptions) override;
   Result check_sat_assuming_set(const UnorderedTermSet & assumptions) override;
+  void interrupt() override;
   void push(uint64_t num = 1) override;
   void pop(uint64_t num = 1) override;
   uint64_t get_context_level() const override;
@@ -139,10 +146,40 @@ class BoolectorSolver : public AbsSmtSolver
   ///< set this flag with set_opt("base-context-1", "true")
   size_t context_level = 0;  ///< tracks the current solving context level
 
+  // interrupt() counts its calls, and a check records the count when it
+  // is entered. The check is stopped once the count changes, so an
+  // interrupt that comes in while the check is set up is not lost, and
+  // one sent while no check is running does not stop the next check.
+  std::atomic<uint64_t> num_interrupts{ 0 };
+  std::atomic<uint64_t> check_interrupts{ 0 };  ///< count at check entry
+
+  /** true iff interrupt() was called since the current check was entered */
+  bool interrupted() const { return num_interrupts != check_interrupts; }
+
+  uint64_t time_limit = 0;               ///< in seconds, 0 for no limit
+  DeadlineTimer::Id timelimit_id = 0;    ///< deadline of the running query
+  std::atomic<bool> timed_out{ false };  ///< set if time limit is reached
+
+  /** Boolector termination callback, state points to the solver */
+  static int32_t terminate_callback(void * state);
+
+  /** Helper function for managing time limits (if one is set)
+   *  Schedules a deadline that makes the termination callback
+   *  stop the query.
+   */
+  void timelimit_start();
+
+  /** Helper function for managing time limits (if one is set)
+   *  Returns true iff the query was terminated due to the
+   *  time limit.
+   */
+  bool timelimit_end();
+
   // helper functions
   template <class I>
   inline Result check_sat_assuming(I it, const I & end)
   {
+    check_interrupts = num_interrupts.load();
     std::shared_ptr<BoolectorTerm> bt;
     while (it != end)
     {
@@ -152,7 +189,9 @@ class BoolectorSolver : public AbsSmtSolver
       ++it;
     }
 
+    timelimit_start();
     int32_t res = boolector_sat(btor);
+    bool tl_triggered = timelimit_end();
     if (res == BOOLECTOR_SAT)
     {
       return Result(SAT);
@@ -161,6 +200,14 @@ class BoolectorSolver : public AbsSmtSolver
     {
       return Result(UNSAT);
     }
+    else if (tl_triggered)
+    {
+      return Result(UNKNOWN, "Time limit reached.");
+    }
+    else if (interrupted())
+    {
+      return Result(UNKNOWN, "Interrupted.");
+    }
     else
     {
       return Result(UNKNOWN);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "boolector.h"
@@ -42,7 +43,12 @@ class BoolectorTermIter : public TermIterBase
 {
  public:
   // IMPORTANT: The correctness of this code depends on the array e being of size 3
-  BoolectorTermIter(Btor * btor, std::vector<BtorNode *> c, int64_t idx)
+  // c is shared with the BoolectorTerm being iterated over
+  // (avoids copying the vector for every iterator, and stays valid
+  //  if the term is destroyed or recollects its children)
+  BoolectorTermIter(Btor * btor,
+                    std::shared_ptr<const std::vector<BtorNode *>> c,
+                    int64_t idx)
       : btor(btor), children(c), idx(idx)
   {
   }
@@ -65,7 +71,7 @@ class BoolectorTermIter : public TermIterBase
 
  private:
   Btor * btor;
-  std::vector<BtorNode *> children;
+  std::shared_ptr<const std::vector<BtorNode *>> children;
   int64_t idx;
 };
 
@@ -89,7 +95,11 @@ class BoolectorTerm : public AbsTerm
    */
   TermIter begin() override;
   TermIter end() override;
+  std::size_t num_children() override;
+  Term get_child(std::size_t i) override;
+  void get_children(TermVec & out) override;
   std::string print_value_as(SortKind sk) override;
+  bool export_value(TermValue & out) override;
 
   // getters for solver-specific objects
   // for interacting with third-party Boolector-specific software
@@ -110,7 +120,8 @@ class BoolectorTerm : public AbsTerm
   // for iterating args nodes
   BtorArgsIterator ait;
   // for storing nodes before iterating
-  std::vector<BtorNode *> children;
+  // (replaced, not modified, when recollected -- iterators share it)
+  std::shared_ptr<const std::vector<BtorNode *>> children;
   // flag that's set to true if children have already been gathered
   // not straightforward to just rely on number of children / arity
   // because boolector term representation isn't a perfect match
@@ -113,6 +113,14 @@ void BoolectorSolver::set_opt(const std::string option, const std::string value)
       boolector_set_opt(btor, BTOR_OPT_INCREMENTAL, 1);
     }
   }
+  else if (option == "random-seed")
+  {
+    boolector_set_opt(btor, BTOR_OPT_SEED, std::stoul(value));
+  }
+  else if (option == "time-limit")
+  {
+    time_limit = std::stoul(value);
+  }
   else if (option == "base-context-1" && value == "true")
   {
     base_context_1 = true;
@@ -297,7 +305,10 @@ void BoolectorSolver::assert_formula(const Term & t)
 
 Result BoolectorSolver::check_sat()
 {
+  check_interrupts = num_interrupts.load();
+  timelimit_start();
   int32_t res = boolector_sat(btor);
+  bool tl_triggered = timelimit_end();
   if (res == BOOLECTOR_SAT)
   {
     return Result(SAT);
@@ -306,6 +317,14 @@ Result BoolectorSolver::check_sat()
   {
     return Result(UNSAT);
   }
+  else if (tl_triggered)
+  {
+    return Result(UNKNOWN, "Time limit reached.");
+  }
+  else if (interrupted())
+  {
+    return Result(UNKNOWN, "Interrupted.");
+  }
   else
   {
     return Result(UNKNOWN);
@@ -328,6 +347,14 @@ Result BoolectorSolver::check_sat_assuming_set(
   return check_sat_assuming(assumptions.begin(), assumptions.end());
 }
 
+void BoolectorSolver::interrupt() { num_interrupts++; }
+
+int32_t BoolectorSolver::terminate_callback(void * state)
+{
+  BoolectorSolver * solver = reinterpret_cast<BoolectorSolver *>(state);
+  return (solver->interrupted() || solver->timed_out) ? 1 : 0;
+}
+
 void BoolectorSolver::push(uint64_t num)
 {
   boolector_push(btor, num);
@@ -781,6 +808,7 @@ void BoolectorSolver::reset()
   boolector_release_all(btor);
   boolector_delete(btor);
   btor = boolector_new();
+  boolector_set_term(btor, terminate_callback, this);
 }
 
 void BoolectorSolver::reset_assertions()
@@ -1071,6 +1099,33 @@ Term BoolectorSolver::apply_prim_op(PrimOp op, TermVec terms) const
   }
 }
 
+// helpers
+void BoolectorSolver::timelimit_start()
+{
+  if (time_limit)
+  {
+    // a previous query might have thrown before timelimit_end
+    DeadlineTimer::get().cancel(timelimit_id);
+    timed_out = false;
+    timelimit_id = DeadlineTimer::get().schedule(
+        std::chrono::seconds(time_limit), [this]() { timed_out = true; });
+  }
+}
+
+bool BoolectorSolver::timelimit_end()
+{
+  bool res = false;
+  if (time_limit)
+  {
+    // waits for the deadline callback if it is running
+    DeadlineTimer::get().cancel(timelimit_id);
+    timelimit_id = 0;
+    res |= timed_out;
+    timed_out = false;
+  }
+  return res;
+}
+
 /* end BoolectorSolver implementation */
 
 }  // namespace smt
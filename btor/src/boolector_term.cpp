@@ -130,10 +130,11 @@ BoolectorTermIter & BoolectorTermIter::operator=(const BoolectorTermIter & it)
 
 void BoolectorTermIter::operator++() { idx++; };
 
-const Term BoolectorTermIter::operator*()
+/** Wrap a child node as a Term
+ *  shared by BoolectorTermIter and BoolectorTerm::get_child
+ */
+static Term make_child_term(Btor * btor, BtorNode * res)
 {
-  assert(idx < children.size());
-  BtorNode * res = children[idx];
   if (btor_node_real_addr(res)->kind == BTOR_ARGS_NODE)
   {
     throw SmtException("Should never have an args node in children look up");
@@ -146,6 +147,12 @@ const Term BoolectorTermIter::operator*()
 
   BoolectorNode * node = BTOR_EXPORT_BOOLECTOR_NODE(res);
   return std::make_shared<BoolectorTerm> (btor, node);
+}
+
+const Term BoolectorTermIter::operator*()
+{
+  assert(idx < children->size());
+  return make_child_term(btor, (*children)[idx]);
 };
 
 TermIterBase * BoolectorTermIter::clone() const
@@ -166,7 +173,8 @@ bool BoolectorTermIter::operator!=(const BoolectorTermIter & it)
 bool BoolectorTermIter::equal(const TermIterBase & other) const
 {
   const BoolectorTermIter & bti = static_cast<const BoolectorTermIter &>(other);
-  return ((btor == bti.btor) && (idx == bti.idx) && (children == bti.children));
+  return ((btor == bti.btor) && (idx == bti.idx)
+          && (children == bti.children || *children == *bti.children));
 }
 
 /* end BoolectorTermIter implementation */
@@ -404,7 +412,33 @@ TermIter BoolectorTerm::begin()
 TermIter BoolectorTerm::end()
 {
   collect_children();
-  return TermIter(new BoolectorTermIter(btor, children, children.size()));
+  return TermIter(new BoolectorTermIter(btor, children, children->size()));
+}
+
+size_t BoolectorTerm::num_children()
+{
+  collect_children();
+  return children->size();
+}
+
+Term BoolectorTerm::get_child(size_t i)
+{
+  collect_children();
+  if (i >= children->size())
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return make_child_term(btor, (*children)[i]);
+}
+
+void BoolectorTerm::get_children(TermVec & out)
+{
+  collect_children();
+  for (BtorNode * c : *children)
+  {
+    out.push_back(make_child_term(btor, c));
+  }
 }
 
 std::string BoolectorTerm::print_value_as(SortKind sk)
@@ -444,6 +478,30 @@ std::string BoolectorTerm::print_value_as(SortKind sk)
   }
 }
 
+bool BoolectorTerm::export_value(TermValue & out)
+{
+  if (!is_value()
+      || !boolector_is_bitvec_sort(btor, boolector_get_sort(btor, node)))
+  {
+    return false;
+  }
+
+  // boolector stores constants as bit strings, most significant bit first
+  const char * bits = boolector_get_bits(btor, node);
+  uint64_t width = boolector_get_width(btor, node);
+  std::vector<uint64_t> words((width + 63) / 64, 0);
+  for (uint64_t i = 0; i < width; ++i)
+  {
+    if (bits[width - 1 - i] == '1')
+    {
+      words[i / 64] |= 1ULL << (i % 64);
+    }
+  }
+  boolector_free_bits(btor, bits);
+  out = TermValue::make_bv(width, words);
+  return true;
+}
+
 // helpers
 
 bool BoolectorTerm::is_const_array() const
@@ -470,12 +528,11 @@ void BoolectorTerm::collect_children()
   if (negated)
   {
     // the negated value is the real address stored in bn
-    children.clear();
-    children.push_back(bn);
+    children = std::make_shared<const std::vector<BtorNode *>>(1, bn);
     return;
   }
 
-  children.clear();
+  auto collected = std::make_shared<std::vector<BtorNode *>>();
   BtorNode * tmp;
   // don't expose the parameter node of the lambda -- start at 1 instead of 0
   size_t start_idx = is_const_array() ? 1 : 0;
@@ -490,15 +547,16 @@ void BoolectorTerm::collect_children()
       btor_iter_args_init(&ait, tmp);
       while (btor_iter_args_has_next(&ait))
       {
-        children.push_back(btor_iter_args_next(&ait));
+        collected->push_back(btor_iter_args_next(&ait));
       }
     }
     else
     {
-      children.push_back(tmp);
+      collected->push_back(tmp);
     }
   }
 
+  children = collected;
   children_cached_ = true;
 }
 
@@ -29,6 +29,7 @@ Configures the CMAKE build environment.
 --static                create static libaries (default: off)
 --without-tests         build without the smt-switch test suite (default: off)
 --python                compile with python bindings (default: off)
+--benchmarks            build the micro-benchmarks - requires google-benchmark (default: off)
 --smtlib-reader         include the smt-lib reader - requires bison/flex (default:off)
 --bison-dir=STR         custom bison installation directory
 --flex-dir=STR          custom flex installation directory
@@ -61,6 +62,7 @@ z3_home=default
 static=default
 build_tests=default
 python=default
+benchmarks=default
 smtlib_reader=default
 bison_dir=default
 flex_dir=default
@@ -183,6 +185,9 @@ do
         --python)
             python=yes
             ;;
+        --benchmarks)
+            benchmarks=yes
+            ;;
         --smtlib-reader)
             smtlib_reader=yes
             ;;
@@ -285,6 +290,9 @@ cmake_opts="$cmake_opts -DCMAKE_BUILD_TYPE=$build_type"
 [ $python != default ] \
     && cmake_opts="$cmake_opts -DBUILD_PYTHON_BINDINGS=ON"
 
+[ $benchmarks != default ] \
+    && cmake_opts="$cmake_opts -DBUILD_BENCHMARKS=ON"
+
 [ $smtlib_reader != default ] \
     && cmake_opts="$cmake_opts -DSMTLIB_READER=ON"
 
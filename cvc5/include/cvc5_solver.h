@@ -62,6 +62,7 @@ class Cvc5Solver : public AbsSmtSolver
   void pop(uint64_t num = 1) override;
   uint64_t get_context_level() const override;
   Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
   UnorderedTermMap get_array_values(const Term & arr,
                                     Term & out_const_base) const override;
   void get_unsat_assumptions(UnorderedTermSet & out) override;
@@ -106,6 +107,7 @@ class Cvc5Solver : public AbsSmtSolver
                  const Sort & sort,
                  uint64_t base = 10) const override;
   Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
   Term make_symbol(const std::string name, const Sort & sort) override;
   Term get_symbol(const std::string & name) override;
   Term make_param(const std::string name, const Sort & sort) override;
@@ -117,6 +119,11 @@ class Cvc5Solver : public AbsSmtSolver
                  const Term & t1,
                  const Term & t2) const override;
   Term make_term(Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
   void reset() override;
   void reset_assertions() override;
   Term substitute(const Term term,
@@ -125,12 +132,19 @@ class Cvc5Solver : public AbsSmtSolver
 
   // helpers
   ::cvc5::Op make_cvc5_op(Op op) const;
+  /** builds a cvc5 term for op applied to cterms
+   *  (may modify cterms)
+   */
+  ::cvc5::Term make_cvc5_term(Op op, std::vector<::cvc5::Term> & cterms) const;
 
   // getters for solver-specific objects
   // for interacting with third-party cvc5-specific software
   ::cvc5::Solver & get_cvc5_solver() { return solver; };
   
  protected:
+  // every instance owns its cvc5 solver, and cvc5 terms can't be used
+  // with another solver. So translate_native is not overridden, and
+  // terms are translated between Cvc5Solvers by rebuilding them.
   ::cvc5::Solver solver;
 
   std::unordered_map<std::string, Term> symbol_table;
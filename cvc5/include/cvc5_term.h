@@ -70,7 +70,11 @@ class Cvc5Term : public AbsTerm
    */
   TermIter begin() override;
   TermIter end() override;
+  std::size_t num_children() override;
+  Term get_child(std::size_t i) override;
+  void get_children(TermVec & out) override;
   std::string print_value_as(SortKind sk) override;
+  bool export_value(TermValue & out) override;
 
   // getters for solver-specific objects
   // for interacting with third-party cvc5-specific software
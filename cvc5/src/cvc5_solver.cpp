@@ -128,6 +128,14 @@ void Cvc5Solver::set_opt(const std::string option, const std::string value)
     // convert to milliseconds
     cvc5value = std::to_string(stoi(value) * 1000);
   }
+  else if (option == "resource-limit")
+  {
+    cvc5option = "rlimit-per";
+  }
+  else if (option == "random-seed")
+  {
+    cvc5option = "seed";
+  }
 
   try
   {
@@ -299,6 +307,51 @@ Term Cvc5Solver::make_term(std::string val,
   }
 }
 
+Term Cvc5Solver::import_value(const TermValue & val, const Sort & sort) const
+{
+  try
+  {
+    TermValue v = cast_value_for_import(val, sort);
+    ::cvc5::Term c;
+
+    if (v.kind == BOOL)
+    {
+      c = solver.mkBoolean(v.get_bool());
+    }
+    else if (v.kind == BV)
+    {
+      c = (v.width <= 64)
+              ? solver.mkBitVector(v.width, v.get_uint64())
+              : solver.mkBitVector(v.width, v.num_to_string(2), 2);
+    }
+    else if (v.kind == INT)
+    {
+      c = v.num_fits_int64()
+              ? solver.mkInteger(v.get_int64())
+              : solver.mkInteger((v.negative ? "-" : "") + v.num_to_string());
+    }
+    else
+    {
+      assert(v.kind == REAL);
+      if (v.num_fits_int64() && v.den_fits_int64())
+      {
+        c = solver.mkReal(v.get_int64(), v.get_den_int64());
+      }
+      else
+      {
+        c = solver.mkReal((v.negative ? "-" : "") + v.num_to_string() + "/"
+                          + v.den_to_string());
+      }
+    }
+
+    return std::make_shared<Cvc5Term>(c);
+  }
+  catch (::cvc5::CVC5ApiException & e)
+  {
+    throw IncorrectUsageException(e.what());
+  }
+}
+
 Term Cvc5Solver::make_term(const Term & val, const Sort & sort) const
 {
   std::shared_ptr<Cvc5Term> cterm = std::static_pointer_cast<Cvc5Term>(val);
@@ -451,6 +504,29 @@ Term Cvc5Solver::get_value(const Term & t) const
   }
 }
 
+void Cvc5Solver::get_values(const TermVec & terms, TermVec & out) const
+{
+  try
+  {
+    std::vector<::cvc5::Term> cterms;
+    cterms.reserve(terms.size());
+    for (const auto & t : terms)
+    {
+      cterms.push_back(std::static_pointer_cast<Cvc5Term>(t)->term);
+    }
+    std::vector<::cvc5::Term> cvals = solver.getValue(cterms);
+    out.reserve(out.size() + cvals.size());
+    for (const auto & v : cvals)
+    {
+      out.push_back(std::make_shared<Cvc5Term>(v));
+    }
+  }
+  catch (::cvc5::CVC5ApiException & e)
+  {
+    throw InternalSolverException(e.what());
+  }
+}
+
 UnorderedTermMap Cvc5Solver::get_array_values(const Term & arr,
                                               Term & out_const_base) const
 {
@@ -964,32 +1040,43 @@ Term Cvc5Solver::make_term(Op op, const TermVec & terms) const
       cterm = std::static_pointer_cast<Cvc5Term>(t);
       cterms.push_back(cterm->term);
     }
-    if (op.prim_op == Forall || op.prim_op == Exists)
-    {
-      ::cvc5::Kind quant_kind = primop2kind.at(op.prim_op);
-      ::cvc5::Term quant_res = cterms.back();
-      cterms.pop_back();
-      // bind quantifiers one a time
-      // makes traversal easier since smt-switch has no
-      // VARIABLE_LIST equivalent
-      while (cterms.size())
-      {
-        ::cvc5::Term bound_var =
-            solver.mkTerm(cvc5::Kind::VARIABLE_LIST, { cterms.back() });
-        cterms.pop_back();
-        quant_res = solver.mkTerm(quant_kind, { bound_var, quant_res });
-      }
-      return std::make_shared<Cvc5Term>(quant_res);
-    }
-    else if (op.num_idx == 0)
+    return std::make_shared<Cvc5Term>(make_cvc5_term(op, cterms));
+  }
+  catch (::cvc5::CVC5ApiException & e)
+  {
+    throw InternalSolverException(e.what());
+  }
+}
+
+void Cvc5Solver::make_terms(const TermVec & leaves,
+                            const std::vector<Op> & ops,
+                            const std::vector<size_t> & child_offsets,
+                            const std::vector<size_t> & children,
+                            TermVec & out) const
+{
+  check_make_terms_args(leaves.size(), ops, child_offsets, children);
+
+  try
+  {
+    // work on cvc5 terms directly and only wrap the results
+    std::vector<::cvc5::Term> nodes;
+    nodes.reserve(leaves.size() + ops.size());
+    for (const auto & l : leaves)
     {
-      return std::make_shared<Cvc5Term>(
-          solver.mkTerm(primop2kind.at(op.prim_op), cterms));
+      nodes.push_back(std::static_pointer_cast<Cvc5Term>(l)->term);
     }
-    else
+
+    out.reserve(out.size() + ops.size());
+    std::vector<::cvc5::Term> cterms;
+    for (size_t i = 0; i < ops.size(); ++i)
     {
-      ::cvc5::Op cvc5_op = make_cvc5_op(op);
-      return std::make_shared<Cvc5Term>(solver.mkTerm(cvc5_op, cterms));
+      cterms.clear();
+      for (size_t j = child_offsets[i]; j < child_offsets[i + 1]; ++j)
+      {
+        cterms.push_back(nodes[children[j]]);
+      }
+      nodes.push_back(make_cvc5_term(ops[i], cterms));
+      out.push_back(std::make_shared<Cvc5Term>(nodes.back()));
     }
   }
   catch (::cvc5::CVC5ApiException & e)
@@ -998,6 +1085,37 @@ Term Cvc5Solver::make_term(Op op, const TermVec & terms) const
   }
 }
 
+::cvc5::Term Cvc5Solver::make_cvc5_term(
+    Op op, std::vector<::cvc5::Term> & cterms) const
+{
+  if (op.prim_op == Forall || op.prim_op == Exists)
+  {
+    ::cvc5::Kind quant_kind = primop2kind.at(op.prim_op);
+    ::cvc5::Term quant_res = cterms.back();
+    cterms.pop_back();
+    // bind quantifiers one a time
+    // makes traversal easier since smt-switch has no
+    // VARIABLE_LIST equivalent
+    while (cterms.size())
+    {
+      ::cvc5::Term bound_var =
+          solver.mkTerm(cvc5::Kind::VARIABLE_LIST, { cterms.back() });
+      cterms.pop_back();
+      quant_res = solver.mkTerm(quant_kind, { bound_var, quant_res });
+    }
+    return quant_res;
+  }
+  else if (op.num_idx == 0)
+  {
+    return solver.mkTerm(primop2kind.at(op.prim_op), cterms);
+  }
+  else
+  {
+    ::cvc5::Op cvc5_op = make_cvc5_op(op);
+    return solver.mkTerm(cvc5_op, cterms);
+  }
+}
+
 void Cvc5Solver::reset()
 {
   throw NotImplementedException("cvc5 does not support reset");
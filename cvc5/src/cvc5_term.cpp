@@ -142,7 +142,13 @@ Cvc5TermIter & Cvc5TermIter::operator=(const Cvc5TermIter & it)
 
 void Cvc5TermIter::operator++() { pos++; }
 
-const Term Cvc5TermIter::operator*()
+/** Get a child as it's exposed through the smt-switch interface
+ *  shared by Cvc5TermIter and Cvc5Term::get_child
+ *  @param term the parent term
+ *  @param pos the index of the child
+ *  @return the child at pos
+ */
+static Term get_cvc5_child(const ::cvc5::Term & term, uint32_t pos)
 {
   if (pos == term.getNumChildren()
       && term.getKind() == ::cvc5::Kind::CONST_ARRAY)
@@ -168,6 +174,8 @@ const Term Cvc5TermIter::operator*()
   return std::make_shared<Cvc5Term>(t);
 }
 
+const Term Cvc5TermIter::operator*() { return get_cvc5_child(term, pos); }
+
 TermIterBase * Cvc5TermIter::clone() const
 {
   return new Cvc5TermIter(term, pos);
@@ -344,6 +352,36 @@ TermIter Cvc5Term::end()
   return TermIter(new Cvc5TermIter(term, num_children));
 }
 
+size_t Cvc5Term::num_children()
+{
+  size_t num_children = term.getNumChildren();
+  if (term.getKind() == ::cvc5::Kind::CONST_ARRAY)
+  {
+    // base of constant array is the child
+    num_children++;
+  }
+  return num_children;
+}
+
+Term Cvc5Term::get_child(size_t i)
+{
+  if (i >= num_children())
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return get_cvc5_child(term, i);
+}
+
+void Cvc5Term::get_children(TermVec & out)
+{
+  size_t n = num_children();
+  for (size_t i = 0; i < n; ++i)
+  {
+    out.push_back(get_cvc5_child(term, i));
+  }
+}
+
 std::string Cvc5Term::print_value_as(SortKind sk)
 {
   if (!is_value())
@@ -354,6 +392,46 @@ std::string Cvc5Term::print_value_as(SortKind sk)
   return term.toString();
 }
 
+bool Cvc5Term::export_value(TermValue & out)
+{
+  ::cvc5::Kind k = term.getKind();
+  if (k == ::cvc5::Kind::CONST_BOOLEAN)
+  {
+    out = TermValue::make_bool(term.getBooleanValue());
+  }
+  else if (k == ::cvc5::Kind::CONST_BITVECTOR)
+  {
+    // cvc5 only exposes the digits of bit-vector values
+    out = TermValue::from_string("#b" + term.getBitVectorValue(2),
+                                 BV,
+                                 term.getSort().getBitVectorSize());
+  }
+  else if (k == ::cvc5::Kind::CONST_INTEGER
+           || k == ::cvc5::Kind::CONST_RATIONAL)
+  {
+    if (term.getSort().isInteger())
+    {
+      out = term.isInt64Value()
+                ? TermValue::make_int(term.getInt64Value())
+                : TermValue::from_string(term.getIntegerValue(), INT);
+    }
+    else if (term.isReal64Value())
+    {
+      std::pair<int64_t, uint64_t> r = term.getReal64Value();
+      out = TermValue::make_real(r.first, r.second);
+    }
+    else
+    {
+      out = TermValue::from_string(term.getRealValue(), REAL);
+    }
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
 /* end Cvc5Term implementation */
 
 }  // namespace smt
@@ -0,0 +1,92 @@
+/*********************                                                        */
+/*! \file deadline_timer.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A timer thread shared by all solvers of a process -- used for
+**        the time limits of backends without a native one.
+**
+**/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace smt {
+
+/** \class DeadlineTimer
+ *  Runs callbacks on a single background thread once their deadline
+ *  has passed. Backends use it to implement time limits by setting
+ *  the flag polled by their termination callback (or by calling the
+ *  solver's own stop function), instead of SIGALRM, which only
+ *  supports one pending alarm per process.
+ *
+ *  Callbacks run on the timer thread, so they must be short and
+ *  thread-safe. Thread-safe.
+ */
+class DeadlineTimer
+{
+ public:
+  typedef uint64_t Id;  ///< identifies a scheduled callback, never 0
+
+  /** @return the timer shared by the whole process
+   *  Its thread is started on first use.
+   */
+  static DeadlineTimer & get();
+
+  ~DeadlineTimer();
+  DeadlineTimer(const DeadlineTimer &) = delete;
+  DeadlineTimer & operator=(const DeadlineTimer &) = delete;
+
+  /** Run a callback once a delay has passed
+   *  @param delay the time to wait
+   *  @param callback the function to run on the timer thread
+   *  @return an id for cancel
+   */
+  Id schedule(std::chrono::steady_clock::duration delay,
+              std::function<void()> callback);
+
+  /** Cancel a scheduled callback
+   *  If the callback is currently running, waits until it returns,
+   *  so that the state it uses can be destroyed afterwards.
+   *  @param id the id returned by schedule, 0 is ignored
+   *  @return true iff the callback was cancelled before it ran
+   */
+  bool cancel(Id id);
+
+ private:
+  DeadlineTimer();
+
+  /** Body of the timer thread */
+  void run();
+
+  typedef std::chrono::steady_clock::time_point TimePoint;
+
+  // pending deadlines ordered by time, and their callbacks
+  std::set<std::pair<TimePoint, Id>> queue;
+  std::map<Id, std::pair<TimePoint, std::function<void()>>> callbacks;
+
+  Id next_id;
+  Id running;  ///< id of the callback being run, 0 if none
+  bool stop;
+
+  std::mutex m;
+  std::condition_variable cv;
+  std::thread thread;
+};
+
+}  // namespace smt
@@ -14,15 +14,17 @@
 ** limitations:
 ** 1. Some AbsSmtSolver methods are not implemented.
 **    These functions are defined first, under an appropriate comment below.
-** 2. The buffer size used to communicate with the binary of the solver
-**    is limited to values between 2 and 256.
-** 3. Generic solvers cannot be used in term transfer/translation.
-** 4. This feature is currently linux only -- no support for macOS.
+** 2. Generic solvers cannot be used in term transfer/translation.
+** 3. This feature is currently linux only -- no support for macOS.
+** 4. interrupt() kills the solver process, so the solver cannot be
+**    used anymore after an interrupted check.
 **
 **/
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -36,10 +38,27 @@ namespace smt {
 class GenericSolver : public AbsSmtSolver
 {
  public:
+  /** @param path the path to the solver binary
+   *  @param cmd_line_args the arguments to the binary
+   *  @param write_buf_size most bytes passed to a single write
+   *  @param read_buf_size initial size of reads from the binary
+   *  @param pipelined if true, declare-fun, define-fun, assert, push
+   *         and set-option commands are queued and sent together with
+   *         the next command that needs output, which then also checks
+   *         their `success` replies. Errors of a queued command are
+   *         thus reported by a later call.
+   *  @param use_let_terms if true, terms with operators are not defined
+   *         one by one with define-fun. Each assertion is sent as a
+   *         single term, binding its shared subterms with let. Only
+   *         subterms that are used again by a later command are given
+   *         a name with define-fun.
+   */
   GenericSolver(std::string path,
                 std::vector<std::string> cmd_line_args,
-                unsigned int write_buf_size = 256,
-                unsigned int read_buf_size = 256);
+                unsigned int write_buf_size = 65536,
+                unsigned int read_buf_size = 65536,
+                bool pipelined = false,
+                bool use_let_terms = false);
   ~GenericSolver();
 
   /***************************************************************/
@@ -100,6 +119,7 @@ class GenericSolver : public AbsSmtSolver
                  const Term & t2) const override;
   Term make_term(const Op op, const TermVec & terms) const override;
   Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
   void get_unsat_assumptions(UnorderedTermSet & out) override;
   // Will probably remove this eventually
   // For now, need to clear the hash table
@@ -110,6 +130,8 @@ class GenericSolver : public AbsSmtSolver
   void assert_formula(const Term & t) override;
   Result check_sat() override;
   Result check_sat_assuming(const TermVec & assumptions) override;
+  // kills the solver process if a check is running
+  void interrupt() override;
   void push(uint64_t num = 1) override;
   void pop(uint64_t num = 1) override;
   uint64_t get_context_level() const override;
@@ -160,6 +182,10 @@ class GenericSolver : public AbsSmtSolver
   // parse result (sat, unsat, unknown) from solver's output
   Result str_to_result(std::string result) const;
 
+  // run a check-sat or check-sat-assuming command
+  // while it runs, the process can be killed by interrupt()
+  Result run_check(std::string cmd);
+
   // parse actual value from a get-value response
   std::string strip_value_from_result(std::string result) const;
 
@@ -205,7 +231,35 @@ class GenericSolver : public AbsSmtSolver
   // get the name of a term
   std::string get_name(Term t) const;
 
+  // translate the value printed by the binary to a term of sort
+  Term value_from_string(std::string value, Sort sort) const;
+
+  // the text before the arguments, the arguments, and the text after
+  // them in the SMT-LIB representation of a term with an operator
+  void smtlib_def_parts(Term term,
+                        std::string & head,
+                        TermVec & args,
+                        std::string & tail) const;
+
+  // the SMT-LIB representation of a term for a command when let terms
+  // are used. Inlines the subterms that are not shared, binds the
+  // shared ones with let, and defines the ones sent by earlier commands.
+  std::string to_smtlib_let(const Term & root) const;
+
+  // record that a term was given a name with define-fun
+  void add_definition(const Term & t) const;
+
+  // forget the definitions made at context levels that were popped
+  void forget_definitions() const;
+
+  // the name of a term that can be used in any command
+  // defines the term first if needed (when let terms are used)
+  std::string get_defined_name(const Term & t) const;
+
   // internal function to read solver's response
+  // reads until one complete response (an atom ended by a newline or a
+  // balanced s-expression) was received, scanning every byte once.
+  // Output that arrives after the response is kept for the next call.
   std::string read_internal() const;
 
   // internal function to write to the solver's process
@@ -218,9 +272,21 @@ class GenericSolver : public AbsSmtSolver
   // verify that we got `success`
   void verify_success(std::string result) const;
 
-  // cmoputes  whether the current output from the solver
-  // is done being read
-  bool is_done(int just_read, std::string result) const;
+  // in pipelined mode, queue a command that only answers `success`
+  // otherwise, run it right away
+  void queue_command(std::string cmd) const;
+
+  // send the queued commands and verify their replies
+  void flush_commands() const;
+
+  // read the replies of the queued commands that were sent
+  // returns an error message for the first reply that is not `success`
+  // or the empty string if they all are
+  std::string read_queued_replies() const;
+
+  // reads the next chunk of output from the solver into read_pending
+  // returns the number of bytes read, 0 at end of file
+  size_t read_chunk() const;
 
   /***********
    * members *
@@ -237,12 +303,43 @@ class GenericSolver : public AbsSmtSolver
   int outpipefd[2];
   pid_t pid;
   int status;
-  char * write_buf;
-  char * read_buf;
 
   // buffer sizes
+  // write_buf_size is the most bytes passed to a single write
+  // read_buf_size is the initial size of a read, it grows when reads
+  // fill the whole buffer (e.g. on large get-value responses)
   unsigned int write_buf_size;
-  unsigned int read_buf_size;
+  mutable size_t read_buf_size;
+
+  // output read from the solver that was not consumed yet
+  // and the position of the first unconsumed byte
+  // updated in const methods, so marked mutable
+  mutable std::string read_pending;
+  mutable size_t read_pos;
+
+  // pipelined mode
+  // the queued commands that were not sent yet, and all commands
+  // whose replies were not verified yet
+  bool pipelined;
+  mutable std::string queued_commands;
+  mutable std::vector<std::string> unverified_commands;
+
+  // let terms mode
+  // ground terms with an operator that were part of an earlier command,
+  // and the ones that were given a name with define-fun
+  // definitions holds the latter with the context level they were
+  // defined at, in the order they were defined
+  bool use_let_terms;
+  std::unique_ptr<UnorderedTermSet> sent_terms;
+  std::unique_ptr<UnorderedTermSet> defined_terms;
+  std::unique_ptr<std::vector<std::pair<uint64_t, Term>>> definitions;
+
+  // interrupt support
+  // checking is true while the output of a check is awaited,
+  // process_killed is set once interrupt() killed the process
+  std::mutex interrupt_mutex;
+  bool checking;
+  std::atomic<bool> process_killed;
 
   // tracks the context level of the solver
   // (e.g., number of pushes - number of pops)
@@ -58,6 +58,9 @@ class GenericTerm : public AbsTerm
   bool is_symbolic_const() const override;
   TermIter begin() override;
   TermIter end() override;
+  std::size_t num_children() override;
+  Term get_child(std::size_t i) override;
+  void get_children(TermVec & out) override;
   TermVec get_children();
 
  protected:
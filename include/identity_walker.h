@@ -20,6 +20,7 @@
 
 #include "exceptions.h"
 #include "smt.h"
+#include "term_id_map.h"
 
 
 namespace smt
@@ -47,6 +48,11 @@ enum WalkerStepResult
  * The user can optionally pass a pointer to a cache. If that pointer
  * is non-null, it will be used in place of the internal cache.
  *
+ * Alternatively, the internal cache can be keyed by term id (ID_CACHE)
+ * instead of the term hash (HASH_CACHE, the default). This avoids
+ * calling AbsTerm::hash on every lookup and keeps the cache in a flat
+ * array, which is faster for passes over large DAGs.
+ *
  * Important Note: The term arguments should belong to the solver provided
  * to the identity walker, otherwise the behavior is undefined.
  */
@@ -56,7 +62,23 @@ public:
  IdentityWalker(const smt::SmtSolver & solver,
                 bool clear_cache,
                 smt::UnorderedTermMap * ext_cache = nullptr)
-     : solver_(solver), clear_cache_(clear_cache), ext_cache_(ext_cache){};
+     : solver_(solver),
+       clear_cache_(clear_cache),
+       cache_kind_(HASH_CACHE),
+       ext_cache_(ext_cache){};
+
+ /** Create a walker with an internal cache of the given kind
+  *  @param solver the solver to use for rebuilding terms
+  *  @param clear_cache if true, clears the cache between calls to visit
+  *  @param cache_kind the internal cache to use (HASH_CACHE or ID_CACHE)
+  */
+ IdentityWalker(const smt::SmtSolver & solver,
+                bool clear_cache,
+                CacheKind cache_kind)
+     : solver_(solver),
+       clear_cache_(clear_cache),
+       cache_kind_(cache_kind),
+       ext_cache_(nullptr){};
 
  /** Visit a term and all its subterms in a post-order traversal
   *  the member variable preorder_ is true if it's the first time seeing
@@ -103,7 +125,10 @@ protected:
 
 private:
  // derived classes should interact with cache through the methods above only
+ CacheKind cache_kind_;              /**< which internal cache is used */
  smt::UnorderedTermMap cache_;       /**< cache for updating terms */
+ smt::TermIdMap<Term> id_cache_;     /**< cache used instead of cache_ if
+                                        cache_kind_ is ID_CACHE */
  smt::UnorderedTermMap * ext_cache_; /**< external (user-provided) cache. If
                                         non-null, used instead of cache_ */
 };
@@ -0,0 +1,287 @@
+/*********************                                                        */
+/*! \file instrumented_solver.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Class that wraps another SmtSolver and records how often each
+**        API call is made and how long it takes.
+**/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "solver.h"
+#include "trace_recorder.h"
+
+namespace smt {
+
+/** \class LatencyHistogram
+ *  Log-linear histogram of latencies in nanoseconds. Each power of two
+ *  is split into eight buckets, so percentiles are within 12.5% of the
+ *  exact value, with a fixed amount of memory.
+ */
+class LatencyHistogram
+{
+ public:
+  LatencyHistogram();
+
+  /** @param ns the latency of one call in nanoseconds */
+  void record(uint64_t ns);
+
+  /** @param q a quantile between 0 and 1, e.g. 0.99
+   *  @return the upper bound of the bucket containing the q-quantile
+   *  (at most the maximum), 0 if nothing was recorded
+   */
+  uint64_t get_percentile(double q) const;
+
+  uint64_t get_count() const { return count; };
+  uint64_t get_total() const { return total; };
+  uint64_t get_max() const { return max; };
+
+  void clear();
+
+ protected:
+  std::vector<uint64_t> buckets;
+  uint64_t count;
+  uint64_t total;  ///< sum of all latencies
+  uint64_t max;
+};
+
+/** The API calls measured by InstrumentedSolver
+ *  All overloads of a method are counted together.
+ */
+enum InstrumentedCall
+{
+  SET_OPT_CALL = 0,
+  SET_LOGIC_CALL,
+  MAKE_SORT_CALL,
+  MAKE_SYMBOL_CALL,
+  MAKE_PARAM_CALL,
+  GET_SYMBOL_CALL,
+  MAKE_VALUE_CALL,  ///< make_term and import_value for values
+  MAKE_TERM_CALL,   ///< make_term with an Op
+  MAKE_TERMS_CALL,
+  ASSERT_FORMULA_CALL,
+  CHECK_SAT_CALL,
+  CHECK_SAT_ASSUMING_CALL,
+  PUSH_CALL,
+  POP_CALL,
+  GET_VALUE_CALL,
+  GET_VALUES_CALL,
+  GET_ARRAY_VALUES_CALL,
+  GET_UNSAT_ASSUMPTIONS_CALL,
+  GET_INTERPOLANT_CALL,
+  SUBSTITUTE_CALL,
+  RESET_CALL,
+  RESET_ASSERTIONS_CALL,
+  DATATYPE_CALL,  ///< creating and querying datatypes
+  NUM_INSTRUMENTED_CALLS
+};
+
+/** @return the name of the call, e.g. "check_sat" */
+std::string to_string(InstrumentedCall c);
+
+/**
+ * A class that wraps an SMT-solver and records, for each API call, the
+ * number of calls and a histogram of their latencies, and counts the
+ * terms created per PrimOp.
+ *
+ * Terms and sorts are those of the wrapped solver. When disabled, each
+ * call only costs an extra branch on top of the virtual dispatch.
+ * Independently of this, every call is recorded as a span while the
+ * TraceRecorder is started.
+ *
+ * NOTE: not thread-safe, like the solvers it wraps
+ */
+class InstrumentedSolver : public AbsSmtSolver
+{
+ public:
+  InstrumentedSolver(SmtSolver s);
+  ~InstrumentedSolver();
+
+  /** Turn recording on or off, the statistics are kept */
+  void set_enabled(bool e) { enabled = e; };
+  bool is_enabled() const { return enabled; };
+
+  /** Clear all recorded statistics */
+  void reset_statistics();
+
+  /** @return the latencies recorded for a call */
+  const LatencyHistogram & get_latencies(InstrumentedCall c) const
+  {
+    return latencies[c];
+  };
+
+  /** @return the name of a call, with static storage */
+  static const char * call_name(InstrumentedCall c);
+
+  /** @return the number of terms created with a PrimOp */
+  uint64_t get_num_terms(PrimOp po) const { return op_counts[po]; };
+
+  /** Flat view of the statistics, only for calls and PrimOps that occurred
+   *  Keys are <call>.count, <call>.total_us, <call>.p50_us, <call>.p90_us,
+   *  <call>.p99_us and <call>.max_us for each call, and
+   *  terms.<PrimOp> for the term counts.
+   */
+  std::map<std::string, double> get_statistics() const;
+
+  /** Write the statistics as a JSON object
+   *  @param out the stream to write to
+   */
+  void dump_json(std::ostream & out) const;
+
+  // all calls are forwarded to the wrapped solver
+  void set_opt(const std::string option, const std::string value) override;
+  void set_logic(const std::string logic) override;
+  void assert_formula(const Term & t) override;
+  Result check_sat() override;
+  Result check_sat_assuming(const TermVec & assumptions) override;
+  Result check_sat_assuming_list(const TermList & assumptions) override;
+  Result check_sat_assuming_set(
+      const UnorderedTermSet & assumptions) override;
+  void interrupt() override;
+  void push(uint64_t num = 1) override;
+  void pop(uint64_t num = 1) override;
+  uint64_t get_context_level() const override;
+  Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
+  UnorderedTermMap get_array_values(const Term & arr,
+                                    Term & out_const_base) const override;
+  void get_unsat_assumptions(UnorderedTermSet & out) override;
+  Sort make_sort(const std::string name, uint64_t arity) const override;
+  Sort make_sort(const SortKind sk) const override;
+  Sort make_sort(const SortKind sk, uint64_t size) const override;
+  Sort make_sort(const SortKind sk, const Sort & sort1) const override;
+  Sort make_sort(const SortKind sk,
+                 const Sort & sort1,
+                 const Sort & sort2) const override;
+  Sort make_sort(const SortKind sk,
+                 const Sort & sort1,
+                 const Sort & sort2,
+                 const Sort & sort3) const override;
+  Sort make_sort(const SortKind sk, const SortVec & sorts) const override;
+  Sort make_sort(const Sort & sort_con, const SortVec & sorts) const override;
+  Sort make_sort(const DatatypeDecl & d) const override;
+  DatatypeDecl make_datatype_decl(const std::string & s) override;
+  DatatypeConstructorDecl make_datatype_constructor_decl(
+      const std::string s) override;
+  void add_constructor(DatatypeDecl & dt,
+                       const DatatypeConstructorDecl & con) const override;
+  void add_selector(DatatypeConstructorDecl & dt,
+                    const std::string & name,
+                    const Sort & s) const override;
+  void add_selector_self(DatatypeConstructorDecl & dt,
+                         const std::string & name) const override;
+  Term get_constructor(const Sort & s, std::string name) const override;
+  Term get_tester(const Sort & s, std::string name) const override;
+  Term get_selector(const Sort & s,
+                    std::string con,
+                    std::string name) const override;
+  Term make_term(bool b) const override;
+  Term make_term(int64_t i, const Sort & sort) const override;
+  Term make_term(const std::string & s,
+                 bool useEscSequences,
+                 const Sort & sort) const override;
+  Term make_term(const std::wstring & s, const Sort & sort) const override;
+  Term make_term(const std::string val,
+                 const Sort & sort,
+                 uint64_t base = 10) const override;
+  Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
+  Term make_symbol(const std::string name, const Sort & sort) override;
+  Term get_symbol(const std::string & name) override;
+  Term make_param(const std::string name, const Sort & sort) override;
+  Term make_term(const Op op, const Term & t) const override;
+  Term make_term(const Op op, const Term & t0, const Term & t1) const override;
+  Term make_term(const Op op,
+                 const Term & t0,
+                 const Term & t1,
+                 const Term & t2) const override;
+  Term make_term(const Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
+  void reset() override;
+  void reset_assertions() override;
+  Term substitute(const Term term,
+                  const UnorderedTermMap & substitution_map) const override;
+  TermVec substitute_terms(
+      const TermVec & terms,
+      const UnorderedTermMap & substitution_map) const override;
+  void dump_smt2(std::string filename) const override;
+  Result get_interpolant(const Term & A,
+                         const Term & B,
+                         Term & out_I) const override;
+
+ protected:
+  /** Records the time from its construction to its destruction,
+   *  also if the call throws an exception, in the histogram of the call
+   *  (if enabled) and as a trace span (if the TraceRecorder is started).
+   */
+  class CallTimer
+  {
+   public:
+    CallTimer(const InstrumentedSolver * s, InstrumentedCall c)
+        : hist(s->enabled ? &s->latencies[c] : nullptr),
+          span(call_name(c), "solver", s->solver_enum)
+    {
+      if (hist)
+      {
+        start = std::chrono::steady_clock::now();
+      }
+    };
+    ~CallTimer()
+    {
+      if (hist)
+      {
+        hist->record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count());
+      }
+    };
+
+   private:
+    LatencyHistogram * hist;
+    std::chrono::steady_clock::time_point start;
+    TraceSpan span;
+  };
+
+  /** Count a term created with op, if enabled */
+  void count_op(const Op & op) const
+  {
+    if (enabled)
+    {
+      op_counts[op.prim_op]++;
+    }
+  };
+
+  /* The wrapped solver */
+  SmtSolver wrapped_solver;
+  bool enabled;
+  // statistics are updated by const methods such as make_term
+  mutable std::vector<LatencyHistogram> latencies;
+  mutable std::vector<uint64_t> op_counts;
+};
+
+/* Returns an instrumented SmtSolver by wrapping InstrumentedSolver's
+ * constructor.
+ * @param wrapped_solver the solver to wrap
+ * @return an SmtSolver that records statistics about each call
+ */
+SmtSolver create_instrumented_solver(SmtSolver wrapped_solver);
+
+}  // namespace smt
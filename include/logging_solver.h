@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "node_pool.h"
 #include "solver.h"
 #include "term_hashtable.h"
 
@@ -26,7 +27,15 @@ namespace smt {
 class LoggingSolver : public AbsSmtSolver
 {
  public:
-  LoggingSolver(SmtSolver s);
+  /** Create a LoggingSolver
+   *  @param s the solver to wrap
+   *  @param weak_hashconsing if true, the hash table used for hash-consing
+   *         does not keep terms alive. A term (and the wrapped term it holds)
+   *         is destroyed and removed from the table once the last reference
+   *         to it is dropped. Otherwise, every created term stays alive
+   *         until reset.
+   */
+  LoggingSolver(SmtSolver s, bool weak_hashconsing = false);
   ~LoggingSolver();
 
   // implemented
@@ -63,6 +72,7 @@ class LoggingSolver : public AbsSmtSolver
                  const Sort & sort,
                  uint64_t base = 10) const override;
   Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
   Term make_symbol(const std::string name, const Sort & sort) override;
   Term get_symbol(const std::string & name) override;
   Term make_param(const std::string name, const Sort & sort) override;
@@ -73,7 +83,13 @@ class LoggingSolver : public AbsSmtSolver
                  const Term & t1,
                  const Term & t2) const override;
   Term make_term(const Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
   Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
   UnorderedTermMap get_array_values(const Term & arr,
                                     Term & out_const_base) const override;
   void get_unsat_assumptions(UnorderedTermSet & out) override;
@@ -81,6 +97,13 @@ class LoggingSolver : public AbsSmtSolver
   // For now, need to clear the hash table
   void reset() override;
 
+  /** @return the number of terms currently in the hash-consing table */
+  size_t get_num_live_terms() const;
+  /** @return the number of terms that were destroyed and removed from the
+   *          hash-consing table. Always zero unless weak_hashconsing is set.
+   */
+  size_t get_num_collected_terms() const;
+
   // dispatched to underlying solver
   void set_opt(const std::string option, const std::string value) override;
   void set_logic(const std::string logic) override;
@@ -89,14 +112,33 @@ class LoggingSolver : public AbsSmtSolver
   Result check_sat_assuming(const TermVec & assumptions) override;
   Result check_sat_assuming_list(const TermList & assumptions) override;
   Result check_sat_assuming_set(const UnorderedTermSet & assumptions) override;
+  void interrupt() override;
   void push(uint64_t num = 1) override;
   void pop(uint64_t num = 1) override;
   uint64_t get_context_level() const override;
   void reset_assertions() override;
 
  protected:
+  /** Looks up t in the hash-consing table and inserts it if it's new
+   *  @param t the term to look up -- modified in place if an equivalent
+   *         term already exists
+   *  @return true iff the term already existed
+   */
+  bool hashcons(Term & t) const;
+  bool in_hashtable(const Term & t) const;
+
   SmtSolver wrapped_solver;  ///< the underlying solver
+  /** memory pool for the LoggingTerms and LoggingSorts of this solver
+   *  shared with the allocated objects, which can outlive the solver
+   */
+  std::shared_ptr<NodePool> pool;
+  /** only set when not using weak hash-consing */
   std::unique_ptr<TermHashTable> hashtable;
+  /** only set when using weak hash-consing, and then used instead of
+   *  hashtable. Shared with the terms so they can remove themselves
+   *  even if they outlive the solver
+   */
+  std::shared_ptr<WeakTermHashTable> weak_hashtable;
 
   std::unordered_map<std::string, Term> symbol_table;
 
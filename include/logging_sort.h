@@ -17,6 +17,7 @@
 #pragma once
 
 #include "exceptions.h"
+#include "node_pool.h"
 #include "smt_defs.h"
 #include "sort.h"
 
@@ -25,16 +26,43 @@ namespace smt {
 /* Helper functions for creating logging sorts */
 // Sort s is the underlying sort
 // all other sorts are LoggingSorts
-Sort make_uninterpreted_logging_sort(Sort s, std::string name, uint64_t arity);
-Sort make_uninterpreted_logging_sort(Sort s,
-                                     std::string name,
-                                     const SortVec & sorts);
-Sort make_logging_sort(SortKind sk, Sort s);
-Sort make_logging_sort(SortKind sk, Sort s, uint64_t width);
-Sort make_logging_sort(SortKind sk, Sort s, Sort sort1);
-Sort make_logging_sort(SortKind sk, Sort s, Sort sort1, Sort sort2);
-Sort make_logging_sort(SortKind sk, Sort s, Sort sort1, Sort sort2, Sort sort3);
-Sort make_logging_sort(SortKind sk, Sort s, SortVec sorts);
+// if a pool is provided, the sort is allocated from it
+Sort make_uninterpreted_logging_sort(
+    Sort s,
+    std::string name,
+    uint64_t arity,
+    const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_uninterpreted_logging_sort(
+    Sort s,
+    std::string name,
+    const SortVec & sorts,
+    const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       uint64_t width,
+                       const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       Sort sort1,
+                       const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       Sort sort1,
+                       Sort sort2,
+                       const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       Sort sort1,
+                       Sort sort2,
+                       Sort sort3,
+                       const std::shared_ptr<NodePool> & pool = nullptr);
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       SortVec sorts,
+                       const std::shared_ptr<NodePool> & pool = nullptr);
 
 /** \class LoggingSort
  *  An abstract class for logging created Sorts
@@ -16,23 +16,44 @@
 
 #pragma once
 
+#include <initializer_list>
+
+#include "node_pool.h"
 #include "ops.h"
 #include "smt_defs.h"
 #include "term.h"
 
 namespace smt {
 
+class WeakTermHashTable;
+
 class LoggingTerm : public AbsTerm
 {
  public:
-  LoggingTerm(Term t, Sort s, Op o, TermVec c, size_t id);
+  // more than num_inline_children children are stored in an array
+  // allocated from pool (or the heap if pool is null)
+  LoggingTerm(Term t,
+              Sort s,
+              Op o,
+              const TermVec & c,
+              size_t id,
+              const std::shared_ptr<NodePool> & pool = nullptr);
+  // avoids building a TermVec for the common case of few children
+  LoggingTerm(Term t, Sort s, Op o, std::initializer_list<Term> c, size_t id);
   // this one is for making symbols
   // if passed with true, sets is_sym true
   // otherwise sets is_param true
   // only symbols and parameters have names
-  LoggingTerm(
-      Term t, Sort s, Op o, TermVec c, std::string r, bool is_sym, size_t id);
+  LoggingTerm(Term t,
+              Sort s,
+              Op o,
+              const TermVec & c,
+              std::string r,
+              bool is_sym,
+              size_t id);
   virtual ~LoggingTerm();
+  LoggingTerm(const LoggingTerm &) = delete;
+  LoggingTerm & operator=(const LoggingTerm &) = delete;
 
   // implemented
 
@@ -51,31 +72,60 @@ class LoggingTerm : public AbsTerm
   bool is_symbolic_const() const override;
   TermIter begin() override;
   TermIter end() override;
+  std::size_t num_children() override;
+  Term get_child(std::size_t i) override;
+  void get_children(TermVec & out) override;
 
   // dispatched to underlying term
   std::size_t hash() const override;
   bool is_value() const override;
   uint64_t to_int() const override;
   std::string print_value_as(SortKind sk) override;
+  bool export_value(TermValue & out) override;
 
  protected:
   Term wrapped_term;  ///< the term of the underlying solver
   Sort sort;          ///< a LoggingSort
   Op op;
-  TermVec children;
+  // children are stored inline when there are at most
+  // num_inline_children of them, and in a separate array otherwise
+  // (see init_children)
+  static const size_t num_inline_children = 3;
+  Term * children;
+  size_t num_children_;
+  Term inline_children[num_inline_children];
   std::string repr;
   bool is_sym;
   bool is_par;
   size_t id_;  ///< unique id for this term
+  /** the table this term removes itself from when destroyed
+   *  only set when the LoggingSolver uses weak hash-consing
+   */
+  std::shared_ptr<WeakTermHashTable> weak_table;
 
   // So LoggingSolver can access protected members:
   friend class LoggingSolver;
+
+ private:
+  /** the header in front of a separate children array
+   *  keeps the pool alive and remembers the size of the allocation,
+   *  so terms with few children don't pay for a pool pointer
+   */
+  struct ChildrenHeader
+  {
+    std::shared_ptr<NodePool> pool;  ///< null if allocated with new
+    std::size_t bytes;
+  };
+
+  void init_children(const Term * c,
+                     size_t n,
+                     const std::shared_ptr<NodePool> & pool = nullptr);
 };
 
 class LoggingTermIter : public TermIterBase
 {
  public:
-  LoggingTermIter(TermVec::iterator i);
+  LoggingTermIter(const Term * i);
   LoggingTermIter(const LoggingTermIter & lit);
   ~LoggingTermIter();
   LoggingTermIter & operator=(const LoggingTermIter & lit);
@@ -87,7 +137,7 @@ class LoggingTermIter : public TermIterBase
 
  protected:
   bool equal(const TermIterBase & other) const override;
-  TermVec::iterator it;
+  const Term * it;
 };
 
 }  // namespace smt
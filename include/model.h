@@ -0,0 +1,95 @@
+/*********************                                                        */
+/*! \file model.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A solver-independent snapshot of a model.
+**
+**/
+
+#pragma once
+
+#include <unordered_map>
+
+#include "smt_defs.h"
+#include "term.h"
+#include "term_value.h"
+
+namespace smt {
+
+/** \struct ArrayValue
+ *  The value of an array: a default value for all indices
+ *  and the finite set of indices where it differs from it.
+ */
+struct ArrayValue
+{
+  /** @param idx an index value
+   *  @return the element at idx
+   *          (a null TermValue if idx is not stored and there's no
+   *           default value)
+   */
+  const TermValue & select(const TermValue & idx) const;
+
+  TermValue default_value;  ///< null if the solver gave no constant base
+  std::unordered_map<TermValue, TermValue> stores;
+};
+
+/** \class Model
+ *  The values of a set of symbols in a satisfying assignment.
+ *
+ *  Values are stored as TermValues (and ArrayValues for arrays), so a
+ *  Model does not refer to solver values and remains valid after the
+ *  solver moves on, e.g. after the next check_sat.
+ *  Symbols are looked up in constant time.
+ *  See AbsSmtSolver::get_model.
+ */
+class Model
+{
+ public:
+  Model(){};
+
+  /** Sets the value of a (non-array) symbol */
+  void add_value(const Term & sym, const TermValue & val);
+  /** Sets the value of an array symbol */
+  void add_array_value(const Term & sym, const ArrayValue & val);
+
+  /** @return true iff the model has a value for sym */
+  bool contains(const Term & sym) const;
+
+  /** @return the value of a non-array symbol
+   *  throws an IncorrectUsageException if there is none
+   */
+  const TermValue & get_value(const Term & sym) const;
+  /** @return the value of an array symbol
+   *  throws an IncorrectUsageException if there is none
+   */
+  const ArrayValue & get_array_value(const Term & sym) const;
+
+  /** @return the symbols of the model, in the order they were added */
+  const TermVec & get_symbols() const { return symbols_; };
+  size_t size() const { return symbols_.size(); };
+
+  /** Converts a value term of a solver
+   *  Uses AbsTerm::export_value, and parses the printed value
+   *  if the solver can't export it.
+   *  @param val a value term of sort BOOL, BV, INT or REAL
+   *  @return the value
+   *  throws a NotImplementedException for other sorts
+   */
+  static TermValue to_term_value(const Term & val);
+
+ private:
+  TermVec symbols_;
+  std::unordered_map<Term, TermValue> values_;
+  std::unordered_map<Term, ArrayValue> array_values_;
+};
+
+std::ostream & operator<<(std::ostream & output, const Model & m);
+
+}  // namespace smt
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file node_pool.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A pool allocator for small, frequently created objects -- used
+**        for the terms and sorts of LoggingSolver.
+**
+**/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace smt {
+
+/** \class NodePool
+ *  A bump allocator with per size-class free lists
+ *  Memory is carved out of large blocks, and freed chunks are
+ *  recycled for later allocations of the same size class.
+ *  Blocks are only returned to the system when the pool is destroyed.
+ *  Allocations larger than the biggest size class use operator new.
+ *
+ *  NOTE: not thread-safe, like the solvers using it
+ */
+class NodePool
+{
+ public:
+  NodePool();
+  ~NodePool();
+  NodePool(const NodePool &) = delete;
+  NodePool & operator=(const NodePool &) = delete;
+
+  void * allocate(std::size_t size);
+  void deallocate(void * p, std::size_t size);
+
+  /** @return the total number of bytes reserved in blocks */
+  std::size_t get_reserved_bytes() const
+  {
+    return blocks.size() * block_size;
+  };
+
+ protected:
+  static const std::size_t granularity = 16;
+  static const std::size_t num_size_classes = 16;
+  static const std::size_t max_pooled_size = granularity * num_size_classes;
+  static const std::size_t block_size = 64 * 1024;
+
+  struct FreeChunk
+  {
+    FreeChunk * next;
+  };
+
+  FreeChunk * free_lists[num_size_classes];
+  std::vector<std::unique_ptr<char[]>> blocks;
+  char * cur;  ///< next free byte of the current block
+  char * end;  ///< end of the current block
+};
+
+/** STL allocator that allocates from a NodePool
+ *  keeps the pool alive, so objects allocated with it
+ *  can outlive the owner of the pool (e.g. a solver)
+ */
+template <class T>
+class PoolAllocator
+{
+ public:
+  typedef T value_type;
+
+  PoolAllocator(std::shared_ptr<NodePool> p) : pool(std::move(p)) {}
+  template <class U>
+  PoolAllocator(const PoolAllocator<U> & other) : pool(other.pool)
+  {
+  }
+
+  T * allocate(std::size_t n)
+  {
+    return static_cast<T *>(pool->allocate(n * sizeof(T)));
+  }
+  void deallocate(T * p, std::size_t n) { pool->deallocate(p, n * sizeof(T)); }
+
+  std::shared_ptr<NodePool> pool;
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T> & a, const PoolAllocator<U> & b)
+{
+  return a.pool == b.pool;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T> & a, const PoolAllocator<U> & b)
+{
+  return a.pool != b.pool;
+}
+
+/** Create an object in a single allocation (object and reference counts)
+ *  from a pool, or with make_shared if pool is null
+ */
+template <class T, class... Args>
+std::shared_ptr<T> make_pooled(const std::shared_ptr<NodePool> & pool,
+                               Args &&... args)
+{
+  if (pool)
+  {
+    return std::allocate_shared<T>(PoolAllocator<T>(pool),
+                                   std::forward<Args>(args)...);
+  }
+  return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+}  // namespace smt
@@ -9,48 +9,343 @@
 ** All rights reserved.  See the file LICENSE in the top-level source
 ** directory for licensing information.\endverbatim
 **
-** \brief Header for a portfolio solving function that takes a vector
-**        of solvers and a term, and returns check_sat from the first solver
-**        that finishes.
+** \brief An incremental portfolio solver that keeps several solvers alive,
+**        forwards every assertion to all of them, and returns the result
+**        of the first solver that finishes each check.
 **/
 #pragma once
 
 #include <condition_variable>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 
 #include "smt.h"
 
 namespace smt {
 
-class PortfolioSolver
+/**
+ * Records which solver of a portfolio won the checks of queries with
+ * some features, and orders the solvers for later queries, best first.
+ *
+ * A scheduler can be shared by several portfolios, as long as they
+ * list the same solver configurations in the same order. It is
+ * thread-safe.
+ */
+class PortfolioScheduler
 {
  public:
+  /** Record that solver i answered a query first
+   *  @param features a description of the query, see
+   *         PortfolioSolver::get_query_features
+   *  @param i the index of the winning solver
+   *  @param seconds the time the winning solver took
+   */
+  void record_win(const std::string & features, size_t i, double seconds);
+
+  /** Order the solvers of a portfolio for a query
+   *  Solvers that won more queries with the same features come first,
+   *  ties are broken by a lower average time of those wins, then by more
+   *  wins over all queries and finally by index.
+   *  @param features a description of the query
+   *  @param num_solvers the number of solvers in the portfolio
+   *  @return the solver indices in the order they should be launched
+   */
+  std::vector<size_t> schedule(const std::string & features,
+                               size_t num_solvers) const;
+
+  /** @return how many queries with the given features solver i won */
+  size_t get_wins(const std::string & features, size_t i) const;
+
+ private:
+  struct WinStats
+  {
+    size_t wins = 0;
+    double seconds = 0;  ///< total time of the wins
+  };
+
+  // wins of each solver index, per query features and over all queries
+  std::unordered_map<std::string, std::vector<WinStats>> feature_stats;
+  std::vector<WinStats> total_stats;
+
+  mutable std::mutex m;
+};
+
+/**
+ * A solver that races several solvers on each check_sat.
+ *
+ * Sorts and terms are created with the first solver. Assertions,
+ * push and pop are forwarded to all solvers, translating the terms into
+ * the others with a TermTranslator that is kept for the lifetime of the
+ * portfolio, so that terms shared by several commands are only translated
+ * once. The solvers keep their assertions between checks.
+ *
+ * check_sat and check_sat_assuming run all solvers in parallel threads.
+ * The first sat or unsat answer wins and is returned as soon as the other
+ * solvers have been stopped with interrupt(). Solvers that do not support
+ * interrupt are left running in the background (except the first solver,
+ * which owns the terms of the portfolio): commands for them are queued
+ * and applied once their check has finished, and they sit out the checks
+ * that start before that. Models and unsat assumptions are read from the
+ * winning solver and translated back to the terms of the first solver.
+ *
+ * The solvers are launched in the order given by a PortfolioScheduler,
+ * which learns from the winners of earlier checks. With a core budget,
+ * only that many solvers run at the same time: the next solver in the
+ * schedule is started when a running one finishes without an answer.
+ * The solvers can be diversified with different options, e.g. random
+ * seeds, see set_solver_opt and diversify_seeds.
+ *
+ * Generic solvers cannot be used because they do not support term
+ * translation.
+ */
+class PortfolioSolver : public AbsSmtSolver
+{
+ public:
+  /** @param slvrs the solvers to race, must not be empty.
+   *         Terms of this solver belong to the first one.
+   */
+  PortfolioSolver(std::vector<SmtSolver> slvrs);
+
+  /** Portfolio for a single term, see portfolio_solve
+   *  @param slvrs the solvers to race, must not be empty
+   *  @param trm the term to be checked, may belong to any solver
+   */
   PortfolioSolver(std::vector<SmtSolver> slvrs, Term trm);
 
-  /** Launch many solvers and return whether the term is satisfiable when one of
-   *  them has finished.
-   *  @param solvers The solvers to run.
-   *  @param t The term to be checked.
+  ~PortfolioSolver();
+
+  /** Assert the term given to the constructor and check satisfiability
+   *  with all the solvers.
    */
   smt::Result portfolio_solve();
 
- private:
-  smt::Result result;
+  /** @return the index of the solver whose result was returned by
+   *  the last check
+   */
+  size_t get_winner() const { return winner; };
+
+  /** Set an option on one solver of the portfolio only
+   *  @param i the index of the solver
+   *  @param option name of the option
+   *  @param value string value
+   */
+  void set_solver_opt(size_t i,
+                      const std::string option,
+                      const std::string value);
+
+  /** Give every solver a different random seed (its index)
+   *  Solvers that don't support the random-seed option are left as is.
+   */
+  void diversify_seeds();
+
+  /** Limit the number of solvers that run at the same time
+   *  @param budget the maximum number of running solvers, 0 for no limit
+   */
+  void set_core_budget(size_t budget) { core_budget = budget; };
+
+  /** Use a scheduler, e.g. one that is shared with other portfolios */
+  void set_scheduler(std::shared_ptr<PortfolioScheduler> s)
+  {
+    scheduler = s;
+  };
+
+  std::shared_ptr<PortfolioScheduler> get_scheduler() const
+  {
+    return scheduler;
+  };
+
+  /** @param assuming whether the query is a check_sat_assuming
+   *  @return a description of the query for the current assertions,
+   *  consisting of the logic, the kind of check and the number of
+   *  assertions rounded up to a power of two
+   */
+  std::string get_query_features(bool assuming) const;
+
+  // forwarded to all solvers
+  void set_opt(const std::string option, const std::string value) override;
+  void set_logic(const std::string logic) override;
+  void assert_formula(const Term & t) override;
+  void push(uint64_t num = 1) override;
+  void pop(uint64_t num = 1) override;
+  void reset() override;
+  void reset_assertions() override;
+  void interrupt() override;
+
+  // raced between the solvers
+  Result check_sat() override;
+  Result check_sat_assuming(const TermVec & assumptions) override;
+
+  // answered by the winner of the last check
+  Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
+  UnorderedTermMap get_array_values(const Term & arr,
+                                    Term & out_const_base) const override;
+  void get_unsat_assumptions(UnorderedTermSet & out) override;
+
+  // dispatched to the first solver
+  uint64_t get_context_level() const override;
+  Sort make_sort(const std::string name, uint64_t arity) const override;
+  Sort make_sort(const SortKind sk) const override;
+  Sort make_sort(const SortKind sk, uint64_t size) const override;
+  Sort make_sort(const SortKind sk, const Sort & sort1) const override;
+  Sort make_sort(const SortKind sk,
+                 const Sort & sort1,
+                 const Sort & sort2) const override;
+  Sort make_sort(const SortKind sk,
+                 const Sort & sort1,
+                 const Sort & sort2,
+                 const Sort & sort3) const override;
+  Sort make_sort(const SortKind sk, const SortVec & sorts) const override;
+  Sort make_sort(const Sort & sort_con, const SortVec & sorts) const override;
+  Sort make_sort(const DatatypeDecl & d) const override;
+  DatatypeDecl make_datatype_decl(const std::string & s) override;
+  DatatypeConstructorDecl make_datatype_constructor_decl(
+      const std::string s) override;
+  void add_constructor(DatatypeDecl & dt,
+                       const DatatypeConstructorDecl & con) const override;
+  void add_selector(DatatypeConstructorDecl & dt,
+                    const std::string & name,
+                    const Sort & s) const override;
+  void add_selector_self(DatatypeConstructorDecl & dt,
+                         const std::string & name) const override;
+  Term get_constructor(const Sort & s, std::string name) const override;
+  Term get_tester(const Sort & s, std::string name) const override;
+  Term get_selector(const Sort & s,
+                    std::string con,
+                    std::string name) const override;
+  Term make_term(bool b) const override;
+  Term make_term(int64_t i, const Sort & sort) const override;
+  Term make_term(const std::string & s,
+                 bool useEscSequences,
+                 const Sort & sort) const override;
+  Term make_term(const std::wstring & s, const Sort & sort) const override;
+  Term make_term(const std::string val,
+                 const Sort & sort,
+                 uint64_t base = 10) const override;
+  Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
+  Term make_symbol(const std::string name, const Sort & sort) override;
+  Term get_symbol(const std::string & name) override;
+  Term make_param(const std::string name, const Sort & sort) override;
+  Term make_term(const Op op, const Term & t) const override;
+  Term make_term(const Op op, const Term & t0, const Term & t1) const override;
+  Term make_term(const Op op,
+                 const Term & t0,
+                 const Term & t1,
+                 const Term & t2) const override;
+  Term make_term(const Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
+
+ protected:
   std::vector<SmtSolver> solvers;
+  // translators from the first solver to solver i and back
+  // (entry 0 is null, the first solver doesn't need translation)
+  std::vector<std::unique_ptr<TermTranslator>> translators;
+  std::vector<std::unique_ptr<TermTranslator>> back_translators;
+  // term for portfolio_solve, might belong to a solver outside the portfolio
   Term portfolio_term;
-  // Once a solver is done, result has been set,
-  // and the main thread can terminate the others.
-  bool a_solver_is_done = false;
 
-  // Used for synchronization.
-  std::mutex m;
-  std::condition_variable cv;
+  // scheduling
+  std::shared_ptr<PortfolioScheduler> scheduler;
+  size_t core_budget;
+  std::string logic;
+  // number of assertions per context level
+  std::vector<size_t> num_assertions;
+
+  // index of the solver whose result was returned by the last check
+  size_t winner;
+  // assumptions of the last check_sat_assuming, translated to the winner
+  // mapped to the assumptions that were passed by the user
+  UnorderedTermMap winner_assumptions;
+
+  /** State of a check, shared with the solver threads, which can outlive
+   *  the check (and the portfolio) when their solver can't be interrupted
+   */
+  struct Race;
+  // the running check, if any, for interrupt()
+  std::shared_ptr<Race> current_race;
+  std::mutex race_mutex;
+
+  /** A solver that was still running when the last check returned */
+  struct Straggler
+  {
+    std::thread thread;
+    std::shared_ptr<Race> race;
+    // commands for the solver, applied in order once it has finished
+    std::vector<std::function<void()>> pending;
+  };
+  // one entry per solver, the thread is empty if the solver is idle
+  std::vector<Straggler> stragglers;
+
+  /** Runs a check with a solver and the arguments for it */
+  typedef std::function<Result(SmtSolver &, const TermVec &)> Check;
+
+  /** Creates the translators between the first solver and solver i */
+  void init_translators(size_t i);
+
+  /** @return true iff solver i is still running a check of an earlier race
+   */
+  bool is_running(size_t i);
+
+  /** If solver i finished its check in the background, join its thread
+   *  and apply the commands that were queued for it
+   */
+  void sync_solver(size_t i);
+
+  /** Run op now, or once solver i has finished its running check */
+  void for_solver(size_t i, std::function<void()> op);
+
+  /** Run op for each solver index, see for_solver */
+  void for_all_solvers(const std::function<void(size_t)> & op);
+
+  /** Sync all solvers
+   *  @return for each solver, whether it can take part in a check
+   */
+  std::vector<bool> sync_solvers();
 
-  /** Translate the term t to the solver s, and check_sat.
-   *  @param s The solver to translate the term t to.
-   *  @param t The term being translated to solver s.
+  /** Run check on the available solvers in separate threads, in the order
+   *  of the scheduler and within the core budget, and return the first sat
+   *  or unsat answer.
+   *  @param features the query features, used for scheduling
+   *  @param available the solvers that can take part, see sync_solvers
+   *  @param check the check to run
+   *  @param args the arguments of the check for each solver
    */
-  void run_solver(SmtSolver s);
+  Result race(const std::string & features,
+              const std::vector<bool> & available,
+              const Check & check,
+              const std::vector<TermVec> & args);
+
+  /** Runs check for solver i and records its result in the race
+   *  Only uses what it is given, so it can outlive the portfolio.
+   *  @param race the state of the check
+   *  @param solver the solver to run
+   *  @param i the index of the solver
+   *  @param check the check to run
+   *  @param args the arguments of the check, terms of solver
+   */
+  static void run_solver(std::shared_ptr<Race> race,
+                         SmtSolver solver,
+                         size_t i,
+                         Check check,
+                         TermVec args);
+
+  /** Interrupt solver i
+   *  @return false if the solver doesn't support interrupt
+   */
+  bool interrupt_solver(size_t i);
+
+  /** Translate a term of the first solver to the winner of the last check */
+  Term to_winner(const Term & t) const;
+
+  /** Translate a term of the winner of the last check to the first solver */
+  Term from_winner(const Term & t) const;
 };
 }  // namespace smt
@@ -50,6 +50,7 @@ class PrintingSolver : public AbsSmtSolver
   Term make_symbol(const std::string name, const Sort & sort) override;
   Term make_param(const std::string name, const Sort & sort) override;
   Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
   UnorderedTermMap get_array_values(const Term & arr,
                                     Term & out_const_base) const override;
   void get_unsat_assumptions(UnorderedTermSet & out) override;
@@ -72,6 +73,7 @@ class PrintingSolver : public AbsSmtSolver
    * created terms will appear in other commands (e.g., assert). 
    * */
   Term get_symbol(const std::string & name) override;
+  void interrupt() override;
   Sort make_sort(const SortKind sk) const override;
   Sort make_sort(const SortKind sk, uint64_t size) const override;
   Sort make_sort(const SortKind sk, const Sort & sort1) const override;
@@ -104,6 +106,7 @@ class PrintingSolver : public AbsSmtSolver
                  const Sort & sort,
                  uint64_t base = 10) const override;
   Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
   Term make_term(const Op op, const Term & t) const override;
   Term make_term(const Op op, const Term & t0, const Term & t1) const override;
   Term make_term(const Op op,
@@ -111,6 +114,11 @@ class PrintingSolver : public AbsSmtSolver
                  const Term & t1,
                  const Term & t2) const override;
   Term make_term(const Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
 
 
 
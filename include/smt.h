@@ -37,6 +37,9 @@
 // Main solver interface.
 #include "solver.h"
 
+// Solver-independent model snapshots.
+#include "model.h"
+
 // Solver enums for identifying solver
 #include "solver_enums.h"
 
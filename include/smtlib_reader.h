@@ -18,7 +18,9 @@
 
 #include "assert.h"
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "smt.h"
 #include "smtlibparser.h"
@@ -117,13 +119,28 @@ class SmtLibReader
    */
   SmtLibReader(smt::SmtSolver & solver, bool strict = false);
 
+  virtual ~SmtLibReader();
+
   int parse(const std::string & f);
   // The name of the file being parsed.
   std::string file;
 
+  /** Loads the whole input into a buffer that the scanner works on in
+   *  place, so tokens can refer to the input without being copied.
+   *  Regular files are memory-mapped (unless disabled with
+   *  set_mmap_input), other inputs such as stdin are read into memory.
+   */
   void scan_begin();
+  /** Releases the input, does nothing if no scan is open */
   void scan_end();
 
+  /** Set whether regular files are memory-mapped (the default) or read
+   *  into memory. Mapping avoids copying the input, but the file must not
+   *  be truncated while it is parsed.
+   *  @param b true to memory-map regular files
+   */
+  void set_mmap_input(bool b) { mmap_input_ = b; }
+
   /* Override-able functions corresponding to SMT-LIB commands */
 
   virtual void set_logic(const std::string & logic);
@@ -189,7 +206,7 @@ class SmtLibReader
    *  with that name
    *  @return term
    */
-  smt::Term lookup_symbol(const std::string & sym);
+  smt::Term lookup_symbol(std::string_view sym);
 
   /** Creates a new symbol
    *  This is a light wrapper around solver_->make_symbol
@@ -205,7 +222,7 @@ class SmtLibReader
    *  @return the associated PrimOp
    *  Returns NUM_OPS_AND_NULL if there's no match
    */
-  PrimOp lookup_primop(const std::string & str);
+  PrimOp lookup_primop(std::string_view str);
 
   /** Look up a sort by string
    *  The available sorts are based on the logic
@@ -214,7 +231,7 @@ class SmtLibReader
    *  Returns NUM_SORT_KINDS (a null element) if there's
    *  no match
    */
-  smt::SortKind lookup_sortkind(const std::string & str);
+  smt::SortKind lookup_sortkind(std::string_view str);
 
   /** Create a define-fun macro
    *  @param name the name of the define-fun
@@ -263,7 +280,7 @@ class SmtLibReader
    *  @param name the name to look up
    *  @return the sort
    */
-  smt::Sort lookup_sort(const std::string & name);
+  smt::Sort lookup_sort(std::string_view name);
 
   /** Creates a parameter and stores it in the scoped data-structure
    *  arg_param_map_
@@ -341,6 +358,27 @@ class SmtLibReader
 
   // useful constants
   std::string def_arg_prefix_;  ///< the prefix for renamed define-fun arguments
+
+  // input of the scanner, see scan_begin
+  bool mmap_input_;  ///< memory-map regular files
+  char * input_;  ///< the input followed by two NUL bytes (required by flex)
+  size_t input_size_;   ///< size of the input without the NUL bytes
+  size_t mapped_size_;  ///< size of the mapping, 0 if input_ isn't mapped
+  std::vector<char> read_input_;  ///< holds the input if it isn't mapped
+  void * scan_buffer_;            ///< the flex buffer over input_
+
+  /** Copies a token into a reused string for looking it up in the maps
+   *  (heterogeneous lookup needs C++20). Only symbols that are stored,
+   *  e.g. when declared, are copied into their own strings.
+   *  @param sym the token
+   *  @return a string with the same contents, valid until the next call
+   */
+  const std::string & lookup_key(std::string_view sym)
+  {
+    lookup_key_.assign(sym.data(), sym.size());
+    return lookup_key_;
+  }
+  std::string lookup_key_;
 };
 
 }  // namespace smt
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "exceptions.h"
+#include "model.h"
 #include "result.h"
 #include "smt_defs.h"
 #include "solver_enums.h"
@@ -77,6 +78,15 @@ class AbsSmtSolver
 
   virtual Result check_sat_assuming_set(const UnorderedTermSet & assumptions);
 
+  /* Interrupt a running check_sat / check_sat_assuming call
+   * May be called from a different thread than the one checking
+   * satisfiability. The interrupted call returns an UNKNOWN result.
+   * Calling it while no check is running has no lasting effect,
+   * i.e. the next check_sat is not interrupted.
+   * Throws a NotImplementedException if the backend cannot be interrupted.
+   */
+  virtual void interrupt();
+
   /* Push contexts
    * SMTLIB: (push <num>)
    * @param num the number of contexts to push
@@ -102,6 +112,28 @@ class AbsSmtSolver
    */
   virtual Term get_value(const Term & t) const = 0;
 
+  /* Get the values of several terms at once after check_sat returns a
+   * satisfiable result
+   * SMTLIB: (get-value (<t1> ... <tn>))
+   * The default implementation calls get_value for each term. Solvers
+   * can override it to look up all values in their model in one go.
+   * @param terms the terms to get the values of
+   * @param out the value terms are appended to this vector, in order
+   */
+  virtual void get_values(const TermVec & terms, TermVec & out) const;
+
+  /* Get a snapshot of the values of symbols after check_sat returns a
+   * satisfiable result
+   * The values are extracted once (non-array values with a single call to
+   * get_values, arrays with get_array_values) and stored independently of
+   * this solver, so the Model stays valid after the solver moves on.
+   * @param symbols the symbols (or other terms) to include, of sort BOOL,
+   *        BV, INT, REAL or arrays of those
+   * @return the model
+   * throws a NotImplementedException for other sorts
+   */
+  virtual Model get_model(const TermVec & symbols) const;
+
   /* Get a map of index-value pairs for an array term after check_sat returns
    * sat
    * SMTLIB: (get-value (<t>))
@@ -250,6 +282,19 @@ class AbsSmtSolver
    */
   virtual Term make_term(const Term & val, const Sort & sort) const = 0;
 
+  /* Make a value term from a solver-independent TermValue
+   * The default implementation creates the value with make_term from a
+   * string (and Negate for negative numbers). Solvers can override it
+   * to create the value directly from the words of val.
+   * See AbsTerm::export_value for the reverse direction.
+   * @param val the value
+   * @param sort the sort to create; a BOOL value can be imported as a
+   *        (_ BitVec 1) and vice versa, and an INT value as a REAL
+   * @return a term with Sort sort and value val
+   * throws an IncorrectUsageException if val doesn't fit the sort
+   */
+  virtual Term import_value(const TermValue & val, const Sort & sort) const;
+
   /* Make a symbolic constant or function term
    * SMTLIB: (declare-fun <name> (s1 ... sn) s) where sort = s1x...xsn -> s
    * @param name the name of constant or function
@@ -320,6 +365,49 @@ class AbsSmtSolver
    */
   virtual Term make_term(const Op op, const TermVec & terms) const = 0;
 
+  /* Make many terms at once from a flat description of a DAG
+   * The terms are numbered: indices below leaves.size() refer to the
+   * leaves, and index leaves.size() + i refers to the term created for
+   * ops[i]. The children of that term are the terms at the indices
+   *   children[child_offsets[i]], ..., children[child_offsets[i+1] - 1]
+   * and must all be smaller than leaves.size() + i.
+   *
+   * The default implementation calls make_term for each op. Solvers
+   * can override it to build the whole DAG without going through the
+   * generic interface for every node.
+   *
+   * @param leaves existing terms (e.g. symbols and values) used as children
+   * @param ops the operator of each new term
+   * @param child_offsets ops.size() + 1 non-decreasing offsets into children
+   *        starting at 0 and ending at children.size()
+   * @param children the child indices of all new terms, concatenated
+   * @param out the new terms are appended to this vector, one per op
+   *
+   * throws an IncorrectUsageException if the arguments don't describe a DAG
+   */
+  virtual void make_terms(const TermVec & leaves,
+                          const std::vector<Op> & ops,
+                          const std::vector<std::size_t> & child_offsets,
+                          const std::vector<std::size_t> & children,
+                          TermVec & out) const;
+
+  /* Translate a term from another instance of the same solver with the
+   * underlying solver's own mechanism (e.g. translation between Z3
+   * contexts) instead of rebuilding it node by node.
+   * Symbols of source that occur in t are registered with this solver,
+   * i.e. they can be looked up with get_symbol afterwards.
+   * The default implementation returns a null Term.
+   * Used by TermTranslator when both solvers have the same SolverEnum.
+   *
+   * @param t a term created by source
+   * @param source the solver that created t
+   * @return the term in this solver, or a null Term if it can't be
+   *         translated natively, e.g. if source is a different kind of
+   *         solver or this solver has a different symbol with the same
+   *         name as a symbol in t
+   */
+  virtual Term translate_native(const Term & t, const AbsSmtSolver & source);
+
   /* Return the solver to it's startup state
    * WARNING: This destroys all created terms and sorts
    * SMTLIB: (reset)
@@ -459,6 +547,23 @@ class AbsSmtSolver
   SolverEnum get_solver_enum() { return solver_enum; };
 
  protected:
+  /* Checks the arguments to make_terms (see above)
+   * throws an IncorrectUsageException if they don't describe a DAG
+   */
+  static void check_make_terms_args(
+      std::size_t num_leaves,
+      const std::vector<Op> & ops,
+      const std::vector<std::size_t> & child_offsets,
+      const std::vector<std::size_t> & children);
+
+  /* Converts a value for import_value to the SortKind of sort
+   * i.e. BOOL <-> (_ BitVec 1), INT -> REAL, and REAL -> INT for
+   * integral values
+   * throws an IncorrectUsageException if the value doesn't fit the sort
+   */
+  static TermValue cast_value_for_import(const TermValue & val,
+                                         const Sort & sort);
+
   SolverEnum solver_enum;  ///< an enum identifying the underlying solver
 };
 
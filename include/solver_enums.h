@@ -74,7 +74,11 @@ enum SolverAttribute
   // aliases booleans and bit-vectors of size one
   BOOL_BV1_ALIASING,
   // supports setting a time limit
-  TIMELIMIT
+  TIMELIMIT,
+  // supports interrupting a running check with interrupt()
+  INTERRUPT,
+  // supports limiting the solver-specific resources of each check
+  RESOURCELIMIT
 
   // TODO: when adding a new enum, also add to python interface in enums_dec.pxi
   // and enums_imp.pxi
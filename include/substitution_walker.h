@@ -27,6 +27,7 @@ class SubstitutionWalker : public IdentityWalker
 {
  public:
   SubstitutionWalker(const smt::SmtSolver & solver,
-                     const smt::UnorderedTermMap & smap);
+                     const smt::UnorderedTermMap & smap,
+                     CacheKind cache_kind = HASH_CACHE);
 };
 }  // namespace smt
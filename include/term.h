@@ -28,6 +28,7 @@
 #include "smt_defs.h"
 #include "sort.h"
 #include "exceptions.h"
+#include "term_value.h"
 
 namespace smt {
 
@@ -76,6 +77,24 @@ class AbsTerm
    *  ends iteration through Term's children
    */
   virtual TermIter end() = 0;
+  /** returns the number of children
+   *  i.e. the number of terms between begin() and end()
+   *  the default implementation iterates, backends override it
+   *  to query the underlying solver directly
+   */
+  virtual std::size_t num_children();
+  /** get a single child without constructing iterators
+   *  throws an IncorrectUsageException if i is out of range
+   *  @param i the index of the child, must be less than num_children()
+   *  @return the i-th child (same order as begin()/end())
+   */
+  virtual Term get_child(std::size_t i);
+  /** appends all children to out in order
+   *  this is equivalent to out.insert(out.end(), begin(), end())
+   *  but without the overhead of the abstract iterators
+   *  @param out the vector to add children to
+   */
+  virtual void get_children(std::vector<Term> & out);
 
   // Methods used for strange edge-cases e.g. in the logging solver
 
@@ -97,6 +116,17 @@ class AbsTerm
    *  throws an exception if the term is not a value
    */
   virtual std::string print_value_as(SortKind sk) = 0;
+
+  /** Export a value term to a solver-independent TermValue
+   *  Supports boolean, bit-vector, integer and real values.
+   *  The default implementation returns false. Solvers override it
+   *  to read the value directly from their own representation.
+   *  See AbsSmtSolver::import_value for the reverse direction.
+   *
+   *  @param out set to the value if this returns true
+   *  @return true iff the term is a value that could be exported
+   */
+  virtual bool export_value(TermValue & out);
 };
 
 inline bool operator==(const Term & t1, const Term & t2)
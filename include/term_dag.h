@@ -0,0 +1,136 @@
+/*********************                                                        */
+/*! \file term_dag.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A flat snapshot of a term DAG for repeated analyses.
+**
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "smt.h"
+#include "term_id_map.h"
+
+namespace smt {
+
+/** \class TermDag
+ *  A snapshot of the DAG below a set of root terms, stored in
+ *  compressed-sparse-row form.
+ *
+ *  Every distinct subterm is a node with an index. Nodes are in
+ *  topological order: the children of a node always have smaller
+ *  indices. The children of node i are
+ *    children_begin(i), ..., children_end(i)
+ *  and the op, sort and kind of every node are stored in flat arrays.
+ *
+ *  The DAG is traversed through the terms only once, when the roots are
+ *  added. Analyses over the snapshot (see the TermDag overloads in
+ *  utils.h) are then plain loops over arrays, without virtual calls
+ *  or hashing.
+ *
+ *  The snapshot does not change if the solver creates new terms, but more
+ *  roots can be added at any time.
+ */
+class TermDag
+{
+ public:
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  TermDag() : child_offsets_({ 0 }){};
+  TermDag(const TermVec & roots);
+
+  /** add a root term and all its subterms that are not in the DAG yet
+   *  @param root the term to add
+   *  @return the index of root
+   */
+  std::size_t add_root(const Term & root);
+
+  void add_roots(const TermVec & roots);
+
+  /** @return the indices of the roots, in the order they were added */
+  const std::vector<std::size_t> & get_roots() const { return roots_; };
+
+  /** @return the number of nodes */
+  std::size_t size() const { return terms_.size(); };
+
+  /** @return the index of a term or npos if it's not in the DAG */
+  std::size_t find(const Term & t) const;
+
+  const Term & get_term(std::size_t i) const { return terms_[i]; };
+  const Op & get_op(std::size_t i) const { return ops_[i]; };
+  const Sort & get_sort(std::size_t i) const { return sorts_[sort_ids_[i]]; };
+
+  /** Sorts are numbered in the order they are first seen
+   *  @return the id of the sort of node i
+   */
+  std::size_t get_sort_id(std::size_t i) const { return sort_ids_[i]; };
+  /** @return the number of distinct sorts */
+  std::size_t num_sorts() const { return sorts_.size(); };
+
+  std::size_t num_children(std::size_t i) const
+  {
+    return child_offsets_[i + 1] - child_offsets_[i];
+  };
+  const std::size_t * children_begin(std::size_t i) const
+  {
+    return children_.data() + child_offsets_[i];
+  };
+  const std::size_t * children_end(std::size_t i) const
+  {
+    return children_.data() + child_offsets_[i + 1];
+  };
+
+  bool is_symbol(std::size_t i) const { return flags_[i] & SYMBOL; };
+  bool is_symbolic_const(std::size_t i) const
+  {
+    return flags_[i] & SYMBOLIC_CONST;
+  };
+  bool is_param(std::size_t i) const { return flags_[i] & PARAM; };
+  bool is_value(std::size_t i) const { return flags_[i] & VALUE; };
+
+  /** marks the cone of influence of a set of nodes
+   *  i.e. the nodes and all nodes below them
+   *  @param nodes the indices of the nodes
+   *  @param in_cone set to a vector of size() flags
+   */
+  void get_cone(const std::vector<std::size_t> & nodes,
+                std::vector<bool> & in_cone) const;
+
+ protected:
+  enum NodeFlags : uint8_t
+  {
+    SYMBOL = 1,
+    SYMBOLIC_CONST = 2,
+    PARAM = 4,
+    VALUE = 8
+  };
+
+  /** appends a node whose children are already in the DAG */
+  std::size_t add_node(const Term & t, const TermVec & children);
+
+  TermVec terms_;
+  std::vector<Op> ops_;
+  std::vector<uint32_t> sort_ids_;
+  std::vector<uint8_t> flags_;
+  std::vector<std::size_t> child_offsets_;  ///< size() + 1 entries
+  std::vector<std::size_t> children_;
+  std::vector<std::size_t> roots_;
+
+  SortVec sorts_;
+  std::unordered_map<Sort, uint32_t> sort_index_;
+  TermIdMap<std::size_t> index_;
+};
+
+}  // namespace smt
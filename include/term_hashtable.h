@@ -17,7 +17,7 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <vector>
 
 #include "smt_defs.h"
 #include "term.h"
@@ -25,8 +25,10 @@
 namespace smt {
 
 /** \class TermHashTable
- *  A very straightforward implementation of a Term hash table
- *  using a std::unordered_map and UnorderedTermSet
+ *  An open-addressing hash table for Terms
+ *  Entries are stored in a flat array of (hash, Term) slots with
+ *  linear probing, so a lookup is a single probe sequence and the
+ *  cached hash avoids calling compare on most mismatches.
  *  The primary use of this is for hash-consing in LoggingSolver
  */
 class TermHashTable
@@ -45,11 +47,97 @@ class TermHashTable
    *  @return true iff the term was found in the hash table
    */
   bool lookup(Term & t);
+  /** lookup a term and insert it if it's not already in the table
+   *  this only hashes the term once and probes the table once
+   *  @param t the term to look up -- if an equivalent term is already
+   *         in the table, t is reassigned to that term
+   *  @return true iff the term was already in the hash table
+   *          false iff t was inserted
+   */
+  bool find_or_insert(Term & t);
   void erase(const Term & t);
   void clear();
+  /** @return the number of terms in the table */
+  size_t size() const { return num_elements; };
 
  protected:
-  std::unordered_map<std::size_t, UnorderedTermSet> table;
+  struct Slot
+  {
+    std::size_t hashval;
+    Term term;  ///< null iff the slot is empty
+
+    bool occupied() const { return (bool)term; }
+    void reset() { term = nullptr; }
+  };
+
+  /** find the slot for a term with the given hash
+   *  @param t the term to look for
+   *  @param hashval the (already computed) hash of t
+   *  @return the index of the slot containing a term equal to t
+   *          or of the empty slot where it would be inserted
+   */
+  size_t find_slot(const Term & t, std::size_t hashval) const;
+
+  std::vector<Slot> slots;  ///< capacity is always zero or a power of two
+  size_t num_elements;
+};
+
+/** \class WeakTermHashTable
+ *  A variant of TermHashTable that does not own its terms
+ *  Entries only hold a weak reference, and are expected to be
+ *  removed with erase(const AbsTerm *, size_t) when the term is
+ *  destroyed. This is used for hash-consing in LoggingSolver when
+ *  terms should be garbage collected once the client drops them.
+ */
+class WeakTermHashTable
+{
+ public:
+  WeakTermHashTable();
+  ~WeakTermHashTable();
+  /** check if a term is in the table
+   *  @param the term to check
+   *  @return true iff the term is already in the table
+   */
+  bool contains(const Term & t) const;
+  /** lookup a term and insert it if it's not already in the table
+   *  @param t the term to look up -- if an equivalent live term is already
+   *         in the table, t is reassigned to that term
+   *  @return true iff the term was already in the hash table
+   *          false iff t was inserted
+   */
+  bool find_or_insert(Term & t);
+  /** remove the entry for a particular term object
+   *  meant to be called from the destructor of that term
+   *  @param t pointer to the term (compared by identity)
+   *  @param hashval the hash of t
+   */
+  void erase(const AbsTerm * t, std::size_t hashval);
+  void clear();
+  /** @return the number of (live) terms in the table */
+  size_t size() const { return num_elements; };
+  /** @return the number of terms that have been erased from the table */
+  size_t num_erased() const { return erased; };
+
+ protected:
+  struct Slot
+  {
+    std::size_t hashval;
+    const AbsTerm * ptr;  ///< null iff the slot is empty
+    std::weak_ptr<AbsTerm> term;
+
+    bool occupied() const { return ptr != nullptr; }
+    void reset()
+    {
+      ptr = nullptr;
+      term.reset();
+    }
+  };
+
+  size_t find_slot(const Term & t, std::size_t hashval) const;
+
+  std::vector<Slot> slots;  ///< capacity is always zero or a power of two
+  size_t num_elements;
+  size_t erased;
 };
 
 }  // namespace smt
@@ -0,0 +1,211 @@
+/*********************                                                        */
+/*! \file term_id_map.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A flat map keyed by term ids -- used as an alternative cache
+**        for the term walkers.
+**
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "assert.h"
+#include "term.h"
+
+namespace smt {
+
+/** \enum
+ * The cache implementation used by a walker
+ * HASH_CACHE : an UnorderedTermMap (hashes terms with AbsTerm::hash)
+ * ID_CACHE   : a TermIdMap (keyed by AbsTerm::get_id)
+ */
+enum CacheKind
+{
+  HASH_CACHE = 0,
+  ID_CACHE
+};
+
+/** \class TermIdMap
+ *  An open-addressing map from Terms to values, keyed by term id
+ *  Entries are stored in a flat array with linear probing, and the
+ *  id of each key is stored next to it. A lookup therefore only
+ *  calls get_id once and then compares integers, instead of going
+ *  through AbsTerm::hash and the buckets of an std::unordered_map.
+ *
+ *  Ids are not guaranteed to be unique across all kinds of terms
+ *  (e.g. function symbols in some backends, or GenericTerm which uses
+ *  its hash), so keys with the same id are still compared with ==
+ *  before a hit is reported.
+ */
+template <class V>
+class TermIdMap
+{
+ public:
+  TermIdMap() : num_elements(0) {}
+
+  /** @return a pointer to the value for key or nullptr if not present */
+  V * find(const Term & key)
+  {
+    if (!num_elements)
+    {
+      return nullptr;
+    }
+    Slot & s = slots[find_slot(key, key->get_id())];
+    return s.occupied() ? &s.val : nullptr;
+  }
+
+  const V * find(const Term & key) const
+  {
+    return const_cast<TermIdMap *>(this)->find(key);
+  }
+
+  bool contains(const Term & key) const { return find(key) != nullptr; }
+
+  /** insert a mapping if key is not already present
+   *  @param key the key term
+   *  @param val the value
+   *  @return true iff the mapping was inserted
+   *          (existing mappings are not overwritten)
+   */
+  bool insert(const Term & key, const V & val)
+  {
+    Slot & s = get_slot(key);
+    if (s.occupied())
+    {
+      return false;
+    }
+    s.key = key;
+    s.val = val;
+    num_elements++;
+    return true;
+  }
+
+  /** @return a reference to the value for key,
+   *          default-constructing it if not present
+   */
+  V & operator[](const Term & key)
+  {
+    Slot & s = get_slot(key);
+    if (!s.occupied())
+    {
+      s.key = key;
+      num_elements++;
+    }
+    return s.val;
+  }
+
+  /** removes all mappings but keeps the allocated capacity */
+  void clear()
+  {
+    if (!num_elements)
+    {
+      return;
+    }
+    for (auto & s : slots)
+    {
+      if (s.occupied())
+      {
+        s = Slot();
+      }
+    }
+    num_elements = 0;
+  }
+
+  std::size_t size() const { return num_elements; }
+
+  bool empty() const { return num_elements == 0; }
+
+ protected:
+  struct Slot
+  {
+    std::size_t id;
+    Term key;  ///< null iff the slot is empty
+    V val;
+
+    bool occupied() const { return (bool)key; }
+  };
+
+  static std::size_t home_slot(std::size_t id, std::size_t capacity)
+  {
+    // ids are often sequential -- mix the bits so that
+    // neighboring ids don't end up in one long probe sequence
+    uint64_t h = id;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h & (capacity - 1);
+  }
+
+  /** @return the index of the slot holding key
+   *          or of the empty slot where it would be inserted
+   */
+  std::size_t find_slot(const Term & key, std::size_t id) const
+  {
+    assert(!slots.empty());
+    std::size_t mask = slots.size() - 1;
+    std::size_t idx = home_slot(id, slots.size());
+    while (slots[idx].occupied())
+    {
+      const Slot & s = slots[idx];
+      if (s.id == id && (s.key.get() == key.get() || s.key == key))
+      {
+        break;
+      }
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+
+  /** finds the slot for key, growing the table first if inserting
+   *  one more element would exceed the maximum load factor of 3/4
+   *  the id of the returned slot is always set
+   */
+  Slot & get_slot(const Term & key)
+  {
+    if (4 * (num_elements + 1) > 3 * slots.size())
+    {
+      rehash(slots.empty() ? 64 : 2 * slots.size());
+    }
+    std::size_t id = key->get_id();
+    Slot & s = slots[find_slot(key, id)];
+    s.id = id;
+    return s;
+  }
+
+  void rehash(std::size_t new_capacity)
+  {
+    assert((new_capacity & (new_capacity - 1)) == 0);
+    std::vector<Slot> old_slots(new_capacity);
+    old_slots.swap(slots);
+    std::size_t mask = new_capacity - 1;
+    for (auto & s : old_slots)
+    {
+      if (s.occupied())
+      {
+        // all keys are distinct, so only need to find an empty slot
+        std::size_t idx = home_slot(s.id, new_capacity);
+        while (slots[idx].occupied())
+        {
+          idx = (idx + 1) & mask;
+        }
+        slots[idx] = std::move(s);
+      }
+    }
+  }
+
+  std::vector<Slot> slots;  ///< capacity is always zero or a power of two
+  std::size_t num_elements;
+};
+
+}  // namespace smt
@@ -58,7 +58,7 @@ namespace smt {
 class TermTranslator
 {
  public:
-  TermTranslator(const SmtSolver & s) : solver(s)
+  TermTranslator(const SmtSolver & s) : solver(s), num_native_entries(0)
   {
     // Generic solvers don't support
     // term transfer
@@ -67,6 +67,25 @@ class TermTranslator
       throw SmtException("Generic Solvers do not support term transfer");
     }
   }
+
+  /** Constructor that also takes the solver terms are translated from
+   *  If both solvers have the same SolverEnum, terms are translated with
+   *  the solver's native mechanism where possible (see
+   *  AbsSmtSolver::translate_native), which avoids rebuilding the term
+   *  node by node. Otherwise, or once the cache contains mappings that
+   *  weren't created by a native translation (e.g. symbols populated by
+   *  the user), it behaves like the other constructor.
+   *  @param s the solver to translate terms to
+   *  @param from the solver to translate terms from
+   */
+  TermTranslator(const SmtSolver & s, const SmtSolver & from)
+      : TermTranslator(s)
+  {
+    if (from->get_solver_enum() == s->get_solver_enum())
+    {
+      source_solver = from;
+    }
+  }
   /** Transfers a sort from the other solver to this solver
    *  @param the sort transfer
    *  @return a sort belonging to this solver
@@ -79,6 +98,15 @@ class TermTranslator
    */
   Term transfer_term(const Term & term);
 
+  /** Transfers several terms from the other solver to this solver
+   *  All the roots are translated in one traversal, so shared subterms
+   *  are only looked up once, and the traversal buffers are reused
+   *  across calls.
+   *  @param terms the terms to transfer
+   *  @return the transferred terms, in the same order
+   */
+  TermVec transfer_terms(const TermVec & terms);
+
   /** Transfers a term and casts it to a particular SortKind
    *  for now, only supports Bool <-> BV1 and Int <-> Real
    *  will throw an exception if something else is requested
@@ -88,6 +116,19 @@ class TermTranslator
    */
   Term transfer_term(const Term & term, const SortKind sk);
 
+  /** Statistics about a single call to transfer_term(s) */
+  struct Stats
+  {
+    Stats() : cache_hits(0), nodes_created(0){};
+    /** number of terms (roots or children) found in the cache */
+    std::size_t cache_hits;
+    /** number of terms translated (i.e. added to the cache) */
+    std::size_t nodes_created;
+  };
+
+  /* Returns the statistics of the most recent call to transfer_term(s) */
+  const Stats & get_stats() const { return stats; };
+
   /* Returns reference to cache -- can be used to populate with symbols */
   UnorderedTermMap & get_cache() { return cache; };
 
@@ -95,6 +136,28 @@ class TermTranslator
   const SmtSolver & get_solver() { return solver; };
 
  protected:
+  /** Translates a term with solver->translate_native
+   *  only possible if the solvers have the same SolverEnum and the cache
+   *  only contains results of earlier native translations
+   *  @param term the term to transfer
+   *  @return the term in this solver or a null Term if not possible
+   */
+  Term transfer_native(const Term & term);
+
+  /** Translates the terms in to_visit (and their subterms) into the cache
+   *  the roots are expected to be on top of to_visit in reverse order
+   */
+  void transfer_to_visit();
+
+  /** Transfers a (non-array) value term
+   *  Goes through a TermValue if the term can export its value, which
+   *  avoids printing and parsing strings, and falls back to
+   *  value_from_smt2 otherwise
+   *  @param val the value term from the other solver
+   *  @return the value in this solver
+   */
+  Term transfer_value(const Term & val);
+
   /** Creates a term value from a string of the given sort
    *  @param val the string representation of the value
    *  @param orig_sort the sort from the original solver (transfer_sort is
@@ -154,6 +217,20 @@ class TermTranslator
   // necessary because it needs to be the same exact uninterpreted sort
   // cannot recreate it with the same name and get the same object back
   std::unordered_map<std::string, Sort> uninterpreted_sorts;
+
+  // scratch buffers for the traversal in transfer_to_visit
+  // kept as members so that they are only allocated once
+  TermVec to_visit;
+  UnorderedTermSet visited;
+  TermVec children;
+  TermVec cached_children;
+
+  Stats stats;  ///< statistics of the most recent call
+
+  // set only if it has the same SolverEnum as solver
+  SmtSolver source_solver;
+  // the number of cache entries created by native translation
+  std::size_t num_native_entries;
 };
 }  // namespace smt
 
@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file term_value.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A solver-independent representation of value terms.
+**
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "sort.h"
+
+namespace smt {
+
+/** \struct TermValue
+ *  A solver-independent representation of a boolean, bit-vector,
+ *  integer or real value.
+ *
+ *  Numbers are stored as vectors of 64-bit words, least significant
+ *  word first (like GMP limbs), so that solvers can export and import
+ *  values directly from their internal representation. See
+ *  AbsTerm::export_value and AbsSmtSolver::import_value.
+ *
+ *  Invariants:
+ *   BOOL : num is empty (false) or { 1 } (true)
+ *   BV   : num has exactly (width + 63) / 64 words and the bits above
+ *          width are zero
+ *   INT  : num is the magnitude without leading zero words
+ *          (zero is the empty vector and is never negative)
+ *   REAL : like INT, and den is the non-zero denominator
+ *          (1 for integral values), in lowest terms so equal values
+ *          are represented the same way (make_real reduces)
+ */
+struct TermValue
+{
+  TermValue() : kind(NUM_SORT_KINDS), width(0), negative(false){};
+
+  static TermValue make_bool(bool b);
+  static TermValue make_bv(uint64_t width, uint64_t val);
+  /** @param words least significant word first, truncated to width */
+  static TermValue make_bv(uint64_t width,
+                           const std::vector<uint64_t> & words);
+  static TermValue make_int(int64_t i);
+  static TermValue make_int(bool negative,
+                            const std::vector<uint64_t> & magnitude);
+  static TermValue make_real(int64_t num, uint64_t den);
+  static TermValue make_real(bool negative,
+                             const std::vector<uint64_t> & num,
+                             const std::vector<uint64_t> & den);
+
+  /** Parses a value printed by a solver or in SMT-LIB format
+   *  Accepts true / false, #b / #x / (_ bvN w) bit-vectors,
+   *  decimal integers and decimals, a/b and (/ a b) fractions, with
+   *  a leading - or (- ...) for negative numbers.
+   *  A 1-bit bit-vector can be read as a BOOL and vice versa.
+   *  @param s the string to parse
+   *  @param sk the kind of the value, one of BOOL, BV, INT or REAL
+   *  @param width the width of a bit-vector value
+   *  @return the value
+   *  throws an IncorrectUsageException if s can't be read
+   */
+  static TermValue from_string(const std::string & s,
+                               SortKind sk,
+                               uint64_t width = 0);
+
+  bool is_null() const { return kind == NUM_SORT_KINDS; };
+
+  /** @return the value of a BOOL or 1-bit BV value */
+  bool get_bool() const { return get_uint64() != 0; };
+
+  /** @return true iff num fits in a single word */
+  bool num_fits_uint64() const { return num.size() <= 1; };
+  /** @return true iff the (signed) numerator fits in an int64_t */
+  bool num_fits_int64() const;
+  /** @return true iff den fits in an int64_t */
+  bool den_fits_int64() const;
+
+  /** @return the lowest word of num */
+  uint64_t get_uint64() const { return num.empty() ? 0 : num[0]; };
+  /** @return the signed numerator, assumes num_fits_int64 */
+  int64_t get_int64() const;
+  /** @return the denominator, assumes den_fits_int64 */
+  int64_t get_den_int64() const;
+
+  /** @param base 2, 10 or 16
+   *  @return the digits of num (without a sign)
+   *          BV values are padded to width digits in base 2
+   */
+  std::string num_to_string(int base = 10) const;
+  /** @return the decimal digits of den */
+  std::string den_to_string() const;
+
+  /** @return the SMT-LIB representation of the value */
+  std::string to_string() const;
+
+  size_t hash() const;
+
+  SortKind kind;
+  uint64_t width;  ///< the bit-width of BV values
+  bool negative;   ///< the sign of INT and REAL values
+  std::vector<uint64_t> num;
+  std::vector<uint64_t> den;
+};
+
+bool operator==(const TermValue & v1, const TermValue & v2);
+bool operator!=(const TermValue & v1, const TermValue & v2);
+std::ostream & operator<<(std::ostream & output, const TermValue & v);
+
+}  // namespace smt
+
+namespace std {
+
+template <>
+struct hash<smt::TermValue>
+{
+  size_t operator()(const smt::TermValue & v) const { return v.hash(); }
+};
+
+}  // namespace std
@@ -0,0 +1,170 @@
+/*********************                                                        */
+/*! \file trace_recorder.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Records spans of solver activity as Chrome trace events, which
+**        can be viewed with chrome://tracing or Perfetto.
+**
+**/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solver_enums.h"
+
+namespace smt {
+
+/** A completed span, see TraceRecorder */
+struct TraceEvent
+{
+  const char * name;      ///< must be a string with static storage
+  const char * category;  ///< must be a string with static storage
+  SolverEnum solver;
+  int64_t arg;  ///< an extra integer, e.g. a solver index, -1 for none
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+};
+
+/** \class TraceRecorder
+ *  Writes spans of solver activity to a file in the Chrome trace-event
+ *  JSON format. Spans are recorded by InstrumentedSolver for every solver
+ *  call, by TermTranslator for transfers and by PortfolioSolver for its
+ *  worker threads, but only while the recorder is started.
+ *
+ *  Each thread appends its spans to its own lock-free ring buffer,
+ *  and a background thread periodically writes them to the file, so
+ *  recording a span never blocks and never does I/O. If a ring is full,
+ *  spans are dropped and counted, see get_num_dropped.
+ *
+ *  Thread-safe.
+ */
+class TraceRecorder
+{
+ public:
+  /** @return the recorder shared by the whole process */
+  static TraceRecorder & get();
+
+  ~TraceRecorder();
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder & operator=(const TraceRecorder &) = delete;
+
+  /** Start recording to a file, it is overwritten
+   *  throws an IncorrectUsageException if already started or the file
+   *  can't be opened
+   *  @param filename the file to write the trace to
+   */
+  void start(const std::string & filename);
+
+  /** Stop recording, write the remaining spans and close the file
+   *  Does nothing if not started.
+   */
+  void stop();
+
+  /** @return true iff spans are being recorded */
+  bool is_started() const { return started.load(std::memory_order_relaxed); };
+
+  /** Record a span of the calling thread, dropped if not started */
+  void record(const TraceEvent & e);
+
+  /** @return the number of spans dropped because a ring was full,
+   *  since the last start
+   */
+  uint64_t get_num_dropped() const { return num_dropped; };
+
+ protected:
+  struct ThreadBuffer;
+
+  TraceRecorder();
+
+  /** @return the ring of the calling thread, registered on first use */
+  ThreadBuffer & thread_buffer();
+
+  /** Write all recorded spans to the file, called with write_mutex held */
+  void flush();
+
+  /** Body of the background thread writing the spans */
+  void run();
+
+  std::atomic<bool> started;
+  std::atomic<uint64_t> num_dropped;
+  std::chrono::steady_clock::time_point origin;  ///< timestamp 0
+
+  // buffers of all threads that recorded spans, kept until their
+  // thread has exited and they have been flushed
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::mutex buffers_mutex;
+  uint64_t next_tid;
+
+  std::ofstream out;
+  bool first_event;
+  std::mutex write_mutex;  ///< protects out and the flushing of the rings
+
+  bool stop_writer;
+  std::condition_variable cv;
+  std::thread writer;
+};
+
+/** \class TraceSpan
+ *  Records a span from its construction to its destruction
+ *  (only if the TraceRecorder was started at construction).
+ */
+class TraceSpan
+{
+ public:
+  /** @param name the name of the span, with static storage
+   *  @param category the category of the span, with static storage
+   *  @param solver the solver the span is attributed to
+   *  @param arg an extra integer to display, -1 for none
+   */
+  TraceSpan(const char * name,
+            const char * category,
+            SolverEnum solver,
+            int64_t arg = -1)
+      : active(TraceRecorder::get().is_started())
+  {
+    if (active)
+    {
+      event = { name,
+                category,
+                solver,
+                arg,
+                std::chrono::steady_clock::now(),
+                std::chrono::steady_clock::time_point() };
+    }
+  };
+
+  ~TraceSpan()
+  {
+    if (active)
+    {
+      event.end = std::chrono::steady_clock::now();
+      TraceRecorder::get().record(event);
+    }
+  };
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan & operator=(const TraceSpan &) = delete;
+
+ private:
+  bool active;
+  TraceEvent event;
+};
+
+}  // namespace smt
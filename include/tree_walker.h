@@ -18,10 +18,12 @@
 
 #pragma once
 
+#include <limits>
 #include <utility>
 
 #include "exceptions.h"
 #include "smt.h"
+#include "term_id_map.h"
 
 namespace smt {
 /* vector of pairs holding terms and ints that gets used within visit in the
@@ -41,6 +43,19 @@ using TermPairVec = std::vector<std::pair<Term, int>>;
 using UnorderedTermPairMap =
     std::unordered_map<Term, std::pair<Term, std::vector<int>>>;
 
+/** \enum
+ * How the internal cache of a TreeWalker stores paths
+ * FULL_PATHS    : every cache entry holds its own copy of the path
+ * COMPACT_PATHS : cache entries refer to an occurrence in a shared table
+ *                 of (parent occurrence, child number) links, and paths are
+ *                 only materialized when the cache is queried
+ */
+enum TreePathMode
+{
+  FULL_PATHS = 0,
+  COMPACT_PATHS
+};
+
 /** \enum
  * Walker_Continue : rebuild the current term and continue
  * Walker_Skip     : skip this term and all subterms
@@ -64,6 +79,14 @@ enum TreeWalkerStepResult
  * The user can optionally pass a pointer to a cache. If that pointer
  * is non-null, it will be used in place of the internal cache.
  *
+ * Alternatively, the internal cache can be keyed by term id (ID_CACHE)
+ * instead of the term hash (HASH_CACHE, the default).
+ *
+ * Storing a full path per cached term is quadratic in the depth of the
+ * formula. With COMPACT_PATHS, the walker instead records each occurrence
+ * it visits as a link to its parent occurrence and the cache only stores
+ * the index of an occurrence. visit_term still receives the full path.
+ *
  * Important Note: The term arguments should belong to the solver provided
  */
 
@@ -73,7 +96,27 @@ class TreeWalker
   TreeWalker(const smt::SmtSolver & solver,
              bool clear_cache,
              smt::UnorderedTermPairMap * ext_cache = nullptr)
-      : solver_(solver), clear_cache_(clear_cache), ext_cache_(ext_cache){};
+      : solver_(solver),
+        clear_cache_(clear_cache),
+        cache_kind_(HASH_CACHE),
+        ext_cache_(ext_cache),
+        path_mode_(FULL_PATHS){};
+
+  /** Create a walker with an internal cache of the given kind
+   *  @param solver the solver to use for rebuilding terms
+   *  @param clear_cache if true, clears the cache between calls to visit
+   *  @param cache_kind the internal cache to use (HASH_CACHE or ID_CACHE)
+   *  @param path_mode how the internal cache stores paths
+   */
+  TreeWalker(const smt::SmtSolver & solver,
+             bool clear_cache,
+             CacheKind cache_kind,
+             TreePathMode path_mode = FULL_PATHS)
+      : solver_(solver),
+        clear_cache_(clear_cache),
+        cache_kind_(cache_kind),
+        ext_cache_(nullptr),
+        path_mode_(path_mode){};
 
   /** Visit a term and all its subterms in a post-order traversal
    *  @param term the term to visit
@@ -139,14 +182,73 @@ class TreeWalker
   void save_in_cache(const Term & key,
                      const std::pair<Term, std::vector<int>> & val);
 
+  /** Populate the cache with the occurrence currently being visited
+   *  This is equivalent to save_in_cache(key, { formula, path }) with the
+   *  arguments of visit_term, but doesn't copy the path in COMPACT_PATHS mode
+   *  @param key the key term
+   */
+  void save_current_occurrence_in_cache(const Term & key);
+
   const smt::SmtSolver & solver_; /**< the solver to use for rebuilding terms */
   bool clear_cache_; /**< if true, clears the cache between calls to visit */
 
  private:
   // derived classes should interact with cache through the methods above only
+  CacheKind cache_kind_;                  /**< which internal cache is used */
   smt::UnorderedTermPairMap cache_;       /**< cache for updating terms */
+  smt::TermIdMap<std::pair<Term, std::vector<int>>>
+      id_cache_; /**< cache used instead of cache_ if cache_kind_ is ID_CACHE */
   smt::UnorderedTermPairMap * ext_cache_; /**< external (user-provided) cache.
                                          If non-null, used instead of cache_ */
+
+  /* used for COMPACT_PATHS */
+
+  static constexpr std::size_t no_parent =
+      std::numeric_limits<std::size_t>::max();
+
+  struct Occurrence
+  {
+    std::size_t parent;  ///< index of the parent occurrence or no_parent
+    int child_no;        ///< child number relative to the parent
+  };
+
+  struct CompactEntry
+  {
+    Term formula;           ///< topmost node of the formula
+    std::size_t occurrence; ///< index in occurrences_
+  };
+
+  bool compact() const { return !ext_cache_ && path_mode_ == COMPACT_PATHS; }
+
+  /** adds the occurrences for a path, starting from a new root
+   *  @return the index of the last occurrence
+   */
+  std::size_t add_path(const std::vector<int> & path);
+
+  /** reconstructs the path of an occurrence
+   *  @param occurrence the index of the occurrence
+   *  @param out the vector to store the path in (overwritten)
+   */
+  void get_path(std::size_t occurrence, std::vector<int> & out) const;
+
+  void save_compact_entry(const Term & key, const CompactEntry & entry);
+
+  TreePathMode path_mode_; /**< how paths are stored in the internal cache */
+  std::vector<Occurrence> occurrences_; /**< table of visited occurrences */
+  /** occurrences_ is truncated to this size after each call to visit
+   *  (one past the largest occurrence referenced by a cache entry)
+   */
+  std::size_t num_referenced_occurrences_ = 0;
+  std::unordered_map<Term, CompactEntry>
+      compact_cache_; /**< used instead of cache_ with COMPACT_PATHS */
+  smt::TermIdMap<CompactEntry>
+      compact_id_cache_; /**< used instead of id_cache_ with COMPACT_PATHS */
+
+  // the occurrence currently being visited, with the arguments
+  // visit_term was called with
+  std::size_t current_occurrence_ = no_parent;
+  const Term * current_formula_ = nullptr;
+  const std::vector<int> * current_path_ = nullptr;
 };
 
 }  // namespace smt
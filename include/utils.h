@@ -22,6 +22,7 @@
 
 #include "assert.h"
 #include "smt.h"
+#include "term_dag.h"
 
 #ifndef NDEBUG
 #define _ASSERTIONS
@@ -90,6 +91,49 @@ void get_free_symbols(const smt::Term & term, smt::UnorderedTermSet & out);
 
 void get_ops(const smt::Term & term, smt::UnorderedOpSet & out);
 
+// versions of the helpers above over a TermDag snapshot
+// these don't go through the terms and are much faster when
+// running several analyses over the same (large) DAG
+
+/** Populates a vector with the partition of node root of dag
+ *  see op_partition
+ */
+void op_partition(smt::PrimOp o,
+                  const TermDag & dag,
+                  std::size_t root,
+                  smt::TermVec & out);
+
+void conjunctive_partition(const TermDag & dag,
+                           std::size_t root,
+                           smt::TermVec & out,
+                           bool include_bvand = false);
+
+void disjunctive_partition(const TermDag & dag,
+                           std::size_t root,
+                           smt::TermVec & out,
+                           bool include_bvor = false);
+
+/** Populates a set with the terms below node root of dag
+ *  that satisfy matching_fun (which is given the node index)
+ *  like get_matching_terms, does not look below matched terms
+ */
+void get_matching_terms(const TermDag & dag,
+                        std::size_t root,
+                        smt::UnorderedTermSet & out,
+                        bool (*matching_fun)(const TermDag & dag,
+                                             std::size_t i));
+
+/** The following collect from all nodes of the dag
+ *  To restrict them to some roots, build a TermDag from those roots
+ *  or use TermDag::get_cone
+ */
+void get_free_symbolic_consts(const TermDag & dag,
+                              smt::UnorderedTermSet & out);
+
+void get_free_symbols(const TermDag & dag, smt::UnorderedTermSet & out);
+
+void get_ops(const TermDag & dag, smt::UnorderedOpSet & out);
+
 /** returns true iff l is a literal
  *  e.g. either a boolean symbolic constant or its negation
  *  NOTE will return false for nested negations, i.e. (not (not (not l)))
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -27,6 +28,7 @@
 
 #include "mathsat.h"
 
+#include "deadline_timer.h"
 #include "exceptions.h"
 #include "ops.h"
 #include "result.h"
@@ -64,6 +66,7 @@ class MsatSolver : public AbsSmtSolver
   MsatSolver & operator=(const MsatSolver &) = delete;
   ~MsatSolver()
   {
+    DeadlineTimer::get().cancel(timelimit_id);
     // Note: even with this, mathsat leaks
     // a program that just creates a msat_env leaks
     //  -- be careful, valgrind won't report leaks on statically compiled
@@ -81,10 +84,12 @@ class MsatSolver : public AbsSmtSolver
   Result check_sat_assuming(const TermVec & assumptions) override;
   Result check_sat_assuming_list(const TermList & assumptions) override;
   Result check_sat_assuming_set(const UnorderedTermSet & assumptions) override;
+  void interrupt() override;
   void push(uint64_t num = 1) override;
   void pop(uint64_t num = 1) override;
   uint64_t get_context_level() const override;
   Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
   UnorderedTermMap get_array_values(const Term & arr,
                                     Term & out_const_base) const override;
   void get_unsat_assumptions(UnorderedTermSet & out) override;
@@ -175,6 +180,70 @@ class MsatSolver : public AbsSmtSolver
                                ///< get_unsat_assumptions interface (will
                                ///< complain if not called after
                                ///< check-sat-assuming).
+  std::atomic<uint64_t> num_interrupts{ 0 };    ///< calls to interrupt()
+  std::atomic<uint64_t> check_interrupts{ 0 };  ///< saved by start_check
+  uint64_t time_limit = 0;                 ///< in seconds, 0 for no limit
+  DeadlineTimer::Id timelimit_id = 0;      ///< deadline of the running query
+  std::atomic<bool> timed_out{ false };    ///< set if time limit is reached
+
+  // called first thing by every check. Interrupts from then on stop it,
+  // even if they arrive before msat_solve, earlier ones are ignored.
+  void start_check() { check_interrupts = num_interrupts.load(); }
+
+  // true iff interrupt() was called since the current check was entered
+  bool interrupted() const { return num_interrupts != check_interrupts; }
+
+  // installs the termination test used by interrupt() and time limits on
+  // the current environment
+  // called right before solving because the environment can be
+  // recreated (e.g. by reset)
+  void arm_interrupt()
+  {
+    auto terminate = [](void * state) -> int {
+      MsatSolver * solver = reinterpret_cast<MsatSolver *>(state);
+      return (solver->interrupted() || solver->timed_out) ? 1 : 0;
+    };
+    msat_set_termination_test(env, terminate, this);
+  }
+
+  // schedules a deadline for the next query (if a time limit is set)
+  void timelimit_start()
+  {
+    if (time_limit)
+    {
+      // a previous query might have thrown before timelimit_end
+      DeadlineTimer::get().cancel(timelimit_id);
+      timed_out = false;
+      timelimit_id = DeadlineTimer::get().schedule(
+          std::chrono::seconds(time_limit), [this]() { timed_out = true; });
+    }
+  }
+
+  // cancels the deadline of the last query
+  // returns true iff it was terminated due to the time limit
+  bool timelimit_end()
+  {
+    bool res = false;
+    if (time_limit)
+    {
+      // waits for the deadline callback if it is running
+      DeadlineTimer::get().cancel(timelimit_id);
+      timelimit_id = 0;
+      res = timed_out;
+      timed_out = false;
+    }
+    return res;
+  }
+
+  // result for a query that returned MSAT_UNKNOWN
+  Result unknown_result(bool tl_triggered) const
+  {
+    if (tl_triggered)
+    {
+      return Result(UNKNOWN, "Time limit reached.");
+    }
+    return interrupted() ? Result(UNKNOWN, "Interrupted.") : Result(UNKNOWN);
+  }
 
   // clears assumption clauses
   // needed to simulate the same check_sat_assuming interface as other solvers
@@ -228,8 +297,11 @@ class MsatSolver : public AbsSmtSolver
 
     assert(lbls.size() == m_assumps.size());
 
+    arm_interrupt();
+    timelimit_start();
     msat_result mres =
         msat_solve_with_assumptions(env, lbls.data(), lbls.size());
+    bool tl_triggered = timelimit_end();
 
     if (mres == MSAT_SAT)
     {
@@ -241,7 +313,7 @@ class MsatSolver : public AbsSmtSolver
     }
     else
     {
-      return Result(UNKNOWN);
+      return unknown_result(tl_triggered);
     }
   }
 };
@@ -32,7 +32,8 @@ using namespace std;
 namespace smt {
 
 const unordered_map<string, string> msat_option_map({
-         {"produce-models", "model_generation"}
+         {"produce-models", "model_generation"},
+         {"random-seed", "random_seed"}
   });
 
 /* MathSAT op mappings */
@@ -145,6 +146,13 @@ void MsatSolver::set_opt(const string option, const string value)
     return;
   }
 
+  if (option == "time-limit")
+  {
+    // enforced by smt-switch, can be changed at any time
+    time_limit = stoul(value);
+    return;
+  }
+
   if (!env_uninitialized)
   {
     throw IncorrectUsageException("Must set options before using solver.");
@@ -192,10 +200,14 @@ void MsatSolver::assert_formula(const Term & t)
 
 Result MsatSolver::check_sat()
 {
+  start_check();
   initialize_env();
   last_query_assuming = false;
   clear_assumption_clauses();
+  arm_interrupt();
+  timelimit_start();
   msat_result mres = msat_solve(env);
+  bool tl_triggered = timelimit_end();
 
   if (mres == MSAT_SAT)
   {
@@ -207,12 +219,13 @@ Result MsatSolver::check_sat()
   }
   else
   {
-    return Result(UNKNOWN);
+    return unknown_result(tl_triggered);
   }
 }
 
 Result MsatSolver::check_sat_assuming(const TermVec & assumptions)
 {
+  start_check();
   initialize_env();
   last_query_assuming = true;
   clear_assumption_clauses();
@@ -232,6 +245,7 @@ Result MsatSolver::check_sat_assuming(const TermVec & assumptions)
 
 Result MsatSolver::check_sat_assuming_list(const TermList & assumptions)
 {
+  start_check();
   initialize_env();
   clear_assumption_clauses();
   // expecting (possibly negated) boolean literals
@@ -266,6 +280,7 @@ Result MsatSolver::check_sat_assuming_list(const TermList & assumptions)
 
 Result MsatSolver::check_sat_assuming_set(const UnorderedTermSet & assumptions)
 {
+  start_check();
   initialize_env();
   clear_assumption_clauses();
   // expecting (possibly negated) boolean literals
@@ -298,6 +313,8 @@ Result MsatSolver::check_sat_assuming_set(const UnorderedTermSet & assumptions)
   return check_sat_assuming_msatvec(m_assumps);
 }
 
+void MsatSolver::interrupt() { num_interrupts++; }
+
 void MsatSolver::push(uint64_t num)
 {
   initialize_env();
@@ -321,12 +338,10 @@ uint64_t MsatSolver::get_context_level() const
   return msat_num_backtrack_points(env);
 }
 
-Term MsatSolver::get_value(const Term & t) const
+// helper for get_value and get_values
+// throws if val is the error term returned for t
+static void check_model_value(msat_term val, const Term & t)
 {
-  initialize_env();
-  shared_ptr<MsatTerm> mterm = static_pointer_cast<MsatTerm>(t);
-  msat_term val = msat_get_model_value(env, mterm->term);
-
   if (MSAT_ERROR_TERM(val))
   {
     string msg("Error getting value for ");
@@ -336,10 +351,46 @@ Term MsatSolver::get_value(const Term & t) const
         "constants in this solving environment.";
     throw IncorrectUsageException(msg);
   }
+}
 
+Term MsatSolver::get_value(const Term & t) const
+{
+  initialize_env();
+  shared_ptr<MsatTerm> mterm = static_pointer_cast<MsatTerm>(t);
+  msat_term val = msat_get_model_value(env, mterm->term);
+  check_model_value(val, t);
   return std::make_shared<MsatTerm> (env, val);
 }
 
+void MsatSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  initialize_env();
+  // build the model once instead of once per term
+  msat_model model = msat_get_model(env);
+  if (MSAT_ERROR_MODEL(model))
+  {
+    throw IncorrectUsageException(
+        "Error getting model, be sure the last check-sat call was sat.");
+  }
+  out.reserve(out.size() + terms.size());
+  try
+  {
+    for (const auto & t : terms)
+    {
+      shared_ptr<MsatTerm> mterm = static_pointer_cast<MsatTerm>(t);
+      msat_term val = msat_model_eval(model, mterm->term);
+      check_model_value(val, t);
+      out.push_back(std::make_shared<MsatTerm>(env, val));
+    }
+  }
+  catch (...)
+  {
+    msat_destroy_model(model);
+    throw;
+  }
+  msat_destroy_model(model);
+}
+
 UnorderedTermMap MsatSolver::get_array_values(const Term & arr,
                                               Term & out_const_base) const
 {
@@ -1262,6 +1313,11 @@ Term MsatInterpolatingSolver::get_value(const Term & t) const
   throw IncorrectUsageException("Can't get values from interpolating solver");
 }
 
+void MsatInterpolatingSolver::get_values(const TermVec &, TermVec &) const
+{
+  throw IncorrectUsageException("Can't get values from interpolating solver");
+}
+
 Result MsatInterpolatingSolver::get_interpolant(const Term & A,
                                                 const Term & B,
                                                 Term & out_I) const
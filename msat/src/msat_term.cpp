@@ -136,7 +136,11 @@ MsatTermIter & MsatTermIter::operator=(const MsatTermIter & it)
 
 void MsatTermIter::operator++() { pos++; }
 
-const Term MsatTermIter::operator*()
+/** Get a child as it's exposed through the smt-switch interface
+ *  shared by MsatTermIter and MsatTerm::get_child
+ *  the function of a function application is the first child
+ */
+static Term get_msat_child(msat_env env, msat_term term, uint32_t pos)
 {
   if (!pos && msat_term_is_uf(env, term))
   {
@@ -154,6 +158,8 @@ const Term MsatTermIter::operator*()
   }
 }
 
+const Term MsatTermIter::operator*() { return get_msat_child(env, term, pos); }
+
 TermIterBase * MsatTermIter::clone() const
 {
   return new MsatTermIter(env, term, pos);
@@ -615,6 +621,42 @@ TermIter MsatTerm::end()
   return TermIter(new MsatTermIter(env, term, arity));
 }
 
+size_t MsatTerm::num_children()
+{
+  if (is_uf)
+  {
+    // function symbols have no children
+    return 0;
+  }
+
+  size_t arity = msat_term_arity(term);
+  if (msat_term_is_uf(env, term))
+  {
+    // consider the function itself a child
+    arity++;
+  }
+  return arity;
+}
+
+Term MsatTerm::get_child(size_t i)
+{
+  if (i >= num_children())
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return get_msat_child(env, term, i);
+}
+
+void MsatTerm::get_children(TermVec & out)
+{
+  size_t n = num_children();
+  for (size_t i = 0; i < n; ++i)
+  {
+    out.push_back(get_msat_child(env, term, i));
+  }
+}
+
 std::string MsatTerm::print_value_as(SortKind sk)
 {
   if (!is_value())
@@ -199,6 +199,14 @@ cdef SolverAttribute TIMELIMIT = SolverAttribute()
 TIMELIMIT.sa = c_TIMELIMIT
 setattr(solverattr, "TIMELIMIT", TIMELIMIT)
 
+cdef SolverAttribute INTERRUPT = SolverAttribute()
+INTERRUPT.sa = c_INTERRUPT
+setattr(solverattr, "INTERRUPT", INTERRUPT)
+
+cdef SolverAttribute RESOURCELIMIT = SolverAttribute()
+RESOURCELIMIT.sa = c_RESOURCELIMIT
+setattr(solverattr, "RESOURCELIMIT", RESOURCELIMIT)
+
 ################################################ PrimOps #################################################
 cdef class PrimOp:
     def __cinit__(self):
@@ -0,0 +1,113 @@
+/*********************                                                        */
+/*! \file deadline_timer.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A timer thread shared by all solvers of a process -- used for
+**        the time limits of backends without a native one.
+**
+**/
+
+#include "deadline_timer.h"
+
+using namespace std;
+
+namespace smt {
+
+DeadlineTimer & DeadlineTimer::get()
+{
+  static DeadlineTimer timer;
+  return timer;
+}
+
+DeadlineTimer::DeadlineTimer() : next_id(1), running(0), stop(false)
+{
+  thread = std::thread(&DeadlineTimer::run, this);
+}
+
+DeadlineTimer::~DeadlineTimer()
+{
+  {
+    lock_guard<mutex> lk(m);
+    stop = true;
+  }
+  cv.notify_all();
+  thread.join();
+}
+
+DeadlineTimer::Id DeadlineTimer::schedule(
+    std::chrono::steady_clock::duration delay, function<void()> callback)
+{
+  TimePoint when = std::chrono::steady_clock::now() + delay;
+  Id id;
+  {
+    lock_guard<mutex> lk(m);
+    id = next_id++;
+    queue.insert({ when, id });
+    callbacks[id] = { when, std::move(callback) };
+  }
+  // wake up the timer thread in case this is the earliest deadline
+  cv.notify_all();
+  return id;
+}
+
+bool DeadlineTimer::cancel(Id id)
+{
+  if (!id)
+  {
+    return false;
+  }
+
+  unique_lock<mutex> lk(m);
+  auto it = callbacks.find(id);
+  if (it != callbacks.end())
+  {
+    queue.erase({ it->second.first, id });
+    callbacks.erase(it);
+    return true;
+  }
+  // already run, or running right now
+  cv.wait(lk, [this, id]() { return running != id; });
+  return false;
+}
+
+void DeadlineTimer::run()
+{
+  unique_lock<mutex> lk(m);
+  while (!stop)
+  {
+    if (queue.empty())
+    {
+      cv.wait(lk);
+      continue;
+    }
+
+    auto first = *queue.begin();
+    if (std::chrono::steady_clock::now() < first.first)
+    {
+      cv.wait_until(lk, first.first);
+      continue;
+    }
+
+    queue.erase(queue.begin());
+    auto it = callbacks.find(first.second);
+    function<void()> callback = std::move(it->second.second);
+    callbacks.erase(it);
+
+    // run without the lock, cancel waits for it to finish
+    running = first.second;
+    lk.unlock();
+    callback();
+    lk.lock();
+    running = 0;
+    cv.notify_all();
+  }
+}
+
+}  // namespace smt
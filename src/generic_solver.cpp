@@ -23,6 +23,7 @@
 
 #include "generic_solver.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <poll.h>
 #include <signal.h>
@@ -45,9 +46,71 @@ using namespace std;
 
 namespace smt {
 
+// in pipelined mode, the queued commands are sent once there are this
+// many. This bounds the size of the unread replies, so that the solver
+// does not block on writing to a full pipe while we are still writing
+// commands to it.
+const size_t MAX_QUEUED_COMMANDS = 256;
+
 // helper functions
 bool is_new_line(char c) { return (c == '\n' || c == '\r' || c == 0); }
 
+// the elements of an s-expression list, e.g. the pairs of a get-value
+// response
+vector<string> split_list(const string & str)
+{
+  vector<string> elements;
+  size_t depth = 0;
+  bool in_string = false;
+  bool in_quoted_symbol = false;
+  size_t start = 0;
+  for (size_t i = 0; i < str.size(); ++i)
+  {
+    char c = str[i];
+    if (in_string)
+    {
+      in_string = (c != '"');
+      continue;
+    }
+    else if (in_quoted_symbol)
+    {
+      in_quoted_symbol = (c != '|');
+      continue;
+    }
+
+    if (c == '"')
+    {
+      in_string = true;
+    }
+    else if (c == '|')
+    {
+      in_quoted_symbol = true;
+    }
+    else if (c == '(')
+    {
+      depth++;
+      if (depth == 2)
+      {
+        start = i;
+      }
+    }
+    else if (c == ')')
+    {
+      if (depth == 2)
+      {
+        elements.push_back(str.substr(start, i - start + 1));
+      }
+      depth = depth ? depth - 1 : 0;
+    }
+  }
+  return elements;
+}
+
+bool is_ground(const Term & t)
+{
+  return static_pointer_cast<GenericTerm>(t)->is_ground();
+}
+
 // from: https://stackoverflow.com/a/36000453/1364765
 std::string & trim(std::string & str)
 {
@@ -68,12 +131,22 @@ std::string & trim(std::string & str)
 GenericSolver::GenericSolver(string path,
                              vector<string> cmd_line_args,
                              unsigned int write_buf_size,
-                             unsigned int read_buf_size)
+                             unsigned int read_buf_size,
+                             bool pipelined,
+                             bool use_let_terms)
     : AbsSmtSolver(SolverEnum::GENERIC_SOLVER),
       path(path),
       cmd_line_args(cmd_line_args),
       write_buf_size(write_buf_size),
       read_buf_size(read_buf_size),
+      read_pos(0),
+      pipelined(pipelined),
+      use_let_terms(use_let_terms),
+      sent_terms(new UnorderedTermSet()),
+      defined_terms(new UnorderedTermSet()),
+      definitions(new vector<pair<uint64_t, Term>>()),
+      checking(false),
+      process_killed(false),
       context_level_(0),
       name_sort_map(new unordered_map<string, Sort>()),
       sort_name_map(new unordered_map<Sort, string>()),
@@ -84,41 +157,17 @@ GenericSolver::GenericSolver(string path,
       datatype_name_map(
           new unordered_map<std::shared_ptr<GenericDatatype>, string>())
 {
-  // Buffer sizes over 256 caused issues in tests.
-  // Until this is investigated, we support a conservative
-  // limit of 256.
-  // Similarly for buffers of size 1.
-  if (write_buf_size < 2 || write_buf_size > 256 || read_buf_size < 2
-      || read_buf_size > 256)
+  if (write_buf_size == 0 || read_buf_size == 0)
   {
-    string msg(
-        "Generic Solvers require a buffer size of at least 2 and at most 256.");
+    string msg("Generic Solvers require a non-zero buffer size.");
     throw IncorrectUsageException(msg);
   }
   term_counter = new unsigned int;
-  //allocate memory for the buffers
-  write_buf = new char[write_buf_size];
-  read_buf = new char[read_buf_size];
-
-  // sure allocation was successful
-  assert(write_buf != NULL);
-  assert(read_buf != NULL);
-  //initialize write_buf
-  for (int i=0; i < write_buf_size; i++) {
-    write_buf[i]=0;
-  }
-  //initialize read_buf
-  for (int i=0; i < read_buf_size; i++) {
-    read_buf[i]=0;
-  }
   // start the process with the solver binary
   start_solver();
 }
 
 GenericSolver::~GenericSolver() {
-  //deallocate the buffers memory
-  delete write_buf;
-  delete read_buf;
   delete term_counter;
   // close the solver process
   close_solver();
@@ -165,106 +214,143 @@ void GenericSolver::start_solver() {
   close(outpipefd[0]);
   close(inpipefd[1]);
   set_opt("print-success", "true");
+  // make sure the binary answers, even in pipelined mode
+  flush_commands();
 }
 
 void GenericSolver::write_internal(string str) const
 {
+  // writing to the killed process would raise SIGPIPE
+  if (process_killed)
+  {
+    throw IncorrectUsageException(
+        "The solver process was killed by an interrupted check.");
+  }
   // track how many charas were written so far
-  unsigned int written_chars = 0;
-  // continue writing  until entire str was written
+  size_t written_chars = 0;
+  // continue writing until entire str was written
+  // write may accept fewer characters than requested
   while (written_chars < str.size())
   {
-    // how many characters are there left to write
-    unsigned int remaining = str.size() - written_chars;
-    // how many characters are we writing in this iteration
-    unsigned int substr_size;
-    if (remaining < write_buf_size)
+    size_t substr_size =
+        std::min<size_t>(str.size() - written_chars, write_buf_size);
+    ssize_t just_written =
+        write(outpipefd[1], str.data() + written_chars, substr_size);
+    if (just_written < 0)
     {
-      substr_size = remaining;
-    }
-    else
-    {
-      substr_size = write_buf_size;
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throw InternalSolverException("Failed to write to the solver process: "
+                                    + string(strerror(errno)));
     }
-    // write
-    strcpy(write_buf, str.substr(written_chars, substr_size).c_str());
-    write(outpipefd[1], write_buf, substr_size);
-    written_chars += substr_size;
+    written_chars += just_written;
   }
 }
 
-bool GenericSolver::is_done(int just_read, std::string result) const
+size_t GenericSolver::read_chunk() const
 {
-  bool done = false;
-  int count = 0;
-  // if we didn't read anything now, the command is done executing
-  if (just_read == 0)
+  // read directly at the end of the pending output
+  size_t old_size = read_pending.size();
+  read_pending.resize(old_size + read_buf_size);
+  ssize_t just_read;
+  do
+  {
+    just_read = read(inpipefd[0], &read_pending[old_size], read_buf_size);
+  } while (just_read < 0 && errno == EINTR);
+  // an error is treated like the end of the output
+  just_read = std::max<ssize_t>(just_read, 0);
+  read_pending.resize(old_size + just_read);
+
+  // the solver had more output than fits in the buffer,
+  // use a bigger one for the following reads
+  if (static_cast<size_t>(just_read) == read_buf_size
+      && read_buf_size < (1 << 24))
   {
-    done = true;
+    read_buf_size *= 2;
   }
-  else if (result[0] == '(')
+  return just_read;
+}
+
+string GenericSolver::read_internal() const
+{
+  string result;
+  // scanner state, kept across chunks
+  // (every character is looked at exactly once)
+  size_t depth = 0;
+  bool in_string = false;
+  bool in_quoted_symbol = false;
+  bool started = false;
+  bool done = false;
+  while (!done)
   {
-    // if the output of the solver starts with '('
-    // we will be done only when we see the matching ')'
-    for (int i = 0; i < result.size(); i++)
+    if (read_pos == read_pending.size())
     {
-      if (result[i] == '(')
+      read_pending.clear();
+      read_pos = 0;
+      // if we didn't read anything now, the command is done executing
+      if (!read_chunk())
       {
-        count++;
-      }
-      else if (result[i] == ')')
-      {
-        count--;
+        break;
       }
     }
-    done = (count == 0) && is_new_line(result[result.size() - 1]);
-  }
-  else
-  {
-    // if the output of the solver does not start with '('
-    // we will be done when we reach a newline character
-    assert(just_read <= read_buf_size);
-    for (int i = 0; i < just_read; i++)
+
+    char c = read_pending[read_pos++];
+    // skip whitespace before the response
+    if (!started && (is_new_line(c) || c == ' ' || c == '\t'))
+    {
+      continue;
+    }
+    started = true;
+
+    if (in_string)
+    {
+      // an escaped "" leaves and immediately re-enters the literal
+      in_string = (c != '"');
+    }
+    else if (in_quoted_symbol)
+    {
+      in_quoted_symbol = (c != '|');
+    }
+    else if (c == '"')
+    {
+      in_string = true;
+    }
+    else if (c == '|')
+    {
+      in_quoted_symbol = true;
+    }
+    else if (c == '(')
+    {
+      depth++;
+    }
+    else if (c == ')')
     {
-      if (is_new_line(read_buf[i]))
+      if (depth > 0)
       {
-        done = true;
+        depth--;
       }
+      // the matching ')' of the response
+      done = (depth == 0);
+    }
+    else if (is_new_line(c))
+    {
+      // a response that is not an s-expression ends at the newline
+      done = (depth == 0);
     }
-  }
-  return done;
-}
 
-string GenericSolver::read_internal() const
-{
-  string result = "";
-  bool done = false;
-  // read to the buffer until no more output to read
-  while (!done)
-  {
-    // read command, and how many chars were read.
-    int just_read = read(inpipefd[0], read_buf, read_buf_size);
-    // store the content and trim it
-    string read_buf_str(read_buf);
-    read_buf_str = read_buf_str.substr(0, read_buf_size);
-    result = result.append(read_buf_str);
-    done = is_done(just_read, result);
-    // clear buffer
-    for (int i = 0; i < read_buf_size; i++)
+    // normalize outout of solver:
+    // - no newlines in the middle of the content
+    // - no double spaces
+    if (is_new_line(c))
     {
-      read_buf[i] = 0;
+      c = ' ';
+    }
+    if (c != ' ' || result.empty() || result.back() != ' ')
+    {
+      result.push_back(c);
     }
-  }
-  // normalize outout of solver:
-  // - no newlines in the middle of the content
-  // - no double spaces
-  while (result.find("\n") != string::npos)
-  {
-    result.replace(result.find("\n"), 1, " ");
-  }
-  while (result.find("  ") != string::npos)
-  {
-    result.replace(result.find("  "), 2, " ");
   }
   return result;
 }
@@ -274,10 +360,26 @@ string GenericSolver::run_command(string cmd, bool verify_success_flag) const
   // adding a newline to simulate an "enter" hit.
   cmd = cmd + "\n";
   // writing the cmd string to the process
-  write_internal(cmd);
+  // together with the queued commands, if any
+  if (queued_commands.empty())
+  {
+    write_internal(cmd);
+  }
+  else
+  {
+    queued_commands += cmd;
+    write_internal(queued_commands);
+    queued_commands.clear();
+  }
+  // the replies of the queued commands come first
+  string error = read_queued_replies();
   // reading the result
   string result = read_internal();
   result = trim(result);
+  if (!error.empty())
+  {
+    throw IncorrectUsageException(error);
+  }
   // verify success if needed
   if (verify_success_flag)
   {
@@ -301,6 +403,58 @@ void GenericSolver::verify_success(string result) const
   }
 }
 
+void GenericSolver::queue_command(string cmd) const
+{
+  if (!pipelined)
+  {
+    run_command(cmd);
+    return;
+  }
+
+  queued_commands += cmd;
+  queued_commands += "\n";
+  unverified_commands.push_back(cmd);
+  if (unverified_commands.size() >= MAX_QUEUED_COMMANDS)
+  {
+    flush_commands();
+  }
+}
+
+void GenericSolver::flush_commands() const
+{
+  if (!queued_commands.empty())
+  {
+    write_internal(queued_commands);
+    queued_commands.clear();
+  }
+  string error = read_queued_replies();
+  if (!error.empty())
+  {
+    throw IncorrectUsageException(error);
+  }
+}
+
+string GenericSolver::read_queued_replies() const
+{
+  string error;
+  // all replies are read, even after a failure,
+  // to stay in sync with the solver's output
+  for (const string & cmd : unverified_commands)
+  {
+    string result = read_internal();
+    result = trim(result);
+    if (result != "success" && error.empty())
+    {
+      error = "The command " + cmd
+              + " did not end with a success message from the solver. The "
+                "result was: "
+              + result;
+    }
+  }
+  unverified_commands.clear();
+  return error;
+}
+
 void GenericSolver::close_solver() {
   kill(pid, SIGKILL);
   waitpid(pid, &status, 0);
@@ -316,16 +470,15 @@ void GenericSolver::define_fun(std::string name,
   assert(args_sorts.size() == 0);
   assert(sort_name_map->find(res_sort) != sort_name_map->end());
   // send a define-fun to the binary
-  run_command("(" + DEFINE_FUN_STR + " " + name + " () "
-              + (*sort_name_map)[res_sort] + " " + to_smtlib_def(defining_term)
-              + ")");
+  queue_command("(" + DEFINE_FUN_STR + " " + name + " () "
+                + (*sort_name_map)[res_sort] + " "
+                + to_smtlib_def(defining_term) + ")");
 }
 
 std::string GenericSolver::to_smtlib_def(Term term) const
 {
   // cast to generic term
   shared_ptr<GenericTerm> gt = static_pointer_cast<GenericTerm>(term);
-  bool nullary_constructor = false;
   // generic terms with no operators are represented by their
   // name.
   if (gt->get_op().is_null())
@@ -334,61 +487,293 @@ std::string GenericSolver::to_smtlib_def(Term term) const
   }
   else
   {
-    // generic terms with operators are written as s-expressions.
-    string result;
-    if (gt->get_op() == Apply_Constructor)
+    // generic terms with operators are written as s-expressions,
+    // with the names of the arguments.
+    string head;
+    TermVec args;
+    string tail;
+    smtlib_def_parts(term, head, args, tail);
+    string result = head;
+    for (const Term & a : args)
+    {
+      result += " " + (*term_name_map)[a];
+    }
+    result += tail;
+    return result;
+  }
+}
+
+void GenericSolver::smtlib_def_parts(Term term,
+                                     string & head,
+                                     TermVec & args,
+                                     string & tail) const
+{
+  shared_ptr<GenericTerm> gt = static_pointer_cast<GenericTerm>(term);
+  assert(!gt->get_op().is_null());
+  bool nullary_constructor = false;
+  if (gt->get_op() == Apply_Constructor)
+  {
+    shared_ptr<GenericDatatype> dt = static_pointer_cast<GenericDatatype>(
+        (gt->get_sort())->get_datatype());
+    nullary_constructor =
+        dt->get_num_selectors((*term_name_map)[gt->get_child(0)]);
+    head = nullary_constructor ? "(" : "";
+  }
+  else if (gt->get_op() == Apply_Tester)
+  {
+    head = "((_ is ";
+    head += (*term_name_map)[gt->get_child(0)];
+    head += ")";
+    args.push_back(gt->get_child(1));
+    tail = ")";
+    return;
+  }
+  else
+  {
+    head = "(";
+  }
+  // The Apply operator is ignored and the
+  // function being applied is used instead.
+  head += ((term->get_op().prim_op == Apply
+            || term->get_op().prim_op == Apply_Constructor
+            || term->get_op().prim_op == Apply_Selector
+            || term->get_op().prim_op == Apply_Tester)
+               ? ""
+               : term->get_op().to_string());
+  // For quantifiers we separate the bound variables list
+  // and the formula body.
+  if (term->get_op().prim_op == Forall || term->get_op().prim_op == Exists)
+  {
+    head += " ((" + (*term_name_map)[gt->get_child(0)] + " "
+            + (*sort_name_map)[gt->get_child(0)->get_sort()] + "))";
+    args.push_back(gt->get_child(1));
+  }
+  else
+  {
+    // in the general case (other than quantifiers
+    // and Apply), we use ordinary
+    // s-expressions notation and write a
+    // space-separated list of arguments.
+    size_t num_children = gt->num_children();
+    for (size_t i = 0; i < num_children; ++i)
     {
-      shared_ptr<GenericDatatype> dt = static_pointer_cast<GenericDatatype>(
-          (gt->get_sort())->get_datatype());
-      nullary_constructor =
-          dt->get_num_selectors((*term_name_map)[gt->get_children()[0]]);
-      result = nullary_constructor ? "(" : "";
+      args.push_back(gt->get_child(i));
     }
-    else if (gt->get_op() == Apply_Tester)
+  }
+  if (gt->get_op() != Apply_Constructor || nullary_constructor)
+  {
+    tail = ")";
+  }
+}
+
+std::string GenericSolver::to_smtlib_let(const Term & root) const
+{
+  assert(use_let_terms);
+
+  // collect the compound terms under root that were not defined yet,
+  // children before parents.
+  // Terms that were sent as part of an earlier command are shared
+  // across commands, they are given a name with define-fun.
+  TermVec new_terms;
+  unordered_map<Term, size_t> new_index;
+  UnorderedTermSet visited;
+  vector<pair<Term, bool>> to_visit({ { root, false } });
+  while (to_visit.size())
+  {
+    Term t = to_visit.back().first;
+    bool children_visited = to_visit.back().second;
+    to_visit.pop_back();
+
+    if (children_visited)
     {
-      result = "((_ is ";
-      result += (*term_name_map)[gt->get_children()[0]];
-      result += ") ";
-      result += (*term_name_map)[gt->get_children()[1]];
-      result += ")";
-      return result;
+      if (sent_terms->find(t) != sent_terms->end())
+      {
+        define_fun((*term_name_map)[t], SortVec{}, t->get_sort(), t);
+        add_definition(t);
+      }
+      else
+      {
+        new_index[t] = new_terms.size();
+        new_terms.push_back(t);
+      }
     }
-    else
+    else if (!t->get_op().is_null()
+             && defined_terms->find(t) == defined_terms->end()
+             && visited.insert(t).second)
     {
-      result = "(";
+      to_visit.push_back({ t, true });
+      for (const Term & c : *t)
+      {
+        to_visit.push_back({ c, false });
+      }
     }
-    // The Apply operator is ignored and the
-    // function being applied is used instead.
-    result += ((term->get_op().prim_op == Apply
-                || term->get_op().prim_op == Apply_Constructor
-                || term->get_op().prim_op == Apply_Selector
-                || term->get_op().prim_op == Apply_Tester)
-                   ? ""
-                   : term->get_op().to_string());
-    // For quantifiers we separate the bound variables list
-    // and the formula body.
-    if (term->get_op().prim_op == Forall || term->get_op().prim_op == Exists)
+  }
+
+  if (new_index.find(root) == new_index.end())
+  {
+    // a leaf, or a term that is defined by now
+    return (*term_name_map)[root];
+  }
+
+  // terms that are referenced more than once are bound with a let.
+  // So are ground terms under terms with bound variables, because
+  // those are always written with the names of their children.
+  size_t num_new = new_terms.size();
+  vector<size_t> refs(num_new, 0);
+  vector<bool> bound(num_new, false);
+  for (size_t i = 0; i < num_new; ++i)
+  {
+    bool ground = is_ground(new_terms[i]);
+    for (const Term & c : *new_terms[i])
     {
-      result += " ((" + (*term_name_map)[gt->get_children()[0]] + " "
-                + (*sort_name_map)[gt->get_children()[0]->get_sort()] + ")) "
-                + (*term_name_map)[gt->get_children()[1]];
+      auto it = new_index.find(c);
+      if (it != new_index.end() && is_ground(c))
+      {
+        refs[it->second]++;
+        bound[it->second] = bound[it->second] || !ground;
+      }
     }
-    else
+  }
+
+  // a let binding can only refer to bindings of an enclosing let.
+  // level is the number of nested lets needed below a term,
+  // and bound terms are placed in the let of their level.
+  vector<size_t> level(num_new, 0);
+  vector<TermVec> lets;
+  for (size_t i = 0; i < num_new; ++i)
+  {
+    bound[i] = bound[i] || refs[i] > 1;
+    for (const Term & c : *new_terms[i])
     {
-      // in the general case (other than quantifiers
-      // and Apply), we use ordinary
-      // s-expressions notation and write a
-      // space-separated list of arguments.
-      for (auto c : gt->get_children())
+      auto it = new_index.find(c);
+      if (it != new_index.end())
       {
-        result += " " + (*term_name_map)[c];
+        size_t j = it->second;
+        level[i] = max(level[i], bound[j] ? level[j] + 1 : level[j]);
       }
     }
-    if (gt->get_op() != Apply_Constructor || nullary_constructor)
+    if (bound[i])
     {
+      if (lets.size() <= level[i])
+      {
+        lets.resize(level[i] + 1);
+      }
+      lets[level[i]].push_back(new_terms[i]);
+    }
+  }
+
+  // writes the definition of a term, inlining the arguments that are
+  // neither bound nor defined. Every inlined term has a single
+  // reference, so the result is linear in the size of the DAG.
+  string result;
+  auto write_def = [&](const Term & t) {
+    // a null term stands for the text next to it
+    vector<pair<Term, string>> to_write({ { t, "" } });
+    string head;
+    TermVec args;
+    string tail;
+    while (to_write.size())
+    {
+      Term w = to_write.back().first;
+      string text = std::move(to_write.back().second);
+      to_write.pop_back();
+      if (!w)
+      {
+        result += text;
+        continue;
+      }
+
+      auto it = new_index.find(w);
+      if (w != t
+          && (it == new_index.end() || bound[it->second] || !is_ground(w)))
+      {
+        result += (*term_name_map)[w];
+        continue;
+      }
+
+      head.clear();
+      args.clear();
+      tail.clear();
+      smtlib_def_parts(w, head, args, tail);
+      result += head;
+      to_write.push_back({ Term(), tail });
+      for (auto a = args.rbegin(); a != args.rend(); ++a)
+      {
+        to_write.push_back({ *a, "" });
+        to_write.push_back({ Term(), " " });
+      }
+    }
+  };
+
+  for (const TermVec & let : lets)
+  {
+    if (let.empty())
+    {
+      continue;
+    }
+    result += "(let (";
+    for (const Term & t : let)
+    {
+      result += "(" + (*term_name_map)[t] + " ";
+      write_def(t);
       result += ")";
     }
-    return result;
+    result += ") ";
+  }
+  write_def(root);
+  for (const TermVec & let : lets)
+  {
+    result += let.empty() ? "" : ")";
+  }
+
+  // later commands that use these terms will define them
+  for (const Term & t : new_terms)
+  {
+    if (is_ground(t))
+    {
+      sent_terms->insert(t);
+    }
+  }
+  return result;
+}
+
+std::string GenericSolver::get_defined_name(const Term & t) const
+{
+  assert(term_name_map->find(t) != term_name_map->end());
+  string name = (*term_name_map)[t];
+  if (use_let_terms && !t->get_op().is_null()
+      && defined_terms->find(t) == defined_terms->end())
+  {
+    string def = to_smtlib_let(t);
+    // terms with bound variables can't be defined
+    if (!is_ground(t))
+    {
+      return def;
+    }
+    // to_smtlib_let defines t if it was sent before
+    if (defined_terms->find(t) == defined_terms->end())
+    {
+      queue_command("(" + DEFINE_FUN_STR + " " + name + " () "
+                    + (*sort_name_map)[t->get_sort()] + " " + def + ")");
+      add_definition(t);
+    }
+  }
+  return name;
+}
+
+void GenericSolver::add_definition(const Term & t) const
+{
+  defined_terms->insert(t);
+  definitions->push_back({ context_level_, t });
+}
+
+void GenericSolver::forget_definitions() const
+{
+  // definitions made in popped contexts are gone
+  while (definitions->size() && definitions->back().first > context_level_)
+  {
+    defined_terms->erase(definitions->back().second);
+    definitions->pop_back();
   }
 }
 
@@ -757,7 +1142,15 @@ Term GenericSolver::store_term(Term term) const
     // a define-fun command. For them, we store
     // their actual definition.
     // In future instances, the entire definition will be used.
-    if (gterm->is_ground())
+    //
+    // When let terms are used, ground terms with an operator
+    // are only given a name here. They are sent to the binary
+    // as part of the commands that use them (see to_smtlib_let).
+    if (gterm->is_ground() && use_let_terms && !gterm->get_op().is_null())
+    {
+      name = get_name(gterm);
+    }
+    else if (gterm->is_ground())
     {
       name = get_name(gterm);
       define_fun(name, SortVec{}, gterm->get_sort(), gterm);
@@ -945,9 +1338,9 @@ Term GenericSolver::make_symbol(const string name, const Sort & sort)
   // communicate the creation of the symbol to the binary of the solver.
   // When the sort is not a fucntion, we specify an empty domain.
   // Otherwise, the name of the sort includes the domain.
-  run_command("(" + DECLARE_FUN_STR + " " + piped_name
-              + (sort->get_sort_kind() == FUNCTION ? " " : " () ")
-              + (*sort_name_map)[sort] + ")");
+  queue_command("(" + DECLARE_FUN_STR + " " + piped_name
+                + (sort->get_sort_kind() == FUNCTION ? " " : " () ")
+                + (*sort_name_map)[sort] + ")");
 
   // return the created symbol as a term
   return (*name_term_map)[piped_name];
@@ -1024,8 +1417,7 @@ Term GenericSolver::get_value(const Term & t) const
          && sort->get_sort_kind() != UNINTERPRETED);
 
   // get the name of the term (the way the term is defined in the solver)
-  assert(term_name_map->find(t) != term_name_map->end());
-  string name = (*term_name_map)[t];
+  string name = get_defined_name(t);
 
   // ask the binary for the value and parse it
   string result = run_command("(" + GET_VALUE_STR + " (" + name + "))", false);
@@ -1036,6 +1428,49 @@ Term GenericSolver::get_value(const Term & t) const
   string value = strip_value_from_result(result);
 
   // translate the string representation of the result into a term
+  return value_from_string(value, sort);
+}
+
+void GenericSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  if (terms.empty())
+  {
+    return;
+  }
+
+  // ask the binary for all values with a single get-value command
+  string names;
+  for (const Term & t : terms)
+  {
+    // see get_value
+    SortKind sk = t->get_sort()->get_sort_kind();
+    assert(sk != ARRAY && sk != FUNCTION && sk != UNINTERPRETED);
+    names += (names.empty() ? "" : " ") + get_defined_name(t);
+  }
+  string result = run_command("(" + GET_VALUE_STR + " (" + names + "))", false);
+
+  // check that there was no error
+  check_no_error(result);
+
+  // the result is a list of (term value) pairs, in order
+  vector<string> pairs = split_list(result);
+  if (pairs.size() != terms.size())
+  {
+    throw InternalSolverException(
+        "Unexpected number of values from the solver. The result was: "
+        + result);
+  }
+
+  out.reserve(out.size() + terms.size());
+  for (size_t i = 0; i < terms.size(); ++i)
+  {
+    string value = strip_value_from_result(pairs[i]);
+    out.push_back(value_from_string(value, terms[i]->get_sort()));
+  }
+}
+
+Term GenericSolver::value_from_string(string value, Sort sort) const
+{
   Term resulting_term;
   // for bit-vectors, we distinguish between the solver's way of representing
   // them. it can be either binary, hex, or decimal.
@@ -1072,7 +1507,7 @@ Term GenericSolver::get_value(const Term & t) const
   }
   else
   {
-    resulting_term = make_value(value, t->get_sort());
+    resulting_term = make_value(value, sort);
   }
   return resulting_term;
 }
@@ -1237,11 +1672,13 @@ UnorderedTermMap GenericSolver::get_array_values(const Term & arr,
 void GenericSolver::reset()
 {
   string result = run_command("(" + RESET_STR + ")");
+  defined_terms->clear();
+  definitions->clear();
 }
 
 void GenericSolver::set_opt(const std::string option, const std::string value)
 {
-  run_command("(" + SET_OPTION_STR + " :" + option + " " + value + ")");
+  queue_command("(" + SET_OPTION_STR + " :" + option + " " + value + ")");
 }
 
 void GenericSolver::set_logic(const std::string logic)
@@ -1257,9 +1694,14 @@ void GenericSolver::assert_formula(const Term & t)
   // obtain the name of the term from the internal map
   assert(term_name_map->find(lt) != term_name_map->end());
   string name = (*term_name_map)[lt];
+  // or write the whole term, with let binders for shared subterms
+  if (use_let_terms)
+  {
+    name = to_smtlib_let(lt);
+  }
 
   // communicate the assertion to the binary of the solver
-  run_command("(" + ASSERT_STR + " " + name + ")");
+  queue_command("(" + ASSERT_STR + " " + name + ")");
 }
 
 Result GenericSolver::str_to_result(string result) const
@@ -1284,11 +1726,51 @@ Result GenericSolver::str_to_result(string result) const
   }
 }
 
+Result GenericSolver::run_check(string cmd)
+{
+  queued_commands += cmd + "\n";
+  write_internal(queued_commands);
+  queued_commands.clear();
+  // the command was written completely,
+  // so from now on the process may be killed
+  {
+    std::lock_guard<std::mutex> lk(interrupt_mutex);
+    checking = true;
+  }
+  string error = read_queued_replies();
+  string result = read_internal();
+  result = trim(result);
+  {
+    std::lock_guard<std::mutex> lk(interrupt_mutex);
+    checking = false;
+  }
+
+  if (process_killed)
+  {
+    return Result(UNKNOWN, "Interrupted.");
+  }
+  if (!error.empty())
+  {
+    throw IncorrectUsageException(error);
+  }
+  return str_to_result(result);
+}
+
+void GenericSolver::interrupt()
+{
+  std::lock_guard<std::mutex> lk(interrupt_mutex);
+  // there is no standard way to stop a running command,
+  // the process is killed and the pending read sees the end of its output
+  if (checking && !process_killed)
+  {
+    process_killed = true;
+    kill(pid, SIGKILL);
+  }
+}
+
 Result GenericSolver::check_sat()
 {
-  string result = run_command("(" + CHECK_SAT_STR + ")", false);
-  Result r = str_to_result(result);
-  return r;
+  return run_check("(" + CHECK_SAT_STR + ")");
 }
 
 Result GenericSolver::check_sat_assuming(const TermVec & assumptions)
@@ -1304,21 +1786,16 @@ Result GenericSolver::check_sat_assuming(const TermVec & assumptions)
     }
 
     // add the name of the literal to the list of assumptions
-    assert(term_name_map->find(t) != term_name_map->end());
-    names += " " + (*term_name_map)[t];
+    names += " " + get_defined_name(t);
   }
 
   // send command to the solver and parse it
-  string result =
-      run_command("(" + CHECK_SAT_ASSUMING_STR + " (" + names + "))", false);
-  Result r = str_to_result(result);
-  return r;
+  return run_check("(" + CHECK_SAT_ASSUMING_STR + " (" + names + "))");
 }
 
 void GenericSolver::push(uint64_t num)
   {
-    string result =
-        run_command("(" + PUSH_STR + " " + std::to_string(num) + ")");
+    queue_command("(" + PUSH_STR + " " + std::to_string(num) + ")");
     context_level_ += num;
   }
 
@@ -1326,6 +1803,7 @@ void GenericSolver::pop(uint64_t num)
 {
   string result = run_command("(" + POP_STR + " " + std::to_string(num) + ")");
   context_level_ -= num;
+  forget_definitions();
 }
 
 uint64_t GenericSolver::get_context_level() const { return context_level_; }
@@ -1333,6 +1811,9 @@ uint64_t GenericSolver::get_context_level() const { return context_level_; }
 void GenericSolver::reset_assertions()
   {
     string result = run_command("(" + RESET_ASSERTIONS_STR + ")");
+    // reset-assertions also removes the definitions
+    defined_terms->clear();
+    definitions->clear();
   }
 
 }  // namespace smt
@@ -132,6 +132,23 @@ TermIter GenericTerm::end()
   return TermIter(new GenericTermIter(children.end()));
 }
 
+size_t GenericTerm::num_children() { return children.size(); }
+
+Term GenericTerm::get_child(size_t i)
+{
+  if (i >= children.size())
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return children[i];
+}
+
+void GenericTerm::get_children(TermVec & out)
+{
+  out.insert(out.end(), children.begin(), children.end());
+}
+
 string GenericTerm::to_string()
 {
   if (repr.empty())
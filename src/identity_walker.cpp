@@ -27,6 +27,7 @@ Term IdentityWalker::visit(Term & term)
   if (clear_cache_)
   {
     cache_.clear();
+    id_cache_.clear();
 
     if (ext_cache_)
     {
@@ -47,6 +48,9 @@ Term IdentityWalker::visit(Term & term)
   //       and if something is in the cache it wouldn't
   //       visit it again (e.g. in post-order traversal)
   UnorderedTermSet visited;
+  // used instead of visited with an id-keyed cache
+  TermIdMap<bool> visited_ids;
+  bool use_ids = !ext_cache_ && cache_kind_ == ID_CACHE;
 
   Term t;
   WalkerStepResult res;
@@ -62,10 +66,10 @@ Term IdentityWalker::visit(Term & term)
     }
 
     // in preorder if it has not been seen before
-    preorder_ = (visited.find(t) == visited.end());
     // add to visited after determining whether we're in the pre-
     // or post-order
-    visited.insert(t);
+    preorder_ = use_ids ? visited_ids.insert(t, true)
+                        : visited.insert(t).second;
     res = visit_term(t);
 
     if (res == Walker_Abort)
@@ -82,10 +86,7 @@ Term IdentityWalker::visit(Term & term)
       if (res == Walker_Continue)
       {
         to_visit.push_back(t);
-        for (auto tt : t)
-        {
-          to_visit.push_back(tt);
-        }
+        t->get_children(to_visit);
       }
     }
   }
@@ -105,13 +106,11 @@ WalkerStepResult IdentityWalker::visit_term(Term & term)
     if (!op.is_null())
     {
       TermVec cached_children;
-      Term c;
-      for (auto t : term)
+      term->get_children(cached_children);
+      for (auto & c : cached_children)
       {
-        // TODO: see if we can pass the same term as both arguments
-        c = t;
-        query_cache(t, c);
-        cached_children.push_back(c);
+        // replaced in place if there's a cache hit
+        query_cache(c, c);
       }
       save_in_cache(term, solver_->make_term(op, cached_children));
     }
@@ -131,6 +130,10 @@ bool IdentityWalker::in_cache(const Term & key) const
   {
     return ext_cache_->find(key) != ext_cache_->end();
   }
+  else if (cache_kind_ == ID_CACHE)
+  {
+    return id_cache_.contains(key);
+  }
   else
   {
     return cache_.find(key) != cache_.end();
@@ -148,6 +151,15 @@ bool IdentityWalker::query_cache(const Term & key, Term & out) const
       return true;
     }
   }
+  else if (cache_kind_ == ID_CACHE)
+  {
+    const Term * val = id_cache_.find(key);
+    if (val)
+    {
+      out = *val;
+      return true;
+    }
+  }
   else
   {
     auto it = cache_.find(key);
@@ -166,6 +178,10 @@ void IdentityWalker::save_in_cache(const Term & key, const Term & val)
   {
     (*ext_cache_)[key] = val;
   }
+  else if (cache_kind_ == ID_CACHE)
+  {
+    id_cache_[key] = val;
+  }
   else
   {
     cache_[key] = val;
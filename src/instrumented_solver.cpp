@@ -0,0 +1,594 @@
+/*********************                                                        */
+/*! \file instrumented_solver.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Class that wraps another SmtSolver and records how often each
+**        API call is made and how long it takes.
+**/
+
+#include "instrumented_solver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "solver_enums.h"
+
+using namespace std;
+
+namespace smt {
+
+/* LatencyHistogram */
+
+// buckets per power of two
+const uint64_t SUB_BUCKETS = 8;
+const uint64_t SUB_BUCKET_BITS = 3;
+// values below SUB_BUCKETS have their own bucket, then SUB_BUCKETS
+// buckets for each power of two from 2^SUB_BUCKET_BITS to 2^63
+const size_t NUM_BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+static size_t bucket_index(uint64_t ns)
+{
+  if (ns < SUB_BUCKETS)
+  {
+    return ns;
+  }
+  uint64_t exp = SUB_BUCKET_BITS;
+  while (ns >> (exp + 1))
+  {
+    exp++;
+  }
+  uint64_t sub = (ns >> (exp - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+  return SUB_BUCKETS + (exp - SUB_BUCKET_BITS) * SUB_BUCKETS + sub;
+}
+
+// largest value that falls into bucket i
+static uint64_t bucket_upper_bound(size_t i)
+{
+  if (i < SUB_BUCKETS)
+  {
+    return i;
+  }
+  uint64_t shift = (i - SUB_BUCKETS) / SUB_BUCKETS;
+  uint64_t sub = (i - SUB_BUCKETS) % SUB_BUCKETS;
+  // wraps around to the maximum for the very last bucket
+  return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : buckets(NUM_BUCKETS, 0), count(0), total(0), max(0)
+{
+}
+
+void LatencyHistogram::record(uint64_t ns)
+{
+  buckets[bucket_index(ns)]++;
+  count++;
+  total += ns;
+  max = std::max(max, ns);
+}
+
+uint64_t LatencyHistogram::get_percentile(double q) const
+{
+  if (!count)
+  {
+    return 0;
+  }
+  // rank of the quantile, counting from 1
+  uint64_t rank = static_cast<uint64_t>(ceil(q * count));
+  rank = std::min(std::max(rank, uint64_t(1)), count);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i)
+  {
+    seen += buckets[i];
+    if (seen >= rank)
+    {
+      return std::min(bucket_upper_bound(i), max);
+    }
+  }
+  return max;
+}
+
+void LatencyHistogram::clear()
+{
+  fill(buckets.begin(), buckets.end(), 0);
+  count = 0;
+  total = 0;
+  max = 0;
+}
+
+/* InstrumentedCall */
+
+const char * InstrumentedSolver::call_name(InstrumentedCall c)
+{
+  // static storage, so that the names can be used in trace spans
+  switch (c)
+  {
+    case SET_OPT_CALL: return "set_opt";
+    case SET_LOGIC_CALL: return "set_logic";
+    case MAKE_SORT_CALL: return "make_sort";
+    case MAKE_SYMBOL_CALL: return "make_symbol";
+    case MAKE_PARAM_CALL: return "make_param";
+    case GET_SYMBOL_CALL: return "get_symbol";
+    case MAKE_VALUE_CALL: return "make_value";
+    case MAKE_TERM_CALL: return "make_term";
+    case MAKE_TERMS_CALL: return "make_terms";
+    case ASSERT_FORMULA_CALL: return "assert_formula";
+    case CHECK_SAT_CALL: return "check_sat";
+    case CHECK_SAT_ASSUMING_CALL: return "check_sat_assuming";
+    case PUSH_CALL: return "push";
+    case POP_CALL: return "pop";
+    case GET_VALUE_CALL: return "get_value";
+    case GET_VALUES_CALL: return "get_values";
+    case GET_ARRAY_VALUES_CALL: return "get_array_values";
+    case GET_UNSAT_ASSUMPTIONS_CALL: return "get_unsat_assumptions";
+    case GET_INTERPOLANT_CALL: return "get_interpolant";
+    case SUBSTITUTE_CALL: return "substitute";
+    case RESET_CALL: return "reset";
+    case RESET_ASSERTIONS_CALL: return "reset_assertions";
+    case DATATYPE_CALL: return "datatype";
+    default:
+      throw NotImplementedException("Unknown InstrumentedCall: "
+                                    + std::to_string(c));
+  }
+}
+
+string to_string(InstrumentedCall c)
+{
+  return InstrumentedSolver::call_name(c);
+}
+
+/* InstrumentedSolver */
+
+InstrumentedSolver::InstrumentedSolver(SmtSolver s)
+    : AbsSmtSolver(s->get_solver_enum()),
+      wrapped_solver(s),
+      enabled(true),
+      latencies(NUM_INSTRUMENTED_CALLS),
+      op_counts(NUM_OPS_AND_NULL, 0)
+{
+}
+
+InstrumentedSolver::~InstrumentedSolver() {}
+
+void InstrumentedSolver::reset_statistics()
+{
+  for (auto & l : latencies)
+  {
+    l.clear();
+  }
+  fill(op_counts.begin(), op_counts.end(), 0);
+}
+
+map<string, double> InstrumentedSolver::get_statistics() const
+{
+  map<string, double> stats;
+  for (size_t i = 0; i < NUM_INSTRUMENTED_CALLS; ++i)
+  {
+    const LatencyHistogram & l = latencies[i];
+    if (!l.get_count())
+    {
+      continue;
+    }
+    string name = to_string(static_cast<InstrumentedCall>(i));
+    stats[name + ".count"] = l.get_count();
+    stats[name + ".total_us"] = l.get_total() / 1000.0;
+    stats[name + ".p50_us"] = l.get_percentile(0.5) / 1000.0;
+    stats[name + ".p90_us"] = l.get_percentile(0.9) / 1000.0;
+    stats[name + ".p99_us"] = l.get_percentile(0.99) / 1000.0;
+    stats[name + ".max_us"] = l.get_max() / 1000.0;
+  }
+  for (size_t i = 0; i < NUM_OPS_AND_NULL; ++i)
+  {
+    if (op_counts[i])
+    {
+      stats["terms." + to_string(static_cast<PrimOp>(i))] = op_counts[i];
+    }
+  }
+  return stats;
+}
+
+void InstrumentedSolver::dump_json(ostream & out) const
+{
+  out << "{\"solver\": \"" << solver_enum << "\", \"enabled\": "
+      << (enabled ? "true" : "false") << ", \"calls\": {";
+  bool first = true;
+  for (size_t i = 0; i < NUM_INSTRUMENTED_CALLS; ++i)
+  {
+    const LatencyHistogram & l = latencies[i];
+    if (!l.get_count())
+    {
+      continue;
+    }
+    out << (first ? "" : ", ") << "\""
+        << to_string(static_cast<InstrumentedCall>(i))
+        << "\": {\"count\": " << l.get_count()
+        << ", \"total_us\": " << l.get_total() / 1000.0
+        << ", \"p50_us\": " << l.get_percentile(0.5) / 1000.0
+        << ", \"p90_us\": " << l.get_percentile(0.9) / 1000.0
+        << ", \"p99_us\": " << l.get_percentile(0.99) / 1000.0
+        << ", \"max_us\": " << l.get_max() / 1000.0 << "}";
+    first = false;
+  }
+  out << "}, \"terms\": {";
+  first = true;
+  for (size_t i = 0; i < NUM_OPS_AND_NULL; ++i)
+  {
+    if (op_counts[i])
+    {
+      // PrimOp names are SMT-LIB symbols, no escaping needed
+      out << (first ? "" : ", ") << "\""
+          << to_string(static_cast<PrimOp>(i)) << "\": " << op_counts[i];
+      first = false;
+    }
+  }
+  out << "}}" << endl;
+}
+
+void InstrumentedSolver::set_opt(const string option, const string value)
+{
+  CallTimer t(this, SET_OPT_CALL);
+  wrapped_solver->set_opt(option, value);
+}
+
+void InstrumentedSolver::set_logic(const string logic)
+{
+  CallTimer t(this, SET_LOGIC_CALL);
+  wrapped_solver->set_logic(logic);
+}
+
+void InstrumentedSolver::assert_formula(const Term & t)
+{
+  CallTimer ct(this, ASSERT_FORMULA_CALL);
+  wrapped_solver->assert_formula(t);
+}
+
+Result InstrumentedSolver::check_sat()
+{
+  CallTimer t(this, CHECK_SAT_CALL);
+  return wrapped_solver->check_sat();
+}
+
+Result InstrumentedSolver::check_sat_assuming(const TermVec & assumptions)
+{
+  CallTimer t(this, CHECK_SAT_ASSUMING_CALL);
+  return wrapped_solver->check_sat_assuming(assumptions);
+}
+
+Result InstrumentedSolver::check_sat_assuming_list(
+    const TermList & assumptions)
+{
+  CallTimer t(this, CHECK_SAT_ASSUMING_CALL);
+  return wrapped_solver->check_sat_assuming_list(assumptions);
+}
+
+Result InstrumentedSolver::check_sat_assuming_set(
+    const UnorderedTermSet & assumptions)
+{
+  CallTimer t(this, CHECK_SAT_ASSUMING_CALL);
+  return wrapped_solver->check_sat_assuming_set(assumptions);
+}
+
+void InstrumentedSolver::interrupt() { wrapped_solver->interrupt(); }
+
+void InstrumentedSolver::push(uint64_t num)
+{
+  CallTimer t(this, PUSH_CALL);
+  wrapped_solver->push(num);
+}
+
+void InstrumentedSolver::pop(uint64_t num)
+{
+  CallTimer t(this, POP_CALL);
+  wrapped_solver->pop(num);
+}
+
+uint64_t InstrumentedSolver::get_context_level() const
+{
+  return wrapped_solver->get_context_level();
+}
+
+Term InstrumentedSolver::get_value(const Term & t) const
+{
+  CallTimer ct(this, GET_VALUE_CALL);
+  return wrapped_solver->get_value(t);
+}
+
+void InstrumentedSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  CallTimer t(this, GET_VALUES_CALL);
+  wrapped_solver->get_values(terms, out);
+}
+
+UnorderedTermMap InstrumentedSolver::get_array_values(
+    const Term & arr, Term & out_const_base) const
+{
+  CallTimer t(this, GET_ARRAY_VALUES_CALL);
+  return wrapped_solver->get_array_values(arr, out_const_base);
+}
+
+void InstrumentedSolver::get_unsat_assumptions(UnorderedTermSet & out)
+{
+  CallTimer t(this, GET_UNSAT_ASSUMPTIONS_CALL);
+  wrapped_solver->get_unsat_assumptions(out);
+}
+
+Sort InstrumentedSolver::make_sort(const string name, uint64_t arity) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(name, arity);
+}
+
+Sort InstrumentedSolver::make_sort(const SortKind sk) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sk);
+}
+
+Sort InstrumentedSolver::make_sort(const SortKind sk, uint64_t size) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sk, size);
+}
+
+Sort InstrumentedSolver::make_sort(const SortKind sk, const Sort & sort1) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sk, sort1);
+}
+
+Sort InstrumentedSolver::make_sort(const SortKind sk,
+                                   const Sort & sort1,
+                                   const Sort & sort2) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sk, sort1, sort2);
+}
+
+Sort InstrumentedSolver::make_sort(const SortKind sk,
+                                   const Sort & sort1,
+                                   const Sort & sort2,
+                                   const Sort & sort3) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sk, sort1, sort2, sort3);
+}
+
+Sort InstrumentedSolver::make_sort(const SortKind sk,
+                                   const SortVec & sorts) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sk, sorts);
+}
+
+Sort InstrumentedSolver::make_sort(const Sort & sort_con,
+                                   const SortVec & sorts) const
+{
+  CallTimer t(this, MAKE_SORT_CALL);
+  return wrapped_solver->make_sort(sort_con, sorts);
+}
+
+Sort InstrumentedSolver::make_sort(const DatatypeDecl & d) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  return wrapped_solver->make_sort(d);
+}
+
+DatatypeDecl InstrumentedSolver::make_datatype_decl(const string & s)
+{
+  CallTimer t(this, DATATYPE_CALL);
+  return wrapped_solver->make_datatype_decl(s);
+}
+
+DatatypeConstructorDecl InstrumentedSolver::make_datatype_constructor_decl(
+    const string s)
+{
+  CallTimer t(this, DATATYPE_CALL);
+  return wrapped_solver->make_datatype_constructor_decl(s);
+}
+
+void InstrumentedSolver::add_constructor(
+    DatatypeDecl & dt, const DatatypeConstructorDecl & con) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  wrapped_solver->add_constructor(dt, con);
+}
+
+void InstrumentedSolver::add_selector(DatatypeConstructorDecl & dt,
+                                      const string & name,
+                                      const Sort & s) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  wrapped_solver->add_selector(dt, name, s);
+}
+
+void InstrumentedSolver::add_selector_self(DatatypeConstructorDecl & dt,
+                                           const string & name) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  wrapped_solver->add_selector_self(dt, name);
+}
+
+Term InstrumentedSolver::get_constructor(const Sort & s, string name) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  return wrapped_solver->get_constructor(s, name);
+}
+
+Term InstrumentedSolver::get_tester(const Sort & s, string name) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  return wrapped_solver->get_tester(s, name);
+}
+
+Term InstrumentedSolver::get_selector(const Sort & s,
+                                      string con,
+                                      string name) const
+{
+  CallTimer t(this, DATATYPE_CALL);
+  return wrapped_solver->get_selector(s, con, name);
+}
+
+Term InstrumentedSolver::make_term(bool b) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->make_term(b);
+}
+
+Term InstrumentedSolver::make_term(int64_t i, const Sort & sort) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->make_term(i, sort);
+}
+
+Term InstrumentedSolver::make_term(const string & s,
+                                   bool useEscSequences,
+                                   const Sort & sort) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->make_term(s, useEscSequences, sort);
+}
+
+Term InstrumentedSolver::make_term(const wstring & s, const Sort & sort) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->make_term(s, sort);
+}
+
+Term InstrumentedSolver::make_term(const string val,
+                                   const Sort & sort,
+                                   uint64_t base) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->make_term(val, sort, base);
+}
+
+Term InstrumentedSolver::make_term(const Term & val, const Sort & sort) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->make_term(val, sort);
+}
+
+Term InstrumentedSolver::import_value(const TermValue & val,
+                                      const Sort & sort) const
+{
+  CallTimer t(this, MAKE_VALUE_CALL);
+  return wrapped_solver->import_value(val, sort);
+}
+
+Term InstrumentedSolver::make_symbol(const string name, const Sort & sort)
+{
+  CallTimer t(this, MAKE_SYMBOL_CALL);
+  return wrapped_solver->make_symbol(name, sort);
+}
+
+Term InstrumentedSolver::get_symbol(const string & name)
+{
+  CallTimer t(this, GET_SYMBOL_CALL);
+  return wrapped_solver->get_symbol(name);
+}
+
+Term InstrumentedSolver::make_param(const string name, const Sort & sort)
+{
+  CallTimer t(this, MAKE_PARAM_CALL);
+  return wrapped_solver->make_param(name, sort);
+}
+
+Term InstrumentedSolver::make_term(const Op op, const Term & t) const
+{
+  CallTimer ct(this, MAKE_TERM_CALL);
+  count_op(op);
+  return wrapped_solver->make_term(op, t);
+}
+
+Term InstrumentedSolver::make_term(const Op op,
+                                   const Term & t0,
+                                   const Term & t1) const
+{
+  CallTimer t(this, MAKE_TERM_CALL);
+  count_op(op);
+  return wrapped_solver->make_term(op, t0, t1);
+}
+
+Term InstrumentedSolver::make_term(const Op op,
+                                   const Term & t0,
+                                   const Term & t1,
+                                   const Term & t2) const
+{
+  CallTimer t(this, MAKE_TERM_CALL);
+  count_op(op);
+  return wrapped_solver->make_term(op, t0, t1, t2);
+}
+
+Term InstrumentedSolver::make_term(const Op op, const TermVec & terms) const
+{
+  CallTimer t(this, MAKE_TERM_CALL);
+  count_op(op);
+  return wrapped_solver->make_term(op, terms);
+}
+
+void InstrumentedSolver::make_terms(const TermVec & leaves,
+                                    const vector<Op> & ops,
+                                    const vector<size_t> & child_offsets,
+                                    const vector<size_t> & children,
+                                    TermVec & out) const
+{
+  CallTimer t(this, MAKE_TERMS_CALL);
+  for (const auto & op : ops)
+  {
+    count_op(op);
+  }
+  wrapped_solver->make_terms(leaves, ops, child_offsets, children, out);
+}
+
+void InstrumentedSolver::reset()
+{
+  CallTimer t(this, RESET_CALL);
+  wrapped_solver->reset();
+}
+
+void InstrumentedSolver::reset_assertions()
+{
+  CallTimer t(this, RESET_ASSERTIONS_CALL);
+  wrapped_solver->reset_assertions();
+}
+
+Term InstrumentedSolver::substitute(
+    const Term term, const UnorderedTermMap & substitution_map) const
+{
+  CallTimer t(this, SUBSTITUTE_CALL);
+  return wrapped_solver->substitute(term, substitution_map);
+}
+
+TermVec InstrumentedSolver::substitute_terms(
+    const TermVec & terms, const UnorderedTermMap & substitution_map) const
+{
+  CallTimer t(this, SUBSTITUTE_CALL);
+  return wrapped_solver->substitute_terms(terms, substitution_map);
+}
+
+void InstrumentedSolver::dump_smt2(string filename) const
+{
+  wrapped_solver->dump_smt2(filename);
+}
+
+Result InstrumentedSolver::get_interpolant(const Term & A,
+                                           const Term & B,
+                                           Term & out_I) const
+{
+  CallTimer t(this, GET_INTERPOLANT_CALL);
+  return wrapped_solver->get_interpolant(A, B, out_I);
+}
+
+SmtSolver create_instrumented_solver(SmtSolver wrapped_solver)
+{
+  return std::make_shared<InstrumentedSolver>(wrapped_solver);
+}
+
+}  // namespace smt
@@ -40,10 +40,12 @@ const unordered_set<SortKind> supported_sortkinds_for_get_value(
 
 // implementations
 
-LoggingSolver::LoggingSolver(SmtSolver s)
+LoggingSolver::LoggingSolver(SmtSolver s, bool weak_hashconsing)
     : AbsSmtSolver(s->get_solver_enum()),
       wrapped_solver(s),
-      hashtable(new TermHashTable()),
+      pool(new NodePool()),
+      hashtable(weak_hashconsing ? nullptr : new TermHashTable()),
+      weak_hashtable(weak_hashconsing ? new WeakTermHashTable() : nullptr),
       assumption_cache(new UnorderedTermMap()),
       next_term_id(0)
 {
@@ -54,26 +56,26 @@ LoggingSolver::~LoggingSolver() {}
 Sort LoggingSolver::make_sort(const string name, uint64_t arity) const
 {
   Sort wrapped_sort = wrapped_solver->make_sort(name, arity);
-  return make_uninterpreted_logging_sort(wrapped_sort, name, arity);
+  return make_uninterpreted_logging_sort(wrapped_sort, name, arity, pool);
 }
 
 Sort LoggingSolver::make_sort(const SortKind sk) const
 {
   Sort sort = wrapped_solver->make_sort(sk);
-  return make_logging_sort(sk, sort);
+  return make_logging_sort(sk, sort, pool);
 }
 
 Sort LoggingSolver::make_sort(const SortKind sk, uint64_t size) const
 {
   Sort sort = wrapped_solver->make_sort(sk, size);
-  return make_logging_sort(sk, sort, size);
+  return make_logging_sort(sk, sort, size, pool);
 }
 
 Sort LoggingSolver::make_sort(const SortKind sk, const Sort & sort1) const
 {
   shared_ptr<LoggingSort> ls1 = static_pointer_cast<LoggingSort>(sort1);
   Sort sort = wrapped_solver->make_sort(sk, ls1->wrapped_sort);
-  return make_logging_sort(sk, sort, sort1);
+  return make_logging_sort(sk, sort, sort1, pool);
 }
 
 Sort LoggingSolver::make_sort(const SortKind sk,
@@ -84,7 +86,7 @@ Sort LoggingSolver::make_sort(const SortKind sk,
   shared_ptr<LoggingSort> ls2 = static_pointer_cast<LoggingSort>(sort2);
   Sort sort =
       wrapped_solver->make_sort(sk, ls1->wrapped_sort, ls2->wrapped_sort);
-  return make_logging_sort(sk, sort, sort1, sort2);
+  return make_logging_sort(sk, sort, sort1, sort2, pool);
 }
 
 Sort LoggingSolver::make_sort(const SortKind sk,
@@ -98,7 +100,7 @@ Sort LoggingSolver::make_sort(const SortKind sk,
   shared_ptr<LoggingSort> ls3 = static_pointer_cast<LoggingSort>(sort3);
   Sort sort = wrapped_solver->make_sort(
       sk, ls1->wrapped_sort, ls2->wrapped_sort, ls3->wrapped_sort);
-  return make_logging_sort(sk, sort, sort1, sort2, sort3);
+  return make_logging_sort(sk, sort, sort1, sort2, sort3, pool);
 }
 
 Sort LoggingSolver::make_sort(SortKind sk, const SortVec & sorts) const
@@ -110,7 +112,7 @@ Sort LoggingSolver::make_sort(SortKind sk, const SortVec & sorts) const
     sub_sorts.push_back(static_pointer_cast<LoggingSort>(s)->wrapped_sort);
   }
   Sort sort = wrapped_solver->make_sort(sk, sub_sorts);
-  return make_logging_sort(sk, sort, sorts);
+  return make_logging_sort(sk, sort, sorts, pool);
 }
 
 Sort LoggingSolver::make_sort(const Sort & sort_con,
@@ -126,9 +128,8 @@ Sort LoggingSolver::make_sort(const Sort & sort_con,
   }
 
   Sort ressort = wrapped_solver->make_sort(sub_sort_con, sub_sorts);
-  return make_uninterpreted_logging_sort(ressort,
-                                         sort_con->get_uninterpreted_name(),
-                                         sorts);
+  return make_uninterpreted_logging_sort(
+      ressort, sort_con->get_uninterpreted_name(), sorts, pool);
 }
 
 Sort LoggingSolver::make_sort(const DatatypeDecl & d) const {
@@ -168,17 +169,17 @@ Term LoggingSolver::get_selector(const Sort & s, std::string con, std::string na
 Term LoggingSolver::make_term(bool b) const
 {
   Term wrapped_res = wrapped_solver->make_term(b);
-  Sort boolsort = make_logging_sort(BOOL, wrapped_res->get_sort());
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, boolsort, Op(), TermVec{}, next_term_id);
+  Sort boolsort = make_logging_sort(BOOL, wrapped_res->get_sort(), pool);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, boolsort, Op(), TermVec{}, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroys the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -189,16 +190,43 @@ Term LoggingSolver::make_term(int64_t i, const Sort & sort) const
 {
   shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
   Term wrapped_res = wrapped_solver->make_term(i, lsort->wrapped_sort);
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, sort, Op(), TermVec{}, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, sort, Op(), TermVec{}, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
+  {
+    // this is the first time this term was created
+    next_term_id++;
+  }
+
+  return res;
+}
+
+Term LoggingSolver::import_value(const TermValue & val, const Sort & sort) const
+{
+  shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
+  Term wrapped_res = wrapped_solver->import_value(val, lsort->wrapped_sort);
+  if (!wrapped_res->is_value())
+  {
+    // the wrapped solver created a negative number with Negate
+    // keep the same structure in the logging term
+    assert(val.negative);
+    TermValue abs_val = val;
+    abs_val.negative = false;
+    return make_term(Negate, import_value(abs_val, sort));
+  }
+
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, sort, Op(), TermVec{}, next_term_id);
+
+  // check hash table
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -209,16 +237,16 @@ Term LoggingSolver::make_term(const std::string& s, bool useEscSequences, const
 {
   shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
   Term wrapped_res = wrapped_solver->make_term(s, useEscSequences, lsort->wrapped_sort);
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, sort, Op(), TermVec{}, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, sort, Op(), TermVec{}, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -228,16 +256,16 @@ Term LoggingSolver::make_term(const std::string& s, bool useEscSequences, const
 Term LoggingSolver::make_term(const std::wstring& s, const Sort & sort) const{
   shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
   Term wrapped_res = wrapped_solver->make_term(s, lsort->wrapped_sort);
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, sort, Op(), TermVec{}, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, sort, Op(), TermVec{}, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -250,16 +278,16 @@ Term LoggingSolver::make_term(const string name,
 {
   shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
   Term wrapped_res = wrapped_solver->make_term(name, lsort->wrapped_sort, base);
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, sort, Op(), TermVec{}, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, sort, Op(), TermVec{}, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -281,16 +309,21 @@ Term LoggingSolver::make_term(const Term & val, const Sort & sort) const
         + sort->to_string());
   }
   // the constant value must be the child
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, sort, Op(), TermVec{ val }, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool,
+      wrapped_res,
+      sort,
+      Op(),
+      initializer_list<Term>{ val },
+      next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -302,16 +335,16 @@ Term LoggingSolver::make_symbol(const string name, const Sort & sort)
   shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
   Term wrapped_sym = wrapped_solver->make_symbol(name, lsort->wrapped_sort);
   // bool true means it's a symbol
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_sym, sort, Op(), TermVec{}, name, true, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_sym, sort, Op(), TermVec{}, name, true, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -335,16 +368,16 @@ Term LoggingSolver::make_param(const string name, const Sort & sort)
   shared_ptr<LoggingSort> lsort = static_pointer_cast<LoggingSort>(sort);
   Term wrapped_param = wrapped_solver->make_param(name, lsort->wrapped_sort);
   // bool false means it's not a symbol
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_param, sort, Op(), TermVec{}, name, false, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_param, sort, Op(), TermVec{}, name, false, next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -358,18 +391,23 @@ Term LoggingSolver::make_term(const Op op, const Term & t) const
   Sort res_logging_sort = compute_sort(op, this, { t->get_sort() });
 
   // check that child is already in hash table
-  assert(hashtable->contains(t));
+  assert(in_hashtable(t));
 
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, res_logging_sort, op, TermVec{ t }, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool,
+      wrapped_res,
+      res_logging_sort,
+      op,
+      initializer_list<Term>{ t },
+      next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -388,18 +426,23 @@ Term LoggingSolver::make_term(const Op op,
       compute_sort(op, this, { t1->get_sort(), t2->get_sort() });
 
   // check that children are already in hash table
-  assert(hashtable->contains(t1));
-  assert(hashtable->contains(t2));
-
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, res_logging_sort, op, TermVec({ t1, t2 }), next_term_id);
+  assert(in_hashtable(t1));
+  assert(in_hashtable(t2));
+
+  Term res = make_pooled<LoggingTerm>(
+      pool,
+      wrapped_res,
+      res_logging_sort,
+      op,
+      initializer_list<Term>{ t1, t2 },
+      next_term_id);
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -420,20 +463,25 @@ Term LoggingSolver::make_term(const Op op,
       op, this, { t1->get_sort(), t2->get_sort(), t3->get_sort() });
 
   // check that children are already in hash table
-  assert(hashtable->contains(t1));
-  assert(hashtable->contains(t2));
-  assert(hashtable->contains(t3));
-
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, res_logging_sort, op, TermVec{ t1, t2, t3 }, next_term_id);
+  assert(in_hashtable(t1));
+  assert(in_hashtable(t2));
+  assert(in_hashtable(t3));
+
+  Term res = make_pooled<LoggingTerm>(
+      pool,
+      wrapped_res,
+      res_logging_sort,
+      op,
+      initializer_list<Term>{ t1, t2, t3 },
+      next_term_id);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
@@ -449,28 +497,98 @@ Term LoggingSolver::make_term(const Op op, const TermVec & terms) const
     lterms.push_back(ltt->wrapped_term);
 
     // check that children are already in the hash table
-    assert(hashtable->contains(tt));
+    assert(in_hashtable(tt));
   }
   Term wrapped_res = wrapped_solver->make_term(op, lterms);
   // Note: for convenience there's a version of compute_sort that takes terms
   // since these are already in a vector, just let it unpack the sorts
   Sort res_logging_sort = compute_sort(op, this, terms);
-  Term res = std::make_shared<LoggingTerm>(
-      wrapped_res, res_logging_sort, op, terms, next_term_id);
+  Term res = make_pooled<LoggingTerm>(
+      pool, wrapped_res, res_logging_sort, op, terms, next_term_id, pool);
 
   // check hash table
-  // lookup modifies term in place and returns true if it's a known term
-  // i.e. returns existing term and destroying the unnecessary new one
-  if (!hashtable->lookup(res))
+  // find_or_insert modifies term in place and returns true if it's a
+  // known term i.e. returns existing term and destroys the unnecessary
+  // new one. Otherwise, it inserts the new term
+  if (!hashcons(res))
   {
     // this is the first time this term was created
-    hashtable->insert(res);
     next_term_id++;
   }
 
   return res;
 }
 
+void LoggingSolver::make_terms(const TermVec & leaves,
+                               const std::vector<Op> & ops,
+                               const std::vector<size_t> & child_offsets,
+                               const std::vector<size_t> & children,
+                               TermVec & out) const
+{
+  check_make_terms_args(leaves.size(), ops, child_offsets, children);
+
+  size_t num_leaves = leaves.size();
+  size_t num_terms = num_leaves + ops.size();
+
+  // compute (and check) all the sorts in one pass before touching the
+  // underlying solver, so an ill-sorted DAG doesn't create any terms
+  SortVec sorts;
+  sorts.reserve(num_terms);
+  TermVec wrapped_leaves;
+  wrapped_leaves.reserve(num_leaves);
+  for (const auto & l : leaves)
+  {
+    // check that leaves are already in hash table
+    assert(in_hashtable(l));
+    sorts.push_back(l->get_sort());
+    wrapped_leaves.push_back(static_pointer_cast<LoggingTerm>(l)->wrapped_term);
+  }
+  SortVec child_sorts;
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    child_sorts.clear();
+    for (size_t j = child_offsets[i]; j < child_offsets[i + 1]; ++j)
+    {
+      child_sorts.push_back(sorts[children[j]]);
+    }
+    sorts.push_back(compute_sort(ops[i], this, child_sorts));
+  }
+
+  // build the whole DAG in the underlying solver with one call
+  TermVec wrapped_res;
+  wrapped_solver->make_terms(
+      wrapped_leaves, ops, child_offsets, children, wrapped_res);
+  assert(wrapped_res.size() == ops.size());
+
+  size_t out_start = out.size();
+  out.reserve(out_start + ops.size());
+  TermVec lchildren;
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    lchildren.clear();
+    for (size_t j = child_offsets[i]; j < child_offsets[i + 1]; ++j)
+    {
+      size_t idx = children[j];
+      lchildren.push_back(idx < num_leaves ? leaves[idx]
+                                           : out[out_start + idx - num_leaves]);
+    }
+    Term res = make_pooled<LoggingTerm>(pool,
+                                        wrapped_res[i],
+                                        sorts[num_leaves + i],
+                                        ops[i],
+                                        lchildren,
+                                        next_term_id,
+                                        pool);
+    // check hash table (see make_term)
+    if (!hashcons(res))
+    {
+      // this is the first time this term was created
+      next_term_id++;
+    }
+    out.push_back(res);
+  }
+}
+
 Term LoggingSolver::get_value(const Term & t) const
 {
   Term res;
@@ -486,16 +604,16 @@ Term LoggingSolver::get_value(const Term & t) const
   if (t->get_sort()->get_sort_kind() != ARRAY)
   {
     Term wrapped_val = wrapped_solver->get_value(lt->wrapped_term);
-    res = std::make_shared<LoggingTerm>(
-        wrapped_val, t->get_sort(), Op(), TermVec{}, next_term_id);
+    res = make_pooled<LoggingTerm>(
+        pool, wrapped_val, t->get_sort(), Op(), TermVec{}, next_term_id);
 
     // check hash table
-    // lookup modifies term in place and returns true if it's a known term
-    // i.e. returns existing term and destroying the unnecessary new one
-    if (!hashtable->lookup(res))
+    // find_or_insert modifies term in place and returns true if it's a
+    // known term i.e. returns existing term and destroys the unnecessary
+    // new one. Otherwise, it inserts the new term
+    if (!hashcons(res))
     {
       // this is the first time this term was created
-      hashtable->insert(res);
       next_term_id++;
     }
   }
@@ -519,6 +637,50 @@ Term LoggingSolver::get_value(const Term & t) const
   return res;
 }
 
+void LoggingSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  // non-array values are obtained from the wrapped solver in one call
+  TermVec wrapped_terms;
+  for (const auto & t : terms)
+  {
+    SortKind sk = t->get_sort()->get_sort_kind();
+    if (supported_sortkinds_for_get_value.find(sk)
+        == supported_sortkinds_for_get_value.end())
+    {
+      throw NotImplementedException(
+          "LoggingSolver does not support get_value for "
+          + smt::to_string(sk));
+    }
+    if (sk != ARRAY)
+    {
+      shared_ptr<LoggingTerm> lt = static_pointer_cast<LoggingTerm>(t);
+      wrapped_terms.push_back(lt->wrapped_term);
+    }
+  }
+  TermVec wrapped_vals;
+  wrapped_solver->get_values(wrapped_terms, wrapped_vals);
+
+  out.reserve(out.size() + terms.size());
+  size_t i = 0;
+  for (const auto & t : terms)
+  {
+    if (t->get_sort()->get_sort_kind() == ARRAY)
+    {
+      out.push_back(get_value(t));
+      continue;
+    }
+
+    Term res = make_pooled<LoggingTerm>(
+        pool, wrapped_vals[i++], t->get_sort(), Op(), TermVec{}, next_term_id);
+    // see get_value
+    if (!hashcons(res))
+    {
+      next_term_id++;
+    }
+    out.push_back(res);
+  }
+}
+
 void LoggingSolver::get_unsat_assumptions(UnorderedTermSet & out)
 {
   UnorderedTermSet underlying_core;
@@ -558,15 +720,20 @@ UnorderedTermMap LoggingSolver::get_array_values(const Term & arr,
           "const base for multidimensional array not implemented in "
           "LoggingSolver");
     }
-    out_const_base = std::make_shared<LoggingTerm>(
-        wrapped_out_const_base, elemsort, Op(), TermVec{}, next_term_id);
+    out_const_base = make_pooled<LoggingTerm>(
+        pool,
+        wrapped_out_const_base,
+        elemsort,
+        Op(),
+        TermVec{},
+        next_term_id);
     // check hash table
-    // lookup modifies term in place and returns true if it's a known term
-    // i.e. returns existing term and destroys the unnecessary new one
-    if (!hashtable->lookup(out_const_base))
+    // find_or_insert modifies term in place and returns true if it's a
+    // known term i.e. returns existing term and destroys the unnecessary
+    // new one. Otherwise, it inserts the new term
+    if (!hashcons(out_const_base))
     {
       // this is the first time this term was created
-      hashtable->insert(out_const_base);
       next_term_id++;
     }
   }
@@ -579,21 +746,19 @@ UnorderedTermMap LoggingSolver::get_array_values(const Term & arr,
     Assert(elem.first->is_value());
     Assert(elem.second->is_value());
 
-    idx = std::make_shared<LoggingTerm>(
-        elem.first, idxsort, Op(), TermVec{}, next_term_id);
-    if (!hashtable->lookup(idx))
+    idx = make_pooled<LoggingTerm>(
+        pool, elem.first, idxsort, Op(), TermVec{}, next_term_id);
+    if (!hashcons(idx))
     {
       // this is the first time this term was created
-      hashtable->insert(idx);
       next_term_id++;
     }
 
-    val = std::make_shared<LoggingTerm>(
-        elem.second, elemsort, Op(), TermVec{}, next_term_id);
-    if (!hashtable->lookup(val))
+    val = make_pooled<LoggingTerm>(
+        pool, elem.second, elemsort, Op(), TermVec{}, next_term_id);
+    if (!hashcons(val))
     {
       // this is the first time this term was created
-      hashtable->insert(val);
       next_term_id++;
     }
 
@@ -606,7 +771,45 @@ UnorderedTermMap LoggingSolver::get_array_values(const Term & arr,
 void LoggingSolver::reset()
 {
   wrapped_solver->reset();
-  hashtable->clear();
+  if (weak_hashtable)
+  {
+    weak_hashtable->clear();
+  }
+  else
+  {
+    hashtable->clear();
+  }
+}
+
+size_t LoggingSolver::get_num_live_terms() const
+{
+  return weak_hashtable ? weak_hashtable->size() : hashtable->size();
+}
+
+size_t LoggingSolver::get_num_collected_terms() const
+{
+  return weak_hashtable ? weak_hashtable->num_erased() : 0;
+}
+
+bool LoggingSolver::hashcons(Term & t) const
+{
+  if (!weak_hashtable)
+  {
+    return hashtable->find_or_insert(t);
+  }
+
+  if (weak_hashtable->find_or_insert(t))
+  {
+    return true;
+  }
+  // new term -- it removes itself from the table when destroyed
+  static_pointer_cast<LoggingTerm>(t)->weak_table = weak_hashtable;
+  return false;
+}
+
+bool LoggingSolver::in_hashtable(const Term & t) const
+{
+  return weak_hashtable ? weak_hashtable->contains(t) : hashtable->contains(t);
 }
 
 // dispatched to underlying solver
@@ -678,6 +881,8 @@ Result LoggingSolver::check_sat_assuming_set(
   return wrapped_solver->check_sat_assuming_set(lassumps);
 }
 
+void LoggingSolver::interrupt() { wrapped_solver->interrupt(); }
+
 void LoggingSolver::push(uint64_t num) { wrapped_solver->push(num); }
 
 void LoggingSolver::pop(uint64_t num) { wrapped_solver->pop(num); }
@@ -22,55 +22,66 @@ namespace smt {
 
 /* Helper functions */
 
-Sort make_uninterpreted_logging_sort(Sort s, string name, uint64_t arity)
+Sort make_uninterpreted_logging_sort(Sort s,
+                                     string name,
+                                     uint64_t arity,
+                                     const shared_ptr<NodePool> & pool)
 {
-  return std::make_shared<UninterpretedLoggingSort>(s, name, arity);
+  return make_pooled<UninterpretedLoggingSort>(pool, s, name, arity);
 }
 
 Sort make_uninterpreted_logging_sort(Sort s,
                                      string name,
-                                     const SortVec & sorts)
+                                     const SortVec & sorts,
+                                     const shared_ptr<NodePool> & pool)
 {
   // sort has zero arity after being constructed
-  return std::make_shared<UninterpretedLoggingSort>(s, name, 0, sorts);
+  return make_pooled<UninterpretedLoggingSort>(pool, s, name, 0, sorts);
 }
 
-Sort make_logging_sort(SortKind sk, Sort s)
+Sort make_logging_sort(SortKind sk, Sort s, const shared_ptr<NodePool> & pool)
 {
   if (sk != BOOL && sk != INT && sk != REAL && sk != STRING)
   {
     throw IncorrectUsageException("Can't create sort from " + to_string(sk));
   }
-  return std::make_shared<LoggingSort>(sk, s);
+  return make_pooled<LoggingSort>(pool, sk, s);
 }
 
-Sort make_logging_sort(SortKind sk, Sort s, uint64_t width)
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       uint64_t width,
+                       const shared_ptr<NodePool> & pool)
 {
   if (sk != BV)
   {
     throw IncorrectUsageException("Can't create sort from " + to_string(sk)
                                   + " and " + ::std::to_string(width));
   }
-  return std::make_shared<BVLoggingSort>(s, width);
+  return make_pooled<BVLoggingSort>(pool, s, width);
 }
 
-Sort make_logging_sort(SortKind sk, Sort s, Sort sort1)
+Sort make_logging_sort(SortKind, Sort, Sort, const shared_ptr<NodePool> &)
 {
   throw IncorrectUsageException(
       "No currently supported sort is created with a single sort argument");
 }
 
-Sort make_logging_sort(SortKind sk, Sort s, Sort sort1, Sort sort2)
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       Sort sort1,
+                       Sort sort2,
+                       const shared_ptr<NodePool> & pool)
 {
   Sort loggingsort;
   if (sk == ARRAY)
   {
-    loggingsort = std::make_shared<ArrayLoggingSort>(s, sort1, sort2);
+    loggingsort = make_pooled<ArrayLoggingSort>(pool, s, sort1, sort2);
   }
   else if (sk == FUNCTION)
   {
-    loggingsort =
-        std::make_shared<FunctionLoggingSort>(s, SortVec{ sort1 }, sort2);
+    loggingsort = make_pooled<FunctionLoggingSort>(
+        pool, s, SortVec{ sort1 }, sort2);
   }
   else
   {
@@ -81,12 +92,17 @@ Sort make_logging_sort(SortKind sk, Sort s, Sort sort1, Sort sort2)
   return loggingsort;
 }
 
-Sort make_logging_sort(SortKind sk, Sort s, Sort sort1, Sort sort2, Sort sort3)
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       Sort sort1,
+                       Sort sort2,
+                       Sort sort3,
+                       const shared_ptr<NodePool> & pool)
 {
   if (sk == FUNCTION)
   {
-    return std::make_shared<FunctionLoggingSort>(
-        s, SortVec{ sort1, sort2 }, sort3);
+    return make_pooled<FunctionLoggingSort>(
+        pool, s, SortVec{ sort1, sort2 }, sort3);
   }
   else
   {
@@ -96,17 +112,20 @@ Sort make_logging_sort(SortKind sk, Sort s, Sort sort1, Sort sort2, Sort sort3)
   }
 }
 
-Sort make_logging_sort(SortKind sk, Sort s, SortVec sorts)
+Sort make_logging_sort(SortKind sk,
+                       Sort s,
+                       SortVec sorts,
+                       const shared_ptr<NodePool> & pool)
 {
   if (sk == FUNCTION)
   {
     Sort return_sort = sorts.back();
     sorts.pop_back();
-    return std::make_shared<FunctionLoggingSort>(s, sorts, return_sort);
+    return make_pooled<FunctionLoggingSort>(pool, s, sorts, return_sort);
   }
   else if (sk == ARRAY && sorts.size() == 2)
   {
-    return std::make_shared<ArrayLoggingSort>(s, sorts[0], sorts[1]);
+    return make_pooled<ArrayLoggingSort>(pool, s, sorts[0], sorts[1]);
   }
   else
   {
@@ -17,6 +17,7 @@
 #include "logging_term.h"
 
 #include "exceptions.h"
+#include "term_hashtable.h"
 #include "utils.h"
 
 using namespace std;
@@ -25,31 +26,106 @@ namespace smt {
 
 /* LoggingTerm */
 
-LoggingTerm::LoggingTerm(Term t, Sort s, Op o, TermVec c, size_t id)
+LoggingTerm::LoggingTerm(Term t,
+                         Sort s,
+                         Op o,
+                         const TermVec & c,
+                         size_t id,
+                         const shared_ptr<NodePool> & pool)
     : wrapped_term(t),
       sort(s),
       op(o),
-      children(c),
       is_sym(false),
       is_par(false),
       id_(id)
 {
+  init_children(c.data(), c.size(), pool);
 }
 
 LoggingTerm::LoggingTerm(
-    Term t, Sort s, Op o, TermVec c, string r, bool is_sym, size_t id)
+    Term t, Sort s, Op o, initializer_list<Term> c, size_t id)
+    : wrapped_term(t),
+      sort(s),
+      op(o),
+      is_sym(false),
+      is_par(false),
+      id_(id)
+{
+  init_children(c.begin(), c.size());
+}
+
+LoggingTerm::LoggingTerm(Term t,
+                         Sort s,
+                         Op o,
+                         const TermVec & c,
+                         string r,
+                         bool is_sym,
+                         size_t id)
     : wrapped_term(t),
       sort(s),
       op(o),
-      children(c),
       repr(r),
       is_sym(is_sym),
       is_par(!is_sym),
       id_(id)
 {
+  init_children(c.data(), c.size());
 }
 
-LoggingTerm::~LoggingTerm() {}
+LoggingTerm::~LoggingTerm()
+{
+  if (weak_table)
+  {
+    weak_table->erase(this, hash());
+  }
+
+  if (children != inline_children)
+  {
+    for (size_t i = 0; i < num_children_; ++i)
+    {
+      children[i].~Term();
+    }
+    ChildrenHeader * header = reinterpret_cast<ChildrenHeader *>(children) - 1;
+    shared_ptr<NodePool> pool = std::move(header->pool);
+    size_t bytes = header->bytes;
+    header->~ChildrenHeader();
+    if (pool)
+    {
+      pool->deallocate(header, bytes);
+    }
+    else
+    {
+      ::operator delete(header);
+    }
+  }
+}
+
+void LoggingTerm::init_children(const Term * c,
+                                size_t n,
+                                const shared_ptr<NodePool> & pool)
+{
+  num_children_ = n;
+  if (n <= num_inline_children)
+  {
+    children = inline_children;
+    for (size_t i = 0; i < n; ++i)
+    {
+      children[i] = c[i];
+    }
+    return;
+  }
+
+  static_assert(sizeof(ChildrenHeader) % alignof(Term) == 0,
+                "children must be aligned after the header");
+  size_t bytes = sizeof(ChildrenHeader) + n * sizeof(Term);
+  void * mem = pool ? pool->allocate(bytes) : ::operator new(bytes);
+  ChildrenHeader * header = new (mem) ChildrenHeader{ pool, bytes };
+  children = reinterpret_cast<Term *>(header + 1);
+  for (size_t i = 0; i < n; ++i)
+  {
+    new (&children[i]) Term(c[i]);
+  }
+}
 
 // implemented
 
@@ -106,13 +182,13 @@ bool LoggingTerm::compare(const Term & t) const
 
   // finally need to make sure all children match
   // this is the most expensive check, so we do it last
-  if (children.size() != lt->children.size())
+  if (num_children_ != lt->num_children_)
   {
     return false;
   }
   else
   {
-    for (size_t i = 0; i < children.size(); i++)
+    for (size_t i = 0; i < num_children_; i++)
     {
       // because of hash-consing, we can compare the pointers
       // otherwise would recursively call compare on the LoggingTerm children
@@ -155,9 +231,9 @@ string LoggingTerm::to_string()
     Assert(!op.is_null());
     repr = "(";
     repr += op.to_string();
-    for (auto c : children)
+    for (size_t i = 0; i < num_children_; ++i)
     {
-      repr += " " + c->to_string();
+      repr += " " + children[i]->to_string();
     }
     repr += ")";
     return repr;
@@ -184,12 +260,29 @@ bool LoggingTerm::is_symbolic_const() const
 
 TermIter LoggingTerm::begin()
 {
-  return TermIter(new LoggingTermIter(children.begin()));
+  return TermIter(new LoggingTermIter(children));
 }
 
 TermIter LoggingTerm::end()
 {
-  return TermIter(new LoggingTermIter(children.end()));
+  return TermIter(new LoggingTermIter(children + num_children_));
+}
+
+size_t LoggingTerm::num_children() { return num_children_; }
+
+Term LoggingTerm::get_child(size_t i)
+{
+  if (i >= num_children_)
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return children[i];
+}
+
+void LoggingTerm::get_children(TermVec & out)
+{
+  out.insert(out.end(), children, children + num_children_);
 }
 
 // dispatched to underlying term
@@ -207,9 +300,29 @@ std::string LoggingTerm::print_value_as(SortKind sk)
   return wrapped_term->print_value_as(sk);
 }
 
+bool LoggingTerm::export_value(TermValue & out)
+{
+  if (!is_value() || !wrapped_term->export_value(out))
+  {
+    return false;
+  }
+
+  // the wrapped solver might alias Bool and (_ BitVec 1)
+  SortKind sk = sort->get_sort_kind();
+  if (sk == BOOL && out.kind == BV)
+  {
+    out = TermValue::make_bool(out.get_bool());
+  }
+  else if (sk == BV && out.kind == BOOL)
+  {
+    out = TermValue::make_bv(1, out.get_bool());
+  }
+  return true;
+}
+
 /* LoggingTermIter */
 
-LoggingTermIter::LoggingTermIter(TermVec::iterator i) : it(i) {}
+LoggingTermIter::LoggingTermIter(const Term * i) : it(i) {}
 
 LoggingTermIter::LoggingTermIter(const LoggingTermIter & lit) : it(lit.it) {}
 
@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file model.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A solver-independent snapshot of a model.
+**
+**/
+
+#include "model.h"
+
+#include "exceptions.h"
+#include "sort.h"
+
+using namespace std;
+
+namespace smt {
+
+const TermValue & ArrayValue::select(const TermValue & idx) const
+{
+  auto it = stores.find(idx);
+  return it == stores.end() ? default_value : it->second;
+}
+
+void Model::add_value(const Term & sym, const TermValue & val)
+{
+  if (!contains(sym))
+  {
+    symbols_.push_back(sym);
+  }
+  array_values_.erase(sym);
+  values_[sym] = val;
+}
+
+void Model::add_array_value(const Term & sym, const ArrayValue & val)
+{
+  if (!contains(sym))
+  {
+    symbols_.push_back(sym);
+  }
+  values_.erase(sym);
+  array_values_[sym] = val;
+}
+
+bool Model::contains(const Term & sym) const
+{
+  return values_.find(sym) != values_.end()
+         || array_values_.find(sym) != array_values_.end();
+}
+
+const TermValue & Model::get_value(const Term & sym) const
+{
+  auto it = values_.find(sym);
+  if (it == values_.end())
+  {
+    throw IncorrectUsageException("Model has no (non-array) value for "
+                                  + sym->to_string());
+  }
+  return it->second;
+}
+
+const ArrayValue & Model::get_array_value(const Term & sym) const
+{
+  auto it = array_values_.find(sym);
+  if (it == array_values_.end())
+  {
+    throw IncorrectUsageException("Model has no array value for "
+                                  + sym->to_string());
+  }
+  return it->second;
+}
+
+TermValue Model::to_term_value(const Term & val)
+{
+  Sort sort = val->get_sort();
+  SortKind sk = sort->get_sort_kind();
+  if (sk != BOOL && sk != BV && sk != INT && sk != REAL)
+  {
+    throw NotImplementedException("Model does not support values of sort "
+                                  + sort->to_string());
+  }
+
+  TermValue tv;
+  // solvers that alias BOOL and BV1 may export either kind
+  if (val->export_value(tv) && tv.kind == sk)
+  {
+    return tv;
+  }
+  return TermValue::from_string(
+      val->print_value_as(sk), sk, sk == BV ? sort->get_width() : 0);
+}
+
+std::ostream & operator<<(std::ostream & output, const Model & m)
+{
+  output << "(";
+  for (const auto & sym : m.get_symbols())
+  {
+    output << std::endl << "  (" << sym << " ";
+    if (sym->get_sort()->get_sort_kind() == ARRAY)
+    {
+      const ArrayValue & av = m.get_array_value(sym);
+      output << "(default " << av.default_value << ")";
+      for (const auto & elem : av.stores)
+      {
+        output << " (" << elem.first << " " << elem.second << ")";
+      }
+    }
+    else
+    {
+      output << m.get_value(sym);
+    }
+    output << ")";
+  }
+  output << std::endl << ")";
+  return output;
+}
+
+}  // namespace smt
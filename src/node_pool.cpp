@@ -0,0 +1,81 @@
+/*********************                                                        */
+/*! \file node_pool.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A pool allocator for small, frequently created objects -- used
+**        for the terms and sorts of LoggingSolver.
+**
+**/
+
+#include "node_pool.h"
+
+#include <new>
+
+using namespace std;
+
+namespace smt {
+
+/* NodePool */
+
+NodePool::NodePool() : cur(nullptr), end(nullptr)
+{
+  for (size_t i = 0; i < num_size_classes; ++i)
+  {
+    free_lists[i] = nullptr;
+  }
+}
+
+NodePool::~NodePool() {}
+
+void * NodePool::allocate(size_t size)
+{
+  if (size > max_pooled_size)
+  {
+    return ::operator new(size);
+  }
+
+  // round up to the size class
+  size_t sc = size ? (size - 1) / granularity : 0;
+  FreeChunk * chunk = free_lists[sc];
+  if (chunk)
+  {
+    free_lists[sc] = chunk->next;
+    return chunk;
+  }
+
+  size_t chunk_size = (sc + 1) * granularity;
+  if (cur + chunk_size > end)
+  {
+    // the leftover of the current block is dropped
+    // it is at most max_pooled_size bytes
+    blocks.emplace_back(new char[block_size]);
+    cur = blocks.back().get();
+    end = cur + block_size;
+  }
+  void * res = cur;
+  cur += chunk_size;
+  return res;
+}
+
+void NodePool::deallocate(void * p, size_t size)
+{
+  if (size > max_pooled_size)
+  {
+    ::operator delete(p);
+    return;
+  }
+
+  size_t sc = size ? (size - 1) / granularity : 0;
+  FreeChunk * chunk = static_cast<FreeChunk *>(p);
+  chunk->next = free_lists[sc];
+  free_lists[sc] = chunk;
+}
+
+}  // namespace smt
@@ -9,59 +9,849 @@
 ** All rights reserved.  See the file LICENSE in the top-level source
 ** directory for licensing information.\endverbatim
 **
-** \brief Implementation of a portfolio solving function that takes a vector
-**        of solvers and a term, and returns check_sat from the first solver
-**        that finishes.
+** \brief An incremental portfolio solver that keeps several solvers alive,
+**        forwards every assertion to all of them, and returns the result
+**        of the first solver that finishes each check.
 **/
 
 #include "portfolio_solver.h"
 
-#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+
+#include "smtlib_utils.h"
+#include "trace_recorder.h"
+
+using namespace std;
+
 namespace smt {
 
-PortfolioSolver::PortfolioSolver(std::vector<SmtSolver> slvrs, Term trm)
-    : solvers(slvrs), portfolio_term(trm)
+/* PortfolioScheduler */
+
+void PortfolioScheduler::record_win(const string & features,
+                                    size_t i,
+                                    double seconds)
 {
+  std::lock_guard<std::mutex> lk(m);
+  vector<WinStats> & stats = feature_stats[features];
+  for (vector<WinStats> * v : { &stats, &total_stats })
+  {
+    if (v->size() <= i)
+    {
+      v->resize(i + 1);
+    }
+    (*v)[i].wins++;
+    (*v)[i].seconds += seconds;
+  }
 }
-/** Translate the term t to the solver s, and check_sat.
- *  @param s The solver to translate the term t to.
- *  @param t The term being translated to solver s.
- */
-void PortfolioSolver::run_solver(SmtSolver s)
+
+vector<size_t> PortfolioScheduler::schedule(const string & features,
+                                            size_t num_solvers) const
 {
-  TermTranslator to_s(s);
-  Term a = to_s.transfer_term(portfolio_term, smt::BOOL);
-  s->assert_formula(a);
-  result = s->check_sat();
   std::lock_guard<std::mutex> lk(m);
-  a_solver_is_done = true;
+  vector<WinStats> stats(num_solvers);
+  auto it = feature_stats.find(features);
+  if (it != feature_stats.end())
+  {
+    copy_n(it->second.begin(), min(num_solvers, it->second.size()),
+           stats.begin());
+  }
+  vector<WinStats> total(num_solvers);
+  copy_n(total_stats.begin(), min(num_solvers, total_stats.size()),
+         total.begin());
+
+  vector<size_t> order(num_solvers);
+  for (size_t i = 0; i < num_solvers; ++i)
+  {
+    order[i] = i;
+  }
+  // stable, so that ties keep the order of the indices
+  stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (stats[a].wins != stats[b].wins)
+    {
+      return stats[a].wins > stats[b].wins;
+    }
+    if (stats[a].wins
+        && stats[a].seconds / stats[a].wins
+               != stats[b].seconds / stats[b].wins)
+    {
+      return stats[a].seconds / stats[a].wins
+             < stats[b].seconds / stats[b].wins;
+    }
+    return total[a].wins > total[b].wins;
+  });
+  return order;
+}
 
-  cv.notify_all();
+size_t PortfolioScheduler::get_wins(const string & features, size_t i) const
+{
+  std::lock_guard<std::mutex> lk(m);
+  auto it = feature_stats.find(features);
+  if (it == feature_stats.end() || it->second.size() <= i)
+  {
+    return 0;
+  }
+  return it->second[i].wins;
 }
 
-/** Launch many solvers and return whether the term is satisfiable when one of
- *  them has finished.
- *  @param solvers The solvers to run.
- *  @param t The term to be checked.
+/* PortfolioSolver */
+
+struct PortfolioSolver::Race
+{
+  Race(size_t num_solvers) : finished(num_solvers, false) {}
+
+  std::mutex m;
+  std::condition_variable cv;
+  // result of the first solver with a sat or unsat answer
+  // (the first unknown result, if there is no such solver)
+  Result result;
+  size_t winner = 0;
+  // time the winner took for its check
+  double winner_seconds = 0;
+  // Once a solver is done, result has been set,
+  // and the main thread can interrupt the others.
+  bool a_solver_is_done = false;
+  // set by interrupt(), stops the whole race
+  bool interrupted = false;
+  size_t num_finished = 0;
+  std::vector<bool> finished;  ///< per solver index
+};
+
+// terms of the portfolio belong to the first solver
+static SolverEnum first_solver_enum(const std::vector<SmtSolver> & slvrs)
+{
+  if (slvrs.empty())
+  {
+    throw IncorrectUsageException("PortfolioSolver requires a solver");
+  }
+  return slvrs[0]->get_solver_enum();
+}
+
+PortfolioSolver::PortfolioSolver(std::vector<SmtSolver> slvrs)
+    : AbsSmtSolver(first_solver_enum(slvrs)),
+      solvers(slvrs),
+      scheduler(new PortfolioScheduler()),
+      core_budget(0),
+      num_assertions(1, 0),
+      winner(0),
+      stragglers(slvrs.size())
+{
+  translators.resize(solvers.size());
+  back_translators.resize(solvers.size());
+  for (size_t i = 1; i < solvers.size(); ++i)
+  {
+    init_translators(i);
+  }
+}
+
+PortfolioSolver::PortfolioSolver(std::vector<SmtSolver> slvrs, Term trm)
+    : PortfolioSolver(slvrs)
+{
+  portfolio_term = trm;
+}
+
+PortfolioSolver::~PortfolioSolver()
+{
+  // solvers that couldn't be interrupted finish in the background,
+  // their threads own everything they use
+  for (auto & s : stragglers)
+  {
+    if (s.thread.joinable())
+    {
+      s.thread.detach();
+    }
+  }
+}
+
+void PortfolioSolver::init_translators(size_t i)
+{
+  translators[i].reset(new TermTranslator(solvers[i], solvers[0]));
+  back_translators[i].reset(new TermTranslator(solvers[0], solvers[i]));
+}
+
+bool PortfolioSolver::is_running(size_t i)
+{
+  Straggler & s = stragglers[i];
+  if (!s.thread.joinable())
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lk(s.race->m);
+  return !s.race->finished[i];
+}
+
+void PortfolioSolver::sync_solver(size_t i)
+{
+  Straggler & s = stragglers[i];
+  if (!s.thread.joinable() || is_running(i))
+  {
+    return;
+  }
+  s.thread.join();
+  s.race.reset();
+  vector<std::function<void()>> ops;
+  ops.swap(s.pending);
+  for (auto & op : ops)
+  {
+    op();
+  }
+}
+
+void PortfolioSolver::for_solver(size_t i, std::function<void()> op)
+{
+  sync_solver(i);
+  if (is_running(i))
+  {
+    stragglers[i].pending.push_back(std::move(op));
+  }
+  else
+  {
+    op();
+  }
+}
+
+void PortfolioSolver::for_all_solvers(const std::function<void(size_t)> & op)
+{
+  for (size_t i = 0; i < solvers.size(); ++i)
+  {
+    for_solver(i, [op, i]() { op(i); });
+  }
+}
+
+vector<bool> PortfolioSolver::sync_solvers()
+{
+  vector<bool> available(solvers.size());
+  for (size_t i = 0; i < solvers.size(); ++i)
+  {
+    sync_solver(i);
+    available[i] = !is_running(i);
+  }
+  return available;
+}
+
+/** Assert the term given to the constructor and check satisfiability
+ *  with all the solvers.
  */
 smt::Result PortfolioSolver::portfolio_solve()
 {
-  // We must maintain a vector of pthreads in order to stop the threads that are
-  // still running once one of the solvers finish because pthreads is assumed to
-  // be the underlying implementation.
-  for (auto s : solvers)
+  if (!portfolio_term)
+  {
+    throw IncorrectUsageException(
+        "portfolio_solve requires a term in the constructor");
+  }
+  TermTranslator to_first(solvers[0]);
+  assert_formula(to_first.transfer_term(portfolio_term, BOOL));
+  return check_sat();
+}
+
+void PortfolioSolver::set_solver_opt(size_t i,
+                                     const string option,
+                                     const string value)
+{
+  if (i >= solvers.size())
+  {
+    throw IncorrectUsageException("Solver index " + std::to_string(i)
+                                  + " is out of range for the portfolio");
+  }
+  for_solver(i, [this, i, option, value]() {
+    solvers[i]->set_opt(option, value);
+  });
+}
+
+void PortfolioSolver::diversify_seeds()
+{
+  for_all_solvers([this](size_t i) {
+    try
+    {
+      solvers[i]->set_opt("random-seed", std::to_string(i));
+    }
+    catch (SmtException & e)
+    {
+      // this solver doesn't support random seeds
+    }
+  });
+}
+
+string PortfolioSolver::get_query_features(bool assuming) const
+{
+  size_t total = 0;
+  for (size_t n : num_assertions)
+  {
+    total += n;
+  }
+  size_t bucket = 1;
+  while (bucket < total)
   {
-    // Start a thread, store its handle, and detach the thread because we are
-    // not interested in waiting for all of them to finish.
-    std::thread t1(&PortfolioSolver::run_solver, this, s);
-    t1.detach();
+    bucket *= 2;
   }
+  return (logic.empty() ? "ALL" : logic) + ":"
+         + (assuming ? CHECK_SAT_ASSUMING_STR : CHECK_SAT_STR) + ":"
+         + std::to_string(bucket);
+}
+
+// forwarded to all solvers
+// (the lambdas capture by value, they may be queued, see for_solver)
 
-  // Wait until a solver is done to cancel the threads that are still running.
-  std::unique_lock<std::mutex> lk(m);
-  while (!a_solver_is_done) cv.wait(lk);
+void PortfolioSolver::set_opt(const string option, const string value)
+{
+  for_all_solvers([this, option, value](size_t i) {
+    solvers[i]->set_opt(option, value);
+  });
+}
+
+void PortfolioSolver::set_logic(const string logic)
+{
+  for_all_solvers([this, logic](size_t i) { solvers[i]->set_logic(logic); });
+  this->logic = logic;
+}
 
-  return result;
+void PortfolioSolver::assert_formula(const Term & t)
+{
+  for_all_solvers([this, t](size_t i) {
+    solvers[i]->assert_formula(
+        i ? translators[i]->transfer_term(t, BOOL) : t);
+  });
+  num_assertions.back()++;
+}
+
+void PortfolioSolver::push(uint64_t num)
+{
+  for_all_solvers([this, num](size_t i) { solvers[i]->push(num); });
+  num_assertions.insert(num_assertions.end(), num, 0);
+}
+
+void PortfolioSolver::pop(uint64_t num)
+{
+  for_all_solvers([this, num](size_t i) { solvers[i]->pop(num); });
+  num_assertions.resize(
+      num < num_assertions.size() ? num_assertions.size() - num : 1);
+}
+
+void PortfolioSolver::reset()
+{
+  for_all_solvers([this](size_t i) {
+    solvers[i]->reset();
+    if (i)
+    {
+      // the cached terms were destroyed
+      init_translators(i);
+    }
+  });
+  winner_assumptions.clear();
+  winner = 0;
+  logic.clear();
+  num_assertions.assign(1, 0);
+}
+
+void PortfolioSolver::reset_assertions()
+{
+  for_all_solvers([this](size_t i) { solvers[i]->reset_assertions(); });
+  num_assertions.assign(1, 0);
+}
+
+void PortfolioSolver::interrupt()
+{
+  shared_ptr<Race> r;
+  {
+    std::lock_guard<std::mutex> lk(race_mutex);
+    r = current_race;
+  }
+  if (!r)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(r->m);
+    r->interrupted = true;
+  }
+  // the thread running the check interrupts the solvers
+  r->cv.notify_all();
+}
+
+// raced between the solvers
+
+Result PortfolioSolver::check_sat()
+{
+  winner_assumptions.clear();
+  vector<bool> available = sync_solvers();
+  return race(get_query_features(false),
+              available,
+              [](SmtSolver & s, const TermVec &) { return s->check_sat(); },
+              vector<TermVec>(solvers.size()));
+}
+
+Result PortfolioSolver::check_sat_assuming(const TermVec & assumptions)
+{
+  vector<bool> available = sync_solvers();
+  // translate in this thread, the translators are not thread-safe
+  vector<TermVec> translated(solvers.size());
+  translated[0] = assumptions;
+  for (size_t i = 1; i < solvers.size(); ++i)
+  {
+    if (!available[i])
+    {
+      continue;
+    }
+    translated[i].reserve(assumptions.size());
+    for (const auto & a : assumptions)
+    {
+      translated[i].push_back(translators[i]->transfer_term(a, BOOL));
+    }
+  }
+
+  Result r = race(get_query_features(true),
+                  available,
+                  [](SmtSolver & s, const TermVec & assumps) {
+                    return s->check_sat_assuming(assumps);
+                  },
+                  translated);
+
+  winner_assumptions.clear();
+  for (size_t j = 0; j < assumptions.size(); ++j)
+  {
+    winner_assumptions[translated[winner][j]] = assumptions[j];
+  }
+  return r;
+}
+
+Result PortfolioSolver::race(const string & features,
+                             const vector<bool> & available,
+                             const Check & check,
+                             const vector<TermVec> & args)
+{
+  // the first solver is never left running, so the order isn't empty
+  vector<size_t> order;
+  for (size_t i : scheduler->schedule(features, solvers.size()))
+  {
+    if (available[i])
+    {
+      order.push_back(i);
+    }
+  }
+
+  shared_ptr<Race> r = make_shared<Race>(solvers.size());
+  {
+    std::lock_guard<std::mutex> lk(race_mutex);
+    current_race = r;
+  }
+
+  size_t budget = core_budget ? core_budget : solvers.size();
+  size_t next = 0;
+  size_t num_started = 0;
+  // indexed by solver
+  vector<std::thread> threads(solvers.size());
+  std::unique_lock<std::mutex> lk(r->m);
+  while (true)
+  {
+    // fill the free cores with the next solvers of the schedule
+    while (next < order.size() && num_started - r->num_finished < budget)
+    {
+      size_t i = order[next++];
+      threads[i] = std::thread(
+          &PortfolioSolver::run_solver, r, solvers[i], i, check, args[i]);
+      num_started++;
+    }
+    if (r->a_solver_is_done || r->interrupted
+        || r->num_finished == num_started)
+    {
+      break;
+    }
+    size_t finished = r->num_finished;
+    r->cv.wait(lk, [&]() {
+      return r->a_solver_is_done || r->interrupted
+             || r->num_finished != finished;
+    });
+  }
+
+  // Stop the solvers that are still running. interrupt only stops a check
+  // that is already running, so it is repeated for solvers that had not
+  // started yet. Solvers that don't support it are left running, except
+  // the first one, which owns the terms of the portfolio.
+  vector<bool> interruptible(solvers.size(), true);
+  while (true)
+  {
+    bool must_wait = false;
+    for (size_t i = 0; i < solvers.size(); ++i)
+    {
+      if (!threads[i].joinable() || r->finished[i])
+      {
+        continue;
+      }
+      if (interruptible[i])
+      {
+        lk.unlock();
+        interruptible[i] = interrupt_solver(i);
+        lk.lock();
+      }
+      must_wait = must_wait || interruptible[i] || i == 0;
+    }
+    if (!must_wait)
+    {
+      break;
+    }
+    r->cv.wait_for(lk, std::chrono::milliseconds(10));
+  }
+
+  vector<bool> finished = r->finished;
+  lk.unlock();
+  for (size_t i = 0; i < solvers.size(); ++i)
+  {
+    if (!threads[i].joinable())
+    {
+      continue;
+    }
+    if (finished[i])
+    {
+      threads[i].join();
+    }
+    else
+    {
+      stragglers[i].thread = std::move(threads[i]);
+      stragglers[i].race = r;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> rlk(race_mutex);
+    current_race.reset();
+  }
+
+  lk.lock();
+  winner = r->winner;
+  if (r->a_solver_is_done)
+  {
+    scheduler->record_win(features, winner, r->winner_seconds);
+  }
+  else if (r->result.is_null())
+  {
+    // interrupted while only solvers that were left running had started
+    return Result(UNKNOWN, "Interrupted.");
+  }
+  return r->result;
+}
+
+void PortfolioSolver::run_solver(shared_ptr<Race> race,
+                                 SmtSolver solver,
+                                 size_t i,
+                                 Check check,
+                                 TermVec args)
+{
+  TraceSpan span(
+      "portfolio_worker", "portfolio", solver->get_solver_enum(), i);
+  Result r;
+  double seconds = 0;
+  try
+  {
+    bool stop;
+    {
+      std::lock_guard<std::mutex> lk(race->m);
+      stop = race->a_solver_is_done || race->interrupted;
+    }
+    auto start = std::chrono::steady_clock::now();
+    r = stop ? Result(UNKNOWN, "Interrupted.") : check(solver, args);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                            - start)
+                  .count();
+  }
+  catch (SmtException & e)
+  {
+    // an exception must not escape the thread
+    r = Result(UNKNOWN, e.what());
+  }
+  // release the terms while their solver is certainly alive
+  args.clear();
+
+  std::lock_guard<std::mutex> lk(race->m);
+  if (!race->a_solver_is_done && (r.is_sat() || r.is_unsat()))
+  {
+    race->result = r;
+    race->winner = i;
+    race->winner_seconds = seconds;
+    race->a_solver_is_done = true;
+  }
+  else if (race->result.is_null())
+  {
+    race->result = r;
+    race->winner = i;
+  }
+  race->finished[i] = true;
+  race->num_finished++;
+  race->cv.notify_all();
+}
+
+bool PortfolioSolver::interrupt_solver(size_t i)
+{
+  try
+  {
+    solvers[i]->interrupt();
+  }
+  catch (NotImplementedException & e)
+  {
+    // this solver runs to completion
+    return false;
+  }
+  return true;
+}
+
+// answered by the winner of the last check
+
+Term PortfolioSolver::to_winner(const Term & t) const
+{
+  return winner ? translators[winner]->transfer_term(t) : t;
+}
+
+Term PortfolioSolver::from_winner(const Term & t) const
+{
+  return winner ? back_translators[winner]->transfer_term(t) : t;
+}
+
+Term PortfolioSolver::get_value(const Term & t) const
+{
+  return from_winner(solvers[winner]->get_value(to_winner(t)));
+}
+
+void PortfolioSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  if (!winner)
+  {
+    solvers[0]->get_values(terms, out);
+    return;
+  }
+
+  TermVec winner_values;
+  solvers[winner]->get_values(translators[winner]->transfer_terms(terms),
+                              winner_values);
+  TermVec values = back_translators[winner]->transfer_terms(winner_values);
+  out.insert(out.end(), values.begin(), values.end());
+}
+
+UnorderedTermMap PortfolioSolver::get_array_values(const Term & arr,
+                                                   Term & out_const_base) const
+{
+  UnorderedTermMap winner_values =
+      solvers[winner]->get_array_values(to_winner(arr), out_const_base);
+  if (!winner)
+  {
+    return winner_values;
+  }
+
+  if (out_const_base)
+  {
+    out_const_base = from_winner(out_const_base);
+  }
+  UnorderedTermMap values;
+  for (const auto & elem : winner_values)
+  {
+    values[from_winner(elem.first)] = from_winner(elem.second);
+  }
+  return values;
+}
+
+void PortfolioSolver::get_unsat_assumptions(UnorderedTermSet & out)
+{
+  UnorderedTermSet winner_core;
+  solvers[winner]->get_unsat_assumptions(winner_core);
+  for (const auto & a : winner_core)
+  {
+    auto it = winner_assumptions.find(a);
+    // solvers should only return assumptions that were passed in
+    out.insert(it != winner_assumptions.end() ? it->second : from_winner(a));
+  }
+}
+
+// dispatched to the first solver
+
+uint64_t PortfolioSolver::get_context_level() const
+{
+  return solvers[0]->get_context_level();
+}
+
+Sort PortfolioSolver::make_sort(const string name, uint64_t arity) const
+{
+  return solvers[0]->make_sort(name, arity);
+}
+
+Sort PortfolioSolver::make_sort(const SortKind sk) const
+{
+  return solvers[0]->make_sort(sk);
+}
+
+Sort PortfolioSolver::make_sort(const SortKind sk, uint64_t size) const
+{
+  return solvers[0]->make_sort(sk, size);
+}
+
+Sort PortfolioSolver::make_sort(const SortKind sk, const Sort & sort1) const
+{
+  return solvers[0]->make_sort(sk, sort1);
+}
+
+Sort PortfolioSolver::make_sort(const SortKind sk,
+                                const Sort & sort1,
+                                const Sort & sort2) const
+{
+  return solvers[0]->make_sort(sk, sort1, sort2);
+}
+
+Sort PortfolioSolver::make_sort(const SortKind sk,
+                                const Sort & sort1,
+                                const Sort & sort2,
+                                const Sort & sort3) const
+{
+  return solvers[0]->make_sort(sk, sort1, sort2, sort3);
+}
+
+Sort PortfolioSolver::make_sort(const SortKind sk, const SortVec & sorts) const
+{
+  return solvers[0]->make_sort(sk, sorts);
+}
+
+Sort PortfolioSolver::make_sort(const Sort & sort_con,
+                                const SortVec & sorts) const
+{
+  return solvers[0]->make_sort(sort_con, sorts);
+}
+
+Sort PortfolioSolver::make_sort(const DatatypeDecl & d) const
+{
+  return solvers[0]->make_sort(d);
+}
+
+DatatypeDecl PortfolioSolver::make_datatype_decl(const string & s)
+{
+  return solvers[0]->make_datatype_decl(s);
+}
+
+DatatypeConstructorDecl PortfolioSolver::make_datatype_constructor_decl(
+    const string s)
+{
+  return solvers[0]->make_datatype_constructor_decl(s);
+}
+
+void PortfolioSolver::add_constructor(DatatypeDecl & dt,
+                                      const DatatypeConstructorDecl & con) const
+{
+  solvers[0]->add_constructor(dt, con);
+}
+
+void PortfolioSolver::add_selector(DatatypeConstructorDecl & dt,
+                                   const string & name,
+                                   const Sort & s) const
+{
+  solvers[0]->add_selector(dt, name, s);
+}
+
+void PortfolioSolver::add_selector_self(DatatypeConstructorDecl & dt,
+                                        const string & name) const
+{
+  solvers[0]->add_selector_self(dt, name);
+}
+
+Term PortfolioSolver::get_constructor(const Sort & s, string name) const
+{
+  return solvers[0]->get_constructor(s, name);
+}
+
+Term PortfolioSolver::get_tester(const Sort & s, string name) const
+{
+  return solvers[0]->get_tester(s, name);
+}
+
+Term PortfolioSolver::get_selector(const Sort & s,
+                                   string con,
+                                   string name) const
+{
+  return solvers[0]->get_selector(s, con, name);
+}
+
+Term PortfolioSolver::make_term(bool b) const
+{
+  return solvers[0]->make_term(b);
+}
+
+Term PortfolioSolver::make_term(int64_t i, const Sort & sort) const
+{
+  return solvers[0]->make_term(i, sort);
+}
+
+Term PortfolioSolver::make_term(const string & s,
+                                bool useEscSequences,
+                                const Sort & sort) const
+{
+  return solvers[0]->make_term(s, useEscSequences, sort);
+}
+
+Term PortfolioSolver::make_term(const wstring & s, const Sort & sort) const
+{
+  return solvers[0]->make_term(s, sort);
+}
+
+Term PortfolioSolver::make_term(const string val,
+                                const Sort & sort,
+                                uint64_t base) const
+{
+  return solvers[0]->make_term(val, sort, base);
+}
+
+Term PortfolioSolver::make_term(const Term & val, const Sort & sort) const
+{
+  return solvers[0]->make_term(val, sort);
+}
+
+Term PortfolioSolver::import_value(const TermValue & val,
+                                   const Sort & sort) const
+{
+  return solvers[0]->import_value(val, sort);
+}
+
+Term PortfolioSolver::make_symbol(const string name, const Sort & sort)
+{
+  // the other solvers declare it when it is first translated
+  return solvers[0]->make_symbol(name, sort);
+}
+
+Term PortfolioSolver::get_symbol(const string & name)
+{
+  return solvers[0]->get_symbol(name);
+}
+
+Term PortfolioSolver::make_param(const string name, const Sort & sort)
+{
+  return solvers[0]->make_param(name, sort);
+}
+
+Term PortfolioSolver::make_term(const Op op, const Term & t) const
+{
+  return solvers[0]->make_term(op, t);
+}
+
+Term PortfolioSolver::make_term(const Op op,
+                                const Term & t0,
+                                const Term & t1) const
+{
+  return solvers[0]->make_term(op, t0, t1);
+}
+
+Term PortfolioSolver::make_term(const Op op,
+                                const Term & t0,
+                                const Term & t1,
+                                const Term & t2) const
+{
+  return solvers[0]->make_term(op, t0, t1, t2);
+}
+
+Term PortfolioSolver::make_term(const Op op, const TermVec & terms) const
+{
+  return solvers[0]->make_term(op, terms);
+}
+
+void PortfolioSolver::make_terms(const TermVec & leaves,
+                                 const std::vector<Op> & ops,
+                                 const std::vector<size_t> & child_offsets,
+                                 const std::vector<size_t> & children,
+                                 TermVec & out) const
+{
+  solvers[0]->make_terms(leaves, ops, child_offsets, children, out);
 }
 
 }  // namespace smt
@@ -39,6 +39,8 @@ Term PrintingSolver::get_symbol(const string & name)
   return wrapped_solver->get_symbol(name);
 }
 
+void PrintingSolver::interrupt() { wrapped_solver->interrupt(); }
+
 Sort PrintingSolver::make_sort(const string name, uint64_t arity) const
 {
   (*out_stream) << "(" << DECLARE_SORT_STR << " " << name << " " << arity << ")" << endl;
@@ -130,6 +132,12 @@ Term PrintingSolver::make_term(int64_t i, const Sort & sort) const
   return wrapped_solver->make_term(i, sort);
 }
 
+Term PrintingSolver::import_value(const TermValue & val,
+                                  const Sort & sort) const
+{
+  return wrapped_solver->import_value(val, sort);
+}
+
 Term PrintingSolver::make_term(const std::string& s, bool useEscSequences, const Sort & sort) const
 {
   return wrapped_solver->make_term(s, useEscSequences, sort);
@@ -199,12 +207,32 @@ Term PrintingSolver::make_term(const Op op, const TermVec & terms) const
   return wrapped_solver->make_term(op, terms);
 }
 
+void PrintingSolver::make_terms(const TermVec & leaves,
+                                const std::vector<Op> & ops,
+                                const std::vector<size_t> & child_offsets,
+                                const std::vector<size_t> & children,
+                                TermVec & out) const
+{
+  wrapped_solver->make_terms(leaves, ops, child_offsets, children, out);
+}
+
 Term PrintingSolver::get_value(const Term & t) const
 {
   (*out_stream) << "(" << GET_VALUE_STR << " (" << t << "))" << endl;
   return wrapped_solver->get_value(t);
 }
 
+void PrintingSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  (*out_stream) << "(" << GET_VALUE_STR << " (";
+  for (size_t i = 0; i < terms.size(); ++i)
+  {
+    (*out_stream) << (i ? " " : "") << terms[i];
+  }
+  (*out_stream) << "))" << endl;
+  wrapped_solver->get_values(terms, out);
+}
+
 void PrintingSolver::get_unsat_assumptions(UnorderedTermSet & out)
 {
   (*out_stream) << "(" << GET_UNSAT_ASSUMPTIONS_STR << ")" << endl;
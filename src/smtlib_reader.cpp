@@ -65,7 +65,12 @@ SmtLibReader::SmtLibReader(smt::SmtSolver & solver, bool strict)
       // logic always includes core theory
       primops_(strict_theory2opmap.at("Core")),
       // always have sort Bool available
-      sortkinds_({ { "Bool", BOOL } })
+      sortkinds_({ { "Bool", BOOL } }),
+      mmap_input_(true),
+      input_(nullptr),
+      input_size_(0),
+      mapped_size_(0),
+      scan_buffer_(nullptr)
 {
   // dedicated true/false symbols
   // done this way because true/false can be used in other places
@@ -73,6 +78,12 @@ SmtLibReader::SmtLibReader(smt::SmtSolver & solver, bool strict)
   assert(!global_symbols_.current_scope());
 }
 
+SmtLibReader::~SmtLibReader()
+{
+  // releases the input if a scan is still open
+  scan_end();
+}
+
 int SmtLibReader::parse(const std::string & f)
 {
   file = f;
@@ -86,11 +97,12 @@ int SmtLibReader::parse(const std::string & f)
     // parse.set_debug_level (trace_parsing);
     res = parse();
   }
-  catch (const SmtException & e)
+  catch (...)
   {
     // need to end scan even if threw an exception
+    // (e.g. std::out_of_range from a huge bit-vector width)
     scan_end();
-    throw e;
+    throw;
   }
   scan_end();
   return res;
@@ -305,7 +317,7 @@ void SmtLibReader::pop_scope()
   sort_arg_ids_.pop_back();
 }
 
-Term SmtLibReader::lookup_symbol(const string & sym)
+Term SmtLibReader::lookup_symbol(string_view sym)
 {
   Term symbol_term;
   assert(!symbol_term);
@@ -319,11 +331,12 @@ Term SmtLibReader::lookup_symbol(const string & sym)
     return solver_->make_term(false);
   }
 
+  const string & key = lookup_key(sym);
   if (current_scope())
   {
     // check scoped variables before global symbols
     // shadowing semantics
-    symbol_term = arg_param_map_.get_symbol(sym);
+    symbol_term = arg_param_map_.get_symbol(key);
     if (symbol_term)
     {
       return symbol_term;
@@ -331,7 +344,7 @@ Term SmtLibReader::lookup_symbol(const string & sym)
   }
 
   assert(!symbol_term);
-  symbol_term = global_symbols_.get_symbol(sym);
+  symbol_term = global_symbols_.get_symbol(key);
   return symbol_term;
 }
 
@@ -365,9 +378,9 @@ void SmtLibReader::new_symbol(const std::string & name, const smt::Sort & sort)
   all_symbols_[name] = fresh_symbol;
 }
 
-PrimOp SmtLibReader::lookup_primop(const std::string & str)
+PrimOp SmtLibReader::lookup_primop(string_view str)
 {
-  auto it = primops_.find(str);
+  auto it = primops_.find(lookup_key(str));
   if (it != primops_.end())
   {
     return it->second;
@@ -380,10 +393,10 @@ PrimOp SmtLibReader::lookup_primop(const std::string & str)
   }
 }
 
-SortKind SmtLibReader::lookup_sortkind(const std::string & str)
+SortKind SmtLibReader::lookup_sortkind(string_view str)
 {
   SortKind sk = NUM_SORT_KINDS;
-  auto it = sortkinds_.find(str);
+  auto it = sortkinds_.find(lookup_key(str));
   if (it != sortkinds_.end())
   {
     sk = it->second;
@@ -487,12 +500,13 @@ void SmtLibReader::define_sort(const string & name, const Sort & sort)
   defined_sorts_[name] = sort;
 }
 
-Sort SmtLibReader::lookup_sort(const string & name)
+Sort SmtLibReader::lookup_sort(string_view name)
 {
-  auto it = defined_sorts_.find(name);
+  const string & key = lookup_key(name);
+  auto it = defined_sorts_.find(key);
   if (it == defined_sorts_.end())
   {
-    throw SmtException("Unknown defined sort symbol " + name);
+    throw SmtException("Unknown defined sort symbol " + key);
   }
   return it->second;
 }
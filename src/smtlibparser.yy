@@ -47,6 +47,7 @@ using namespace std;
 **
 **/
   #include <string>
+  #include <string_view>
   #include <utility>
   #include "smt.h"
 
@@ -62,20 +63,20 @@ using namespace std;
 #include "smtlib_reader.h"
 }
 
-%token <std::string> SYMBOL
-%token <std::string> NAT
-%token <std::string> FLOAT
-%token <std::string> BITSTR
-%token <std::string> HEXSTR
-%token <std::string> BVDEC
-%token <std::string> QUOTESTRING
+%token <std::string_view> SYMBOL
+%token <std::string_view> NAT
+%token <std::string_view> FLOAT
+%token <std::string_view> BITSTR
+%token <std::string_view> HEXSTR
+%token <std::string_view> BVDEC
+%token <std::string_view> QUOTESTRING
 %token SETLOGIC SETOPT SETINFO DECLARECONST DECLAREFUN
        DECLARESORT DEFINEFUN DEFINESORT ASSERT CHECKSAT
        CHECKSATASSUMING PUSH POP EXIT GETVALUE
        GETUNSATASSUMP ECHO
 %token ASCONST LET
-%token <std::string> KEYWORD
-%token <std::string> QUANTIFIER
+%token <std::string_view> KEYWORD
+%token <std::string_view> QUANTIFIER
 %token
 LP "("
 RP ")"
@@ -123,7 +124,7 @@ commands:
 command:
   LP SETLOGIC SYMBOL RP
   {
-    drv.set_logic($3);
+    drv.set_logic(std::string($3));
   }
   | LP SETOPT attribute RP
   {
@@ -137,7 +138,7 @@ command:
   }
   | LP DECLARECONST SYMBOL sort RP
   {
-    drv.new_symbol($3, $4);
+    drv.new_symbol(std::string($3), $4);
   }
   | LP DECLAREFUN SYMBOL LP sort_list RP sort RP
   {
@@ -153,11 +154,13 @@ command:
       symsort = $7;
     }
     assert(symsort);
-    drv.new_symbol($3, symsort);
+    drv.new_symbol(std::string($3), symsort);
   }
   | LP DECLARESORT SYMBOL NAT RP
   {
-    drv.define_sort($3, drv.solver()->make_sort($3, std::stoi($4)));
+    std::string name($3);
+    uint64_t arity = std::stoi(std::string($4));
+    drv.define_sort(name, drv.solver()->make_sort(name, arity));
   }
   | LP DEFINEFUN
      {
@@ -166,7 +169,7 @@ command:
      }
     SYMBOL LP sorted_arg_list RP sort term_s_expr RP
   {
-    drv.define_fun($4, $9, *$6);
+    drv.define_fun(std::string($4), $9, *$6);
 
     drv.pop_scope();
     assert(!drv.current_scope());
@@ -175,7 +178,7 @@ command:
   | LP DEFINESORT SYMBOL LP RP sort RP
   {
     // only supports 0-arity define-sorts
-    drv.define_sort($3, $6);
+    drv.define_sort(std::string($3), $6);
   }
   | LP ASSERT term_s_expr RP
   {
@@ -196,7 +199,7 @@ command:
   }
   | LP PUSH NAT RP
   {
-    drv.push(std::stoi($3));
+    drv.push(std::stoi(std::string($3)));
   }
   | LP POP RP
   {
@@ -204,7 +207,7 @@ command:
   }
   | LP POP NAT RP
   {
-    drv.pop(std::stoi($3));
+    drv.pop(std::stoi(std::string($3)));
   }
   | LP EXIT RP
   {
@@ -278,7 +281,7 @@ term_s_expr:
     {
       // assuming this is a defined fun
       // will throw exception if not a defined function symbol
-      $$ = drv.apply_define_fun($2, *$3);
+      $$ = drv.apply_define_fun(std::string($2), *$3);
     }
     delete $3;
   }
@@ -345,18 +348,20 @@ atom:
       if (!sym)
       {
         // Note: using @1 will force locations to be enabled
-        smtlib::parser::error(@1, std::string("Unrecognized symbol: ") + $1);
+        smtlib::parser::error(@1, "Unrecognized symbol: " + std::string($1));
         YYERROR;
       }
       $$ = sym;
    }
    | FLOAT
    {
-     $$ = drv.solver()->make_term($1, drv.solver()->make_sort(smt::REAL));
+     $$ = drv.solver()->make_term(std::string($1),
+                                  drv.solver()->make_sort(smt::REAL));
    }
    | NAT
    {
-     $$ = drv.solver()->make_term($1, drv.solver()->make_sort(smt::INT));
+     $$ = drv.solver()->make_term(std::string($1),
+                                  drv.solver()->make_sort(smt::INT));
    }
    | bvconst
    {
@@ -364,7 +369,9 @@ atom:
    }
    | QUOTESTRING
    {
-     $$ = drv.solver()->make_term($1, false, drv.solver()->make_sort(smt::STRING));
+     $$ = drv.solver()->make_term(std::string($1),
+                                  false,
+                                  drv.solver()->make_sort(smt::STRING));
    }
 ;
 
@@ -372,17 +379,18 @@ bvconst:
    BITSTR
    {
      smt::Sort bvsort = drv.solver()->make_sort(smt::BV, $1.length());
-     $$ = drv.solver()->make_term($1, bvsort, 2);
+     $$ = drv.solver()->make_term(std::string($1), bvsort, 2);
    }
    | HEXSTR
    {
      smt::Sort bvsort = drv.solver()->make_sort(smt::BV, 4*($1.length()));
-     $$ = drv.solver()->make_term($1, bvsort, 16);
+     $$ = drv.solver()->make_term(std::string($1), bvsort, 16);
    }
    | indprefix BVDEC NAT RP
    {
-     smt::Sort bvsort = drv.solver()->make_sort(smt::BV, std::stoi($3));
-     $$ = drv.solver()->make_term($2, bvsort, 10);
+     uint64_t width = std::stoi(std::string($3));
+     smt::Sort bvsort = drv.solver()->make_sort(smt::BV, width);
+     $$ = drv.solver()->make_term(std::string($2), bvsort, 10);
    }
 ;
 
@@ -416,10 +424,10 @@ sort:
      if (sk == smt::NUM_SORT_KINDS)
      {
        // got dedicated null enum
-       smtlib::parser::error(@2, std::string("Unrecognized sort: ") + $2);
+       smtlib::parser::error(@2, "Unrecognized sort: " + std::string($2));
        YYERROR;
      }
-     $$ = drv.solver()->make_sort(sk, std::stoi($3));
+     $$ = drv.solver()->make_sort(sk, std::stoi(std::string($3)));
    }
    | LP SYMBOL sort_list RP
    {
@@ -460,7 +468,7 @@ sorted_arg_list:
    | sorted_arg_list LP SYMBOL sort RP
    {
      assert(drv.current_scope());
-     smt::Term arg = drv.register_arg($3, $4);
+     smt::Term arg = drv.register_arg(std::string($3), $4);
      $1->push_back(arg);
      $$ = $1;
    }
@@ -474,7 +482,7 @@ sorted_param_list:
    | sorted_param_list LP SYMBOL sort RP
    {
      assert(drv.current_scope());
-     smt::Term param = drv.create_param($3, $4);
+     smt::Term param = drv.create_param(std::string($3), $4);
      $1->push_back(param);
      $$ = $1;
    }
@@ -485,7 +493,7 @@ let_term_bindings:
    {}
    | let_term_bindings LP SYMBOL term_s_expr RP
    {
-     drv.let_binding($3, $4);
+     drv.let_binding(std::string($3), $4);
    }
 
 
@@ -495,18 +503,20 @@ indexed_op:
      smt::PrimOp po = drv.lookup_primop($2);
      if (po == smt::NUM_OPS_AND_NULL)
      {
-       smtlib::parser::error(@2, "Unexpected symbol in indexed operator: " + $2);
+       smtlib::parser::error(
+           @2, "Unexpected symbol in indexed operator: " + std::string($2));
      }
-     $$ = smt::Op(po, std::stoi($3));
+     $$ = smt::Op(po, std::stoi(std::string($3)));
    }
    | indprefix SYMBOL NAT NAT RP
    {
      smt::PrimOp po = drv.lookup_primop($2);
      if (po == smt::NUM_OPS_AND_NULL)
      {
-       smtlib::parser::error(@2, "Unexpected symbol in indexed operator: " + $2);
+       smtlib::parser::error(
+           @2, "Unexpected symbol in indexed operator: " + std::string($2));
      }
-     $$ = smt::Op(po, std::stoi($3), std::stoi($4));
+     $$ = smt::Op(po, std::stoi(std::string($3)), std::stoi(std::string($4)));
    }
 ;
 
@@ -589,11 +599,11 @@ s_expr_list:
 attribute:
    KEYWORD
    {
-     $$ = {$1, ""};
+     $$ = {std::string($1), ""};
    }
    | KEYWORD s_expr
    {
-     $$ = {$1, $2};
+     $$ = {std::string($1), $2};
    }
 ;
 
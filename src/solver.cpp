@@ -52,6 +52,180 @@ Sort AbsSmtSolver::make_datatype_sort(const DatatypeDecl & decl) const
   return datatype_sorts[0];
 }
 
+void AbsSmtSolver::interrupt()
+{
+  throw NotImplementedException("interrupt not supported by "
+                                + to_string(solver_enum));
+}
+
+void AbsSmtSolver::get_values(const TermVec & terms, TermVec & out) const
+{
+  out.reserve(out.size() + terms.size());
+  for (const auto & t : terms)
+  {
+    out.push_back(get_value(t));
+  }
+}
+
+Model AbsSmtSolver::get_model(const TermVec & symbols) const
+{
+  TermVec scalars;
+  TermVec arrays;
+  for (const auto & sym : symbols)
+  {
+    if (sym->get_sort()->get_sort_kind() == ARRAY)
+    {
+      arrays.push_back(sym);
+    }
+    else
+    {
+      scalars.push_back(sym);
+    }
+  }
+
+  Model m;
+  TermVec vals;
+  get_values(scalars, vals);
+  for (size_t i = 0; i < scalars.size(); ++i)
+  {
+    m.add_value(scalars[i], Model::to_term_value(vals[i]));
+  }
+
+  for (const auto & arr : arrays)
+  {
+    ArrayValue av;
+    Term const_base;
+    UnorderedTermMap stores = get_array_values(arr, const_base);
+    if (const_base)
+    {
+      av.default_value = Model::to_term_value(const_base);
+    }
+    for (const auto & elem : stores)
+    {
+      av.stores[Model::to_term_value(elem.first)] =
+          Model::to_term_value(elem.second);
+    }
+    m.add_array_value(arr, av);
+  }
+  return m;
+}
+
+void AbsSmtSolver::make_terms(const TermVec & leaves,
+                              const std::vector<Op> & ops,
+                              const std::vector<size_t> & child_offsets,
+                              const std::vector<size_t> & children,
+                              TermVec & out) const
+{
+  check_make_terms_args(leaves.size(), ops, child_offsets, children);
+
+  size_t num_leaves = leaves.size();
+  size_t out_start = out.size();
+  out.reserve(out_start + ops.size());
+  TermVec args;
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    args.clear();
+    for (size_t j = child_offsets[i]; j < child_offsets[i + 1]; ++j)
+    {
+      size_t idx = children[j];
+      args.push_back(idx < num_leaves ? leaves[idx]
+                                      : out[out_start + idx - num_leaves]);
+    }
+    out.push_back(make_term(ops[i], args));
+  }
+}
+
+Term AbsSmtSolver::translate_native(const Term &, const AbsSmtSolver &)
+{
+  return Term();
+}
+
+Term AbsSmtSolver::import_value(const TermValue & val, const Sort & sort) const
+{
+  TermValue v = cast_value_for_import(val, sort);
+  if (v.kind == BOOL)
+  {
+    return make_term(v.get_bool());
+  }
+  else if (v.kind == BV)
+  {
+    return make_term(v.num_to_string(2), sort, 2);
+  }
+
+  assert(v.kind == INT || v.kind == REAL);
+  std::string s = v.num_to_string();
+  if (v.kind == REAL && v.den != std::vector<uint64_t>({ 1 }))
+  {
+    s += "/" + v.den_to_string();
+  }
+  Term res = make_term(s, sort);
+  return v.negative ? make_term(Negate, res) : res;
+}
+
+TermValue AbsSmtSolver::cast_value_for_import(const TermValue & val,
+                                              const Sort & sort)
+{
+  SortKind sk = sort->get_sort_kind();
+  if (val.kind == sk && (sk != BV || val.width == sort->get_width()))
+  {
+    return val;
+  }
+  else if (val.kind == BOOL && sk == BV && sort->get_width() == 1)
+  {
+    return TermValue::make_bv(1, val.get_bool());
+  }
+  else if (val.kind == BV && val.width == 1 && sk == BOOL)
+  {
+    return TermValue::make_bool(val.get_bool());
+  }
+  else if (val.kind == INT && sk == REAL)
+  {
+    return TermValue::make_real(val.negative, val.num, { 1 });
+  }
+  else if (val.kind == REAL && sk == INT
+           && val.den == std::vector<uint64_t>({ 1 }))
+  {
+    return TermValue::make_int(val.negative, val.num);
+  }
+
+  throw IncorrectUsageException("Can't import value " + val.to_string()
+                                + " with sort " + sort->to_string());
+}
+
+void AbsSmtSolver::check_make_terms_args(
+    size_t num_leaves,
+    const std::vector<Op> & ops,
+    const std::vector<size_t> & child_offsets,
+    const std::vector<size_t> & children)
+{
+  if (child_offsets.size() != ops.size() + 1 || child_offsets[0] != 0
+      || child_offsets.back() != children.size())
+  {
+    throw IncorrectUsageException(
+        "make_terms expects ops.size() + 1 child offsets from 0 to "
+        "children.size()");
+  }
+
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    if (child_offsets[i] > child_offsets[i + 1])
+    {
+      throw IncorrectUsageException(
+          "make_terms expects non-decreasing child offsets");
+    }
+    for (size_t j = child_offsets[i]; j < child_offsets[i + 1]; ++j)
+    {
+      if (children[j] >= num_leaves + i)
+      {
+        throw IncorrectUsageException(
+            "make_terms: child index " + std::to_string(children[j])
+            + " of term " + std::to_string(num_leaves + i)
+            + " does not refer to a leaf or an earlier term");
+      }
+    }
+  }
+}
+
 Term AbsSmtSolver::substitute(const Term term,
                               const UnorderedTermMap & substitution_map) const
 {
@@ -69,17 +243,15 @@ Term AbsSmtSolver::substitute(const Term term,
       // doesn't get updated yet, just marking as visited
       cache[t] = t;
       to_visit.push_back(t);
-      for (auto c : t)
-      {
-        to_visit.push_back(c);
-      }
+      t->get_children(to_visit);
     }
     else
     {
       cached_children.clear();
-      for (auto c : t)
+      t->get_children(cached_children);
+      for (auto & c : cached_children)
       {
-        cached_children.push_back(cache.at(c));
+        c = cache.at(c);
       }
 
       // const arrays have children but don't need to be rebuilt
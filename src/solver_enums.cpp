@@ -34,7 +34,9 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             CONSTARR,
             UNSAT_CORE,
             QUANTIFIERS,
-            BOOL_BV1_ALIASING } },
+            BOOL_BV1_ALIASING,
+            TIMELIMIT,
+            INTERRUPT } },
 
         { BZLA,
           { TERMITER,
@@ -47,7 +49,8 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             //      https://github.com/bitwuzla/bitwuzla/commit/605f31557ec6c635e3c617d2b0ab257309e994c4
             // QUANTIFIERS,
             BOOL_BV1_ALIASING,
-            TIMELIMIT } },
+            TIMELIMIT,
+            INTERRUPT } },
 
         { CVC5,
           { TERMITER,
@@ -63,7 +66,8 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             THEORY_DATATYPE,
             QUANTIFIERS,
             UNINTERP_SORT,
-            PARAM_UNINTERP_SORT } },
+            PARAM_UNINTERP_SORT,
+            RESOURCELIMIT } },
 
         { GENERIC_SOLVER,
           { TERMITER,
@@ -73,7 +77,8 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             ARRAY_FUN_BOOLS,
             UNSAT_CORE,
             THEORY_DATATYPE,
-            QUANTIFIERS } },
+            QUANTIFIERS,
+            INTERRUPT } },
 
         { MSAT,
           { TERMITER,
@@ -85,7 +90,9 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             FULL_TRANSFER,
             UNSAT_CORE,
             QUANTIFIERS,
-            UNINTERP_SORT } },
+            UNINTERP_SORT,
+            TIMELIMIT,
+            INTERRUPT } },
 
         // TODO: Yices2 should support UNSAT_CORE
         //       but something funky happens with testing
@@ -98,7 +105,8 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             THEORY_REAL,
             ARRAY_FUN_BOOLS,
             UNINTERP_SORT,
-            TIMELIMIT } },
+            TIMELIMIT,
+            INTERRUPT } },
         { Z3,
           { TERMITER,
             LOGGING,
@@ -110,7 +118,9 @@ const unordered_map<SolverEnum, unordered_set<SolverAttribute>>
             UNSAT_CORE,
             QUANTIFIERS,
             UNINTERP_SORT,
-            TIMELIMIT } },
+            TIMELIMIT,
+            RESOURCELIMIT,
+            INTERRUPT } },
 
     });
 
@@ -183,6 +193,9 @@ std::ostream & operator<<(std::ostream & o, SolverAttribute a)
     case THEORY_DATATYPE: o << "THEORY_DATATYPE"; break;
     case QUANTIFIERS: o << "QUANTIFIERS"; break;
     case BOOL_BV1_ALIASING: o << "BOOL_BV1_ALIASING"; break;
+    case TIMELIMIT: o << "TIMELIMIT"; break;
+    case INTERRUPT: o << "INTERRUPT"; break;
+    case RESOURCELIMIT: o << "RESOURCELIMIT"; break;
     default:
       // should print the integer representation
       throw NotImplementedException("Unknown SolverAttribute: "
@@ -19,8 +19,9 @@ namespace smt {
 
 SubstitutionWalker::SubstitutionWalker(
     const smt::SmtSolver & solver,
-    const smt::UnorderedTermMap & substitution_map)
-    : IdentityWalker(solver, false)
+    const smt::UnorderedTermMap & substitution_map,
+    CacheKind cache_kind)
+    : IdentityWalker(solver, false, cache_kind)
 {
   // pre-populate the cache with substitutions
   for (auto elem : substitution_map)
@@ -24,6 +24,39 @@ std::ostream & operator<<(std::ostream & output, const Term t)
   return output;
 }
 
+/* AbsTerm default implementations */
+std::size_t AbsTerm::num_children()
+{
+  std::size_t n = 0;
+  for (TermIter it = begin(), e = end(); it != e; ++it)
+  {
+    ++n;
+  }
+  return n;
+}
+
+Term AbsTerm::get_child(std::size_t i)
+{
+  std::size_t n = 0;
+  for (TermIter it = begin(), e = end(); it != e; ++it)
+  {
+    if (n == i)
+    {
+      return *it;
+    }
+    ++n;
+  }
+  throw IncorrectUsageException("Child index " + std::to_string(i)
+                                + " out of range in get_child");
+}
+
+void AbsTerm::get_children(std::vector<Term> & out)
+{
+  out.insert(out.end(), begin(), end());
+}
+bool AbsTerm::export_value(TermValue &) { return false; }
+/* end AbsTerm default implementations */
+
 /* TermIterBase implementation */
 const Term TermIterBase::operator*()
 {
@@ -0,0 +1,157 @@
+/*********************                                                        */
+/*! \file term_dag.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A flat snapshot of a term DAG for repeated analyses.
+**
+**/
+
+#include "term_dag.h"
+
+#include "assert.h"
+
+using namespace std;
+
+namespace smt {
+
+TermDag::TermDag(const TermVec & roots) : child_offsets_({ 0 })
+{
+  add_roots(roots);
+}
+
+size_t TermDag::add_root(const Term & root)
+{
+  // iterative post-order traversal
+  // a term is added once all its children have been added
+  vector<pair<Term, bool>> to_visit({ { root, false } });
+  TermVec children;
+  while (to_visit.size())
+  {
+    Term t = to_visit.back().first;
+    bool children_added = to_visit.back().second;
+    to_visit.pop_back();
+
+    if (index_.contains(t))
+    {
+      continue;
+    }
+
+    children.clear();
+    t->get_children(children);
+    if (children_added)
+    {
+      add_node(t, children);
+    }
+    else
+    {
+      to_visit.push_back({ t, true });
+      // push in reverse so the first child gets the smallest index
+      for (auto it = children.rbegin(); it != children.rend(); ++it)
+      {
+        if (!index_.contains(*it))
+        {
+          to_visit.push_back({ *it, false });
+        }
+      }
+    }
+  }
+
+  size_t idx = *index_.find(root);
+  roots_.push_back(idx);
+  return idx;
+}
+
+void TermDag::add_roots(const TermVec & roots)
+{
+  for (const auto & r : roots)
+  {
+    add_root(r);
+  }
+}
+
+size_t TermDag::find(const Term & t) const
+{
+  const size_t * idx = index_.find(t);
+  return idx ? *idx : npos;
+}
+
+void TermDag::get_cone(const vector<size_t> & nodes,
+                       vector<bool> & in_cone) const
+{
+  in_cone.assign(size(), false);
+  size_t max_node = 0;
+  for (auto n : nodes)
+  {
+    assert(n < size());
+    in_cone[n] = true;
+    max_node = max(max_node, n + 1);
+  }
+
+  // children always come first, so one backwards pass is enough
+  for (size_t i = max_node; i-- > 0;)
+  {
+    if (in_cone[i])
+    {
+      for (const size_t * c = children_begin(i); c != children_end(i); ++c)
+      {
+        in_cone[*c] = true;
+      }
+    }
+  }
+}
+
+size_t TermDag::add_node(const Term & t, const TermVec & children)
+{
+  size_t idx = terms_.size();
+
+  terms_.push_back(t);
+  ops_.push_back(t->get_op());
+
+  Sort sort = t->get_sort();
+  auto it = sort_index_.find(sort);
+  if (it == sort_index_.end())
+  {
+    it = sort_index_.insert({ sort, sorts_.size() }).first;
+    sorts_.push_back(sort);
+  }
+  sort_ids_.push_back(it->second);
+
+  uint8_t flags = 0;
+  if (t->is_symbol())
+  {
+    flags |= SYMBOL;
+  }
+  if (t->is_symbolic_const())
+  {
+    flags |= SYMBOLIC_CONST;
+  }
+  if (t->is_param())
+  {
+    flags |= PARAM;
+  }
+  if (t->is_value())
+  {
+    flags |= VALUE;
+  }
+  flags_.push_back(flags);
+
+  for (const auto & c : children)
+  {
+    const size_t * cidx = index_.find(c);
+    assert(cidx);
+    children_.push_back(*cidx);
+  }
+  child_offsets_.push_back(children_.size());
+
+  index_.insert(t, idx);
+  return idx;
+}
+
+}  // namespace smt
@@ -17,48 +17,274 @@
 
 #include "term_hashtable.h"
 
+#include "assert.h"
+
 using namespace std;
 
 namespace smt {
 
+// the capacity used for the first allocation
+const size_t initial_capacity = 64;
+
+/* Helpers shared by the open-addressing tables
+   Slot types must have a hashval member and occupied/reset methods */
+
+static size_t home_slot(size_t hashval, size_t capacity)
+{
+  // mix the bits -- some solvers hash terms by sequential ids
+  // and linear probing degrades quickly with clustered hashes
+  uint64_t h = hashval;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h & (capacity - 1);
+}
+
+template <class Slot>
+static void rehash(vector<Slot> & slots, size_t new_capacity)
+{
+  assert((new_capacity & (new_capacity - 1)) == 0);
+  vector<Slot> old_slots(new_capacity);
+  old_slots.swap(slots);
+  size_t mask = new_capacity - 1;
+  for (auto & s : old_slots)
+  {
+    if (s.occupied())
+    {
+      // all entries are distinct, so only need to find an empty slot
+      size_t idx = home_slot(s.hashval, new_capacity);
+      while (slots[idx].occupied())
+      {
+        idx = (idx + 1) & mask;
+      }
+      slots[idx] = std::move(s);
+    }
+  }
+}
+
+/** grows the table (if needed) so that one more element fits
+ *  without exceeding the maximum load factor of 3/4
+ */
+template <class Slot>
+static void reserve_one(vector<Slot> & slots, size_t num_elements)
+{
+  if (4 * (num_elements + 1) > 3 * slots.size())
+  {
+    rehash(slots, slots.empty() ? initial_capacity : 2 * slots.size());
+  }
+}
+
+/** removes the entry at idx using backward-shift deletion: later entries
+ *  of the probe sequence are moved into the hole so that no tombstones
+ *  are needed
+ */
+template <class Slot>
+static void erase_slot(vector<Slot> & slots, size_t idx)
+{
+  assert(slots[idx].occupied());
+  size_t mask = slots.size() - 1;
+  size_t hole = idx;
+  size_t next = (hole + 1) & mask;
+  while (slots[next].occupied())
+  {
+    size_t home = home_slot(slots[next].hashval, slots.size());
+    // the entry at next can fill the hole iff its home slot is not
+    // cyclically within (hole, next]
+    if (((next - home) & mask) >= ((next - hole) & mask))
+    {
+      slots[hole] = std::move(slots[next]);
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+  slots[hole].reset();
+}
+
 /* TermHashTable */
 
-TermHashTable::TermHashTable() {}
+TermHashTable::TermHashTable() : num_elements(0) {}
 
 TermHashTable::~TermHashTable() {}
 
-void TermHashTable::insert(const Term & t) { table[t->hash()].insert(t); }
+void TermHashTable::insert(const Term & t)
+{
+  size_t hashval = t->hash();
+  reserve_one(slots, num_elements);
+  size_t idx = find_slot(t, hashval);
+  if (!slots[idx].occupied())
+  {
+    slots[idx].hashval = hashval;
+    slots[idx].term = t;
+    num_elements++;
+  }
+}
 
 bool TermHashTable::contains(const Term & t) const
 {
-  size_t hashval = t->hash();
-  return (table.find(hashval) != table.end()
-          && table.at(hashval).find(t) != table.at(hashval).end());
+  if (!num_elements)
+  {
+    return false;
+  }
+  return slots[find_slot(t, t->hash())].occupied();
 }
 
 bool TermHashTable::lookup(Term & t)
 {
-  if (contains(t))
+  if (!num_elements)
+  {
+    return false;
+  }
+
+  const Slot & slot = slots[find_slot(t, t->hash())];
+  if (slot.occupied())
   {
     // reassign t
     // should destroy the previous Term
     // when reference counter goes to zero
-    t = *(table[t->hash()].find(t));
+    t = slot.term;
     return true;
   }
   return false;
 }
 
+bool TermHashTable::find_or_insert(Term & t)
+{
+  size_t hashval = t->hash();
+  // grow before probing so the slot index stays valid for the insert
+  reserve_one(slots, num_elements);
+  Slot & slot = slots[find_slot(t, hashval)];
+  if (slot.occupied())
+  {
+    t = slot.term;
+    return true;
+  }
+
+  slot.hashval = hashval;
+  slot.term = t;
+  num_elements++;
+  return false;
+}
+
 void TermHashTable::erase(const Term & t)
+{
+  if (!num_elements)
+  {
+    return;
+  }
+
+  size_t idx = find_slot(t, t->hash());
+  if (slots[idx].occupied())
+  {
+    erase_slot(slots, idx);
+    num_elements--;
+  }
+}
+
+void TermHashTable::clear()
+{
+  slots.clear();
+  num_elements = 0;
+}
+
+size_t TermHashTable::find_slot(const Term & t, size_t hashval) const
+{
+  assert(!slots.empty());
+  size_t mask = slots.size() - 1;
+  size_t idx = home_slot(hashval, slots.size());
+  while (true)
+  {
+    const Slot & slot = slots[idx];
+    if (!slot.occupied()
+        || (slot.hashval == hashval
+            && (slot.term.get() == t.get() || slot.term->compare(t))))
+    {
+      return idx;
+    }
+    idx = (idx + 1) & mask;
+  }
+}
+
+/* WeakTermHashTable */
+
+WeakTermHashTable::WeakTermHashTable() : num_elements(0), erased(0) {}
+
+WeakTermHashTable::~WeakTermHashTable() {}
+
+bool WeakTermHashTable::contains(const Term & t) const
+{
+  if (!num_elements)
+  {
+    return false;
+  }
+  return slots[find_slot(t, t->hash())].occupied();
+}
+
+bool WeakTermHashTable::find_or_insert(Term & t)
 {
   size_t hashval = t->hash();
-  if (table.find(hashval) != table.end()
-      && table[hashval].find(t) != table[hashval].end())
+  reserve_one(slots, num_elements);
+  Slot & slot = slots[find_slot(t, hashval)];
+  if (slot.occupied())
+  {
+    // find_slot skips expired entries, so this term is live
+    t = slot.term.lock();
+    assert(t);
+    return true;
+  }
+
+  slot.hashval = hashval;
+  slot.ptr = t.get();
+  slot.term = t;
+  num_elements++;
+  return false;
+}
+
+void WeakTermHashTable::erase(const AbsTerm * t, size_t hashval)
+{
+  if (!num_elements)
   {
-    table[hashval].erase(t);
+    return;
   }
+
+  size_t mask = slots.size() - 1;
+  size_t idx = home_slot(hashval, slots.size());
+  while (slots[idx].occupied())
+  {
+    if (slots[idx].ptr == t)
+    {
+      erase_slot(slots, idx);
+      num_elements--;
+      erased++;
+      return;
+    }
+    idx = (idx + 1) & mask;
+  }
+}
+
+void WeakTermHashTable::clear()
+{
+  slots.clear();
+  num_elements = 0;
 }
 
-void TermHashTable::clear() { table.clear(); }
+size_t WeakTermHashTable::find_slot(const Term & t, size_t hashval) const
+{
+  assert(!slots.empty());
+  size_t mask = slots.size() - 1;
+  size_t idx = home_slot(hashval, slots.size());
+  while (true)
+  {
+    const Slot & slot = slots[idx];
+    // an expired entry belongs to a term that is being destroyed and
+    // hasn't erased itself yet -- ptr must not be dereferenced then
+    if (!slot.occupied()
+        || (slot.hashval == hashval && !slot.term.expired()
+            && (slot.ptr == t.get() || slot.ptr->compare(t))))
+    {
+      return idx;
+    }
+    idx = (idx + 1) & mask;
+  }
+}
 
 }  // namespace smt
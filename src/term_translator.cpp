@@ -23,6 +23,7 @@
 #include "sort_inference.h"
 #include "utils.h"
 #include "term_translator.h"
+#include "trace_recorder.h"
 
 using namespace std;
 
@@ -138,19 +139,76 @@ Sort TermTranslator::transfer_sort(const Sort & sort)
 
 Term TermTranslator::transfer_term(const Term & term)
 {
-  if (cache.find(term) != cache.end())
+  TraceSpan span("transfer_term", "translator", solver->get_solver_enum());
+  stats = Stats();
+  Term res = transfer_native(term);
+  if (res)
   {
-    return cache.at(term);
+    return res;
   }
 
-  TermVec to_visit{ term };
+  to_visit.clear();
+  to_visit.push_back(term);
+  transfer_to_visit();
+  return cache.at(term);
+}
+
+TermVec TermTranslator::transfer_terms(const TermVec & terms)
+{
+  TraceSpan span("transfer_terms", "translator", solver->get_solver_enum());
+  stats = Stats();
+  to_visit.clear();
+  // insert in reverse order so that the roots
+  // (and their symbols) are processed in order
+  for (auto it = terms.rbegin(); it != terms.rend(); ++it)
+  {
+    if (!transfer_native(*it))
+    {
+      to_visit.push_back(*it);
+    }
+  }
+  transfer_to_visit();
+
+  TermVec res;
+  res.reserve(terms.size());
+  for (const auto & t : terms)
+  {
+    res.push_back(cache.at(t));
+  }
+  return res;
+}
+
+Term TermTranslator::transfer_native(const Term & term)
+{
+  if (!source_solver || cache.size() != num_native_entries)
+  {
+    return Term();
+  }
+
+  auto it = cache.find(term);
+  if (it != cache.end())
+  {
+    stats.cache_hits++;
+    return it->second;
+  }
+
+  Term res = solver->translate_native(term, *source_solver);
+  if (res)
+  {
+    cache[term] = res;
+    num_native_entries++;
+    stats.nodes_created++;
+  }
+  return res;
+}
+
+void TermTranslator::transfer_to_visit()
+{
   // better to keep a separate set for visited
   // then if something is in the cache, we can
   // assume it's already been processed
   // not just visited
-  UnorderedTermSet visited;
-  TermVec children;
-  TermVec cached_children;
+  visited.clear();
   Term t;
   Sort s;
   while (to_visit.size())
@@ -162,6 +220,7 @@ Term TermTranslator::transfer_term(const Term & term)
     {
       // cache hit
       // it's already been processed
+      stats.cache_hits++;
       continue;
     }
 
@@ -175,14 +234,22 @@ Term TermTranslator::transfer_term(const Term & term)
       // insert in reverse order
       // helps symbols be declared in same order
       children.clear();
-      children.insert(children.end(), t->begin(), t->end());
+      t->get_children(children);
       for (auto it = children.rbegin(); it != children.rend(); it++)
       {
-        to_visit.push_back(*it);
+        if (cache.find(*it) != cache.end())
+        {
+          stats.cache_hits++;
+        }
+        else
+        {
+          to_visit.push_back(*it);
+        }
       }
     }
     else
     {
+      stats.nodes_created++;
       if (t->is_symbol())
       {
         s = transfer_sort(t->get_sort());
@@ -219,8 +286,8 @@ Term TermTranslator::transfer_term(const Term & term)
         if (s->get_sort_kind() == ARRAY)
         {
           // special case for const-array
-          assert(t->begin() != t->end());
-          Term val = cache.at(*(t->begin()));
+          assert(t->num_children());
+          Term val = cache.at(t->get_child(0));
           Sort valsort = val->get_sort();
           if (s->get_sort_kind() != ARRAY)
           {
@@ -243,12 +310,7 @@ Term TermTranslator::transfer_term(const Term & term)
         }
         else
         {
-          // pass the original sort here
-          // allows us to transfer from a solver that doesn't alias sorts
-          // to one that does alias sorts
-          // the sort will be transferred again in value_from_smt2
-          cache[t] = value_from_smt2(
-              t->print_value_as(t->get_sort()->get_sort_kind()), t->get_sort());
+          cache[t] = transfer_value(t);
         }
       }
       else
@@ -259,9 +321,10 @@ Term TermTranslator::transfer_term(const Term & term)
         assert(!t->get_op().is_null());
 
         cached_children.clear();
-        for (auto c : t)
+        t->get_children(cached_children);
+        for (auto & c : cached_children)
         {
-          cached_children.push_back(cache.at(c));
+          c = cache.at(c);
         }
         assert(cached_children.size());
 
@@ -286,12 +349,6 @@ Term TermTranslator::transfer_term(const Term & term)
       }
     }
   }
-
-  assert(cache.find(term) != cache.end());
-  // make sure the sort is as-expected and cast if not
-  // for dealing with solvers that alias sorts
-
-  return cache.at(term);
 }
 
 Term TermTranslator::transfer_term(const Term & term, const SortKind sk)
@@ -338,6 +395,25 @@ Term TermTranslator::transfer_term(const Term & term, const SortKind sk)
   }
 }
 
+Term TermTranslator::transfer_value(const Term & val)
+{
+  Sort orig_sort = val->get_sort();
+  SortKind sk = orig_sort->get_sort_kind();
+  TermValue tv;
+  if ((sk == BOOL || sk == BV || sk == INT || sk == REAL)
+      && val->export_value(tv))
+  {
+    // import_value casts between Bool and BV1 if the sorts are aliased
+    return solver->import_value(tv, transfer_sort(orig_sort));
+  }
+
+  // pass the original sort here
+  // allows us to transfer from a solver that doesn't alias sorts
+  // to one that does alias sorts
+  // the sort will be transferred again in value_from_smt2
+  return value_from_smt2(val->print_value_as(sk), orig_sort);
+}
+
 std::string TermTranslator::infixize_rational(const std::string smtlib) const {
   // smtlib: (/ up down)
   // ind -- index
@@ -0,0 +1,720 @@
+/*********************                                                        */
+/*! \file term_value.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief A solver-independent representation of value terms.
+**
+**/
+
+#include "term_value.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "assert.h"
+#include "exceptions.h"
+
+using namespace std;
+
+namespace smt {
+
+/* Arithmetic on magnitudes -- vectors of words, least significant first */
+
+typedef vector<uint64_t> Words;
+
+static void trim(Words & w)
+{
+  while (!w.empty() && !w.back())
+  {
+    w.pop_back();
+  }
+}
+
+/** w = w * m + a */
+static void mul_add(Words & w, uint64_t m, uint64_t a)
+{
+  unsigned __int128 carry = a;
+  for (auto & word : w)
+  {
+    carry += (unsigned __int128)word * m;
+    word = (uint64_t)carry;
+    carry >>= 64;
+  }
+  if (carry)
+  {
+    w.push_back((uint64_t)carry);
+  }
+}
+
+/** w = w / d
+ *  @return the remainder
+ */
+static uint64_t div_rem(Words & w, uint64_t d)
+{
+  assert(d);
+  unsigned __int128 rem = 0;
+  for (size_t i = w.size(); i-- > 0;)
+  {
+    rem = (rem << 64) | w[i];
+    w[i] = (uint64_t)(rem / d);
+    rem %= d;
+  }
+  trim(w);
+  return (uint64_t)rem;
+}
+
+static Words mul(const Words & a, const Words & b)
+{
+  if (a.empty() || b.empty())
+  {
+    return Words();
+  }
+  Words res(a.size() + b.size(), 0);
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    unsigned __int128 carry = 0;
+    for (size_t j = 0; j < b.size(); ++j)
+    {
+      carry += (unsigned __int128)a[i] * b[j] + res[i + j];
+      res[i + j] = (uint64_t)carry;
+      carry >>= 64;
+    }
+    res[i + b.size()] = (uint64_t)carry;
+  }
+  trim(res);
+  return res;
+}
+
+static Words parse_digits(const string & s, int base, const string & orig)
+{
+  if (s.empty())
+  {
+    throw IncorrectUsageException("Can't read value from " + orig);
+  }
+  Words w;
+  for (char c : s)
+  {
+    int d;
+    if (c >= '0' && c <= '9')
+    {
+      d = c - '0';
+    }
+    else if (c >= 'a' && c <= 'f')
+    {
+      d = c - 'a' + 10;
+    }
+    else if (c >= 'A' && c <= 'F')
+    {
+      d = c - 'A' + 10;
+    }
+    else
+    {
+      d = base;
+    }
+
+    if (d >= base)
+    {
+      throw IncorrectUsageException("Can't read value from " + orig);
+    }
+    mul_add(w, base, d);
+  }
+  trim(w);
+  return w;
+}
+
+static string words_to_string(Words w, int base)
+{
+  if (w.empty())
+  {
+    return "0";
+  }
+
+  string res;
+  if (base == 10)
+  {
+    // take off 19 decimal digits at a time
+    const uint64_t chunk = 10000000000000000000ULL;
+    while (!w.empty())
+    {
+      uint64_t rem = div_rem(w, chunk);
+      for (size_t i = 0; i < 19 && (rem || !w.empty()); ++i)
+      {
+        res.push_back('0' + rem % 10);
+        rem /= 10;
+      }
+    }
+  }
+  else
+  {
+    assert(base == 2 || base == 16);
+    size_t bits_per_digit = (base == 2) ? 1 : 4;
+    size_t num_bits = 64 * w.size();
+    for (size_t i = 0; i < num_bits; i += bits_per_digit)
+    {
+      uint64_t d = (w[i / 64] >> (i % 64)) & (base - 1);
+      res.push_back("0123456789abcdef"[d]);
+    }
+    while (res.size() > 1 && res.back() == '0')
+    {
+      res.pop_back();
+    }
+  }
+  reverse(res.begin(), res.end());
+  return res;
+}
+
+static string strip(const string & s)
+{
+  size_t start = s.find_first_not_of(" \t\n\r");
+  if (start == string::npos)
+  {
+    return "";
+  }
+  size_t end = s.find_last_not_of(" \t\n\r");
+  return s.substr(start, end - start + 1);
+}
+
+/** splits the arguments of an s-expression "(f a b ...)"
+ *  into top-level tokens, assuming s starts with "(" and ends with ")"
+ */
+static vector<string> sexpr_args(const string & s)
+{
+  vector<string> args;
+  string inner = s.substr(1, s.length() - 2);
+  size_t depth = 0;
+  string cur;
+  for (char c : inner)
+  {
+    if (depth == 0 && (c == ' ' || c == '\t' || c == '\n'))
+    {
+      if (!cur.empty())
+      {
+        args.push_back(cur);
+        cur.clear();
+      }
+      continue;
+    }
+    if (c == '(')
+    {
+      depth++;
+    }
+    else if (c == ')')
+    {
+      depth--;
+    }
+    cur.push_back(c);
+  }
+  if (!cur.empty())
+  {
+    args.push_back(cur);
+  }
+  return args;
+}
+
+static int compare(const Words & a, const Words & b)
+{
+  if (a.size() != b.size())
+  {
+    return a.size() < b.size() ? -1 : 1;
+  }
+  for (size_t i = a.size(); i-- > 0;)
+  {
+    if (a[i] != b[i])
+    {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/** a = a - b, requires a >= b */
+static void sub(Words & a, const Words & b)
+{
+  assert(compare(a, b) >= 0);
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    uint64_t bi = i < b.size() ? b[i] : 0;
+    uint64_t d = a[i] - bi - borrow;
+    borrow = (a[i] < bi || (a[i] - bi) < borrow) ? 1 : 0;
+    a[i] = d;
+  }
+  assert(!borrow);
+  trim(a);
+}
+
+static size_t trailing_zeros(const Words & w)
+{
+  assert(!w.empty());
+  size_t i = 0;
+  while (!w[i])
+  {
+    ++i;
+  }
+  return 64 * i + __builtin_ctzll(w[i]);
+}
+
+static void shift_right(Words & w, size_t n)
+{
+  size_t words = n / 64, bits = n % 64;
+  if (words >= w.size())
+  {
+    w.clear();
+    return;
+  }
+  w.erase(w.begin(), w.begin() + words);
+  if (bits)
+  {
+    for (size_t i = 0; i < w.size(); ++i)
+    {
+      w[i] >>= bits;
+      if (i + 1 < w.size())
+      {
+        w[i] |= w[i + 1] << (64 - bits);
+      }
+    }
+  }
+  trim(w);
+}
+
+static void shift_left(Words & w, size_t n)
+{
+  if (w.empty())
+  {
+    return;
+  }
+  size_t words = n / 64, bits = n % 64;
+  if (bits)
+  {
+    w.push_back(0);
+    for (size_t i = w.size(); i-- > 0;)
+    {
+      w[i] <<= bits;
+      if (i)
+      {
+        w[i] |= w[i - 1] >> (64 - bits);
+      }
+    }
+  }
+  w.insert(w.begin(), words, 0);
+  trim(w);
+}
+
+/** binary gcd of two non-zero magnitudes */
+static Words gcd(Words a, Words b)
+{
+  size_t shift = min(trailing_zeros(a), trailing_zeros(b));
+  shift_right(a, trailing_zeros(a));
+  // invariant: a is odd
+  while (!b.empty())
+  {
+    shift_right(b, trailing_zeros(b));
+    if (compare(a, b) > 0)
+    {
+      swap(a, b);
+    }
+    sub(b, a);
+  }
+  shift_left(a, shift);
+  return a;
+}
+
+/** a = a / d, requires that d divides a */
+static void div_exact(Words & a, const Words & d)
+{
+  if (d.size() == 1)
+  {
+    div_rem(a, d[0]);
+    return;
+  }
+  // shift and subtract, one bit of the quotient at a time
+  Words q, rem;
+  for (size_t i = 64 * a.size(); i-- > 0;)
+  {
+    shift_left(rem, 1);
+    if ((a[i / 64] >> (i % 64)) & 1)
+    {
+      if (rem.empty())
+      {
+        rem.push_back(1);
+      }
+      else
+      {
+        rem[0] |= 1;
+      }
+    }
+    shift_left(q, 1);
+    if (compare(rem, d) >= 0)
+    {
+      sub(rem, d);
+      if (q.empty())
+      {
+        q.push_back(1);
+      }
+      else
+      {
+        q[0] |= 1;
+      }
+    }
+  }
+  assert(rem.empty());
+  a = q;
+}
+
+/** reduces num / den to lowest terms, so equal rationals are
+ *  represented the same way
+ */
+static void reduce(Words & num, Words & den)
+{
+  if (num.empty())
+  {
+    den = { 1 };
+    return;
+  }
+  Words g = gcd(num, den);
+  if (g != Words({ 1 }))
+  {
+    div_exact(num, g);
+    div_exact(den, g);
+  }
+}
+
+/** parses a (possibly negative) rational number
+ *  in any of the formats accepted by TermValue::from_string
+ */
+static void parse_rational(const string & s,
+                           const string & orig,
+                           bool & negative,
+                           Words & num,
+                           Words & den)
+{
+  if (s.size() > 2 && s.front() == '(' && s.back() == ')')
+  {
+    vector<string> args = sexpr_args(s);
+    if (args.size() == 2 && args[0] == "-")
+    {
+      parse_rational(args[1], orig, negative, num, den);
+      negative = !negative && !num.empty();
+      return;
+    }
+    else if (args.size() == 3 && args[0] == "/")
+    {
+      bool neg0, neg1;
+      Words num0, den0, num1, den1;
+      parse_rational(args[1], orig, neg0, num0, den0);
+      parse_rational(args[2], orig, neg1, num1, den1);
+      if (num1.empty())
+      {
+        throw IncorrectUsageException("Division by zero in " + orig);
+      }
+      num = mul(num0, den1);
+      den = mul(den0, num1);
+      negative = (neg0 != neg1) && !num.empty();
+      reduce(num, den);
+      return;
+    }
+    throw IncorrectUsageException("Can't read value from " + orig);
+  }
+
+  if (!s.empty() && s[0] == '-')
+  {
+    parse_rational(strip(s.substr(1)), orig, negative, num, den);
+    negative = !negative && !num.empty();
+    return;
+  }
+
+  size_t slash = s.find('/');
+  if (slash != string::npos)
+  {
+    string fraction = "(/ " + s.substr(0, slash) + " " + s.substr(slash + 1)
+                      + ")";
+    parse_rational(fraction, orig, negative, num, den);
+    return;
+  }
+
+  negative = false;
+  size_t dot = s.find('.');
+  if (dot == string::npos)
+  {
+    num = parse_digits(s, 10, orig);
+    den = { 1 };
+  }
+  else
+  {
+    string frac = s.substr(dot + 1);
+    num = parse_digits(s.substr(0, dot) + frac, 10, orig);
+    den = { 1 };
+    for (size_t i = 0; i < frac.size(); ++i)
+    {
+      mul_add(den, 10, 0);
+    }
+    reduce(num, den);
+  }
+}
+
+TermValue TermValue::make_bool(bool b)
+{
+  TermValue v;
+  v.kind = BOOL;
+  if (b)
+  {
+    v.num.push_back(1);
+  }
+  return v;
+}
+
+TermValue TermValue::make_bv(uint64_t width, uint64_t val)
+{
+  return make_bv(width, Words({ val }));
+}
+
+TermValue TermValue::make_bv(uint64_t width, const vector<uint64_t> & words)
+{
+  if (!width)
+  {
+    throw IncorrectUsageException("Can't make a bit-vector value of width 0");
+  }
+  TermValue v;
+  v.kind = BV;
+  v.width = width;
+  v.num = words;
+  v.num.resize((width + 63) / 64, 0);
+  if (width % 64)
+  {
+    v.num.back() &= (1ULL << (width % 64)) - 1;
+  }
+  return v;
+}
+
+TermValue TermValue::make_int(int64_t i)
+{
+  // avoid overflow on the minimum value
+  uint64_t mag = (i < 0) ? (uint64_t)(-(i + 1)) + 1 : (uint64_t)i;
+  return make_int(i < 0, Words({ mag }));
+}
+
+TermValue TermValue::make_int(bool negative, const vector<uint64_t> & magnitude)
+{
+  TermValue v;
+  v.kind = INT;
+  v.num = magnitude;
+  trim(v.num);
+  v.negative = negative && !v.num.empty();
+  return v;
+}
+
+TermValue TermValue::make_real(int64_t num, uint64_t den)
+{
+  TermValue v = make_int(num);
+  return make_real(v.negative, v.num, Words({ den }));
+}
+
+TermValue TermValue::make_real(bool negative,
+                               const vector<uint64_t> & num,
+                               const vector<uint64_t> & den)
+{
+  TermValue v = make_int(negative, num);
+  v.kind = REAL;
+  v.den = den;
+  trim(v.den);
+  if (v.den.empty())
+  {
+    throw IncorrectUsageException("Can't make a real value with denominator 0");
+  }
+  reduce(v.num, v.den);
+  return v;
+}
+
+TermValue TermValue::from_string(const string & str,
+                                 SortKind sk,
+                                 uint64_t width)
+{
+  string s = strip(str);
+
+  if (sk == BOOL)
+  {
+    if (s == "true" || s == "false")
+    {
+      return make_bool(s == "true");
+    }
+    // solvers that alias Bool and (_ BitVec 1)
+    return make_bool(from_string(s, BV, 1).get_bool());
+  }
+  else if (sk == BV)
+  {
+    if (s == "true" || s == "false")
+    {
+      return make_bv(1, s == "true");
+    }
+
+    string prefix = s.substr(0, 2);
+    Words w;
+    if (prefix == "#b")
+    {
+      w = parse_digits(s.substr(2), 2, str);
+      width = width ? width : s.length() - 2;
+    }
+    else if (prefix == "#x")
+    {
+      w = parse_digits(s.substr(2), 16, str);
+      width = width ? width : 4 * (s.length() - 2);
+    }
+    else if (prefix == "(_")
+    {
+      vector<string> args = sexpr_args(s);
+      if (args.size() != 3 || args[1].substr(0, 2) != "bv")
+      {
+        throw IncorrectUsageException("Can't read " + str
+                                      + " as a bit-vector value.");
+      }
+      w = parse_digits(args[1].substr(2), 10, str);
+      width = width ? width : stoull(args[2]);
+    }
+    else
+    {
+      w = parse_digits(s, 10, str);
+    }
+    return make_bv(width, w);
+  }
+  else if (sk == INT || sk == REAL)
+  {
+    bool negative;
+    Words num, den;
+    parse_rational(s, str, negative, num, den);
+    if (sk == REAL)
+    {
+      return make_real(negative, num, den);
+    }
+    else if (den != Words({ 1 }))
+    {
+      throw IncorrectUsageException("Can't read " + str
+                                    + " as an integer value.");
+    }
+    return make_int(negative, num);
+  }
+
+  throw NotImplementedException("TermValue doesn't support values of sort "
+                                + ::smt::to_string(sk));
+}
+
+bool TermValue::num_fits_int64() const
+{
+  if (num.size() > 1)
+  {
+    return false;
+  }
+  uint64_t max = numeric_limits<int64_t>::max();
+  return get_uint64() <= (negative ? max + 1 : max);
+}
+
+bool TermValue::den_fits_int64() const
+{
+  return den.size() == 1
+         && den[0] <= (uint64_t)numeric_limits<int64_t>::max();
+}
+
+int64_t TermValue::get_int64() const
+{
+  assert(num_fits_int64());
+  uint64_t mag = get_uint64();
+  return negative ? -(int64_t)(mag - 1) - 1 : (int64_t)mag;
+}
+
+int64_t TermValue::get_den_int64() const
+{
+  assert(den_fits_int64());
+  return (int64_t)den[0];
+}
+
+string TermValue::num_to_string(int base) const
+{
+  if (base != 2 && base != 10 && base != 16)
+  {
+    throw IncorrectUsageException("Unsupported base " + std::to_string(base));
+  }
+  string res = words_to_string(num, base);
+  if (kind == BV && base == 2 && res.length() < width)
+  {
+    res = string(width - res.length(), '0') + res;
+  }
+  return res;
+}
+
+string TermValue::den_to_string() const { return words_to_string(den, 10); }
+
+string TermValue::to_string() const
+{
+  string res;
+  if (kind == BOOL)
+  {
+    return get_bool() ? "true" : "false";
+  }
+  else if (kind == BV)
+  {
+    return "#b" + num_to_string(2);
+  }
+  else if (kind == INT)
+  {
+    res = num_to_string();
+  }
+  else if (kind == REAL)
+  {
+    res = num_to_string() + ".0";
+    if (den != Words({ 1 }))
+    {
+      res = "(/ " + res + " " + den_to_string() + ".0)";
+    }
+  }
+  else
+  {
+    return "null";
+  }
+
+  return negative ? "(- " + res + ")" : res;
+}
+
+size_t TermValue::hash() const
+{
+  // boost::hash_combine
+  size_t h = std::hash<int>()(kind) ^ std::hash<uint64_t>()(width);
+  auto combine = [&h](uint64_t w) {
+    h ^= std::hash<uint64_t>()(w) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  };
+  combine(negative);
+  for (auto w : num)
+  {
+    combine(w);
+  }
+  for (auto w : den)
+  {
+    combine(w);
+  }
+  return h;
+}
+
+bool operator==(const TermValue & v1, const TermValue & v2)
+{
+  return v1.kind == v2.kind && v1.width == v2.width
+         && v1.negative == v2.negative && v1.num == v2.num
+         && v1.den == v2.den;
+}
+
+bool operator!=(const TermValue & v1, const TermValue & v2)
+{
+  return !(v1 == v2);
+}
+
+std::ostream & operator<<(std::ostream & output, const TermValue & v)
+{
+  output << v.to_string();
+  return output;
+}
+
+}  // namespace smt
@@ -0,0 +1,218 @@
+/*********************                                                        */
+/*! \file trace_recorder.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Records spans of solver activity as Chrome trace events, which
+**        can be viewed with chrome://tracing or Perfetto.
+**
+**/
+
+#include "trace_recorder.h"
+
+#include <iomanip>
+
+#include "exceptions.h"
+
+using namespace std;
+
+namespace smt {
+
+// number of spans per thread that can wait for the writer,
+// must be a power of two
+const uint64_t RING_CAPACITY = 4096;
+
+// how often the writer thread flushes the rings
+const std::chrono::milliseconds FLUSH_INTERVAL(100);
+
+/** Single-producer single-consumer ring of spans
+ *  The owning thread advances head, the writer advances tail.
+ */
+struct TraceRecorder::ThreadBuffer
+{
+  ThreadBuffer(uint64_t id) : tid(id), slots(RING_CAPACITY), head(0), tail(0)
+  {
+  }
+
+  const uint64_t tid;  ///< thread id shown in the trace
+  vector<TraceEvent> slots;
+  std::atomic<uint64_t> head;
+  std::atomic<uint64_t> tail;
+};
+
+TraceRecorder & TraceRecorder::get()
+{
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : started(false),
+      num_dropped(0),
+      next_tid(1),
+      first_event(true),
+      stop_writer(false)
+{
+}
+
+TraceRecorder::~TraceRecorder() { stop(); }
+
+void TraceRecorder::start(const string & filename)
+{
+  lock_guard<mutex> lk(write_mutex);
+  if (started)
+  {
+    throw IncorrectUsageException("TraceRecorder is already started");
+  }
+  out.open(filename, ios::out | ios::trunc);
+  if (!out)
+  {
+    throw IncorrectUsageException("Could not open trace file " + filename);
+  }
+  // timestamps are in microseconds with nanosecond precision
+  out << fixed << setprecision(3);
+  out << "{\"traceEvents\": [" << endl;
+  first_event = true;
+  num_dropped = 0;
+  origin = std::chrono::steady_clock::now();
+
+  {
+    // discard spans left over from an earlier recording
+    lock_guard<mutex> blk(buffers_mutex);
+    for (auto & b : buffers)
+    {
+      b->tail.store(b->head.load(memory_order_acquire),
+                    memory_order_release);
+    }
+  }
+
+  stop_writer = false;
+  writer = std::thread(&TraceRecorder::run, this);
+  started = true;
+}
+
+void TraceRecorder::stop()
+{
+  {
+    lock_guard<mutex> lk(write_mutex);
+    if (!started)
+    {
+      return;
+    }
+    started = false;
+    stop_writer = true;
+  }
+  cv.notify_all();
+  writer.join();
+
+  lock_guard<mutex> lk(write_mutex);
+  flush();
+  out << endl << "], \"displayTimeUnit\": \"ms\"}" << endl;
+  out.close();
+}
+
+void TraceRecorder::record(const TraceEvent & e)
+{
+  if (!is_started())
+  {
+    return;
+  }
+  ThreadBuffer & b = thread_buffer();
+  uint64_t h = b.head.load(memory_order_relaxed);
+  if (h - b.tail.load(memory_order_acquire) >= RING_CAPACITY)
+  {
+    num_dropped++;
+    return;
+  }
+  b.slots[h & (RING_CAPACITY - 1)] = e;
+  b.head.store(h + 1, memory_order_release);
+}
+
+TraceRecorder::ThreadBuffer & TraceRecorder::thread_buffer()
+{
+  // the registry keeps the buffer alive after the thread exits,
+  // until its remaining spans are flushed
+  thread_local shared_ptr<ThreadBuffer> local;
+  if (!local)
+  {
+    lock_guard<mutex> lk(buffers_mutex);
+    local = make_shared<ThreadBuffer>(next_tid++);
+    buffers.push_back(local);
+  }
+  return *local;
+}
+
+void TraceRecorder::flush()
+{
+  vector<shared_ptr<ThreadBuffer>> to_flush;
+  {
+    lock_guard<mutex> lk(buffers_mutex);
+    to_flush = buffers;
+  }
+
+  for (auto & b : to_flush)
+  {
+    uint64_t t = b->tail.load(memory_order_relaxed);
+    uint64_t h = b->head.load(memory_order_acquire);
+    for (; t < h; ++t)
+    {
+      const TraceEvent & e = b->slots[t & (RING_CAPACITY - 1)];
+      if (e.start < origin)
+      {
+        // started before this recording
+        continue;
+      }
+      out << (first_event ? "" : ",\n") << "{\"name\": \"" << e.name
+          << "\", \"cat\": \"" << e.category << "\", \"ph\": \"X\", \"ts\": "
+          << std::chrono::duration<double, micro>(e.start - origin).count()
+          << ", \"dur\": "
+          << std::chrono::duration<double, micro>(e.end - e.start).count()
+          << ", \"pid\": 1, \"tid\": " << b->tid << ", \"args\": {\"solver\": \""
+          << e.solver << "\"";
+      if (e.arg >= 0)
+      {
+        out << ", \"index\": " << e.arg;
+      }
+      out << "}}";
+      first_event = false;
+    }
+    b->tail.store(h, memory_order_release);
+  }
+  to_flush.clear();
+  out.flush();
+
+  // forget the buffers of threads that have exited
+  lock_guard<mutex> lk(buffers_mutex);
+  auto it = buffers.begin();
+  while (it != buffers.end())
+  {
+    if (it->use_count() == 1
+        && (*it)->head.load(memory_order_acquire)
+               == (*it)->tail.load(memory_order_relaxed))
+    {
+      it = buffers.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void TraceRecorder::run()
+{
+  unique_lock<mutex> lk(write_mutex);
+  while (!stop_writer)
+  {
+    cv.wait_for(lk, FLUSH_INTERVAL, [this]() { return stop_writer; });
+    flush();
+  }
+}
+
+}  // namespace smt
@@ -1,5 +1,6 @@
 #include "tree_walker.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -18,6 +19,11 @@ pair<Term, vector<int>> TreeWalker::visit(Term & node)
   if (clear_cache_)
   {
     cache_.clear();
+    id_cache_.clear();
+    compact_cache_.clear();
+    compact_id_cache_.clear();
+    occurrences_.clear();
+    num_referenced_occurrences_ = 0;
 
     if (ext_cache_)
     {
@@ -37,6 +43,29 @@ pair<Term, vector<int>> TreeWalker::visit(Term & node)
     return out;
   }
 
+  // resets the current occurrence when the traversal ends, even if
+  // visit_term throws, and drops the occurrences no cache entry refers to
+  struct CurrentOccurrenceGuard
+  {
+    TreeWalker & walker;
+    ~CurrentOccurrenceGuard()
+    {
+      walker.current_formula_ = nullptr;
+      walker.current_path_ = nullptr;
+      walker.current_occurrence_ = no_parent;
+      // parents come before their children, so this keeps the
+      // complete paths of all referenced occurrences
+      walker.occurrences_.resize(walker.num_referenced_occurrences_);
+    }
+  } guard{ *this };
+  current_formula_ = &node;
+  current_path_ = &tree_path;
+  if (compact())
+  {
+    current_occurrence_ = occurrences_.size();
+    occurrences_.push_back({ no_parent, -1 });
+  }
+
   // visit top node (tree_path currently empty)
   visit_term(node, node, tree_path);
   /* to_visit is used to store terms left to visit & is a vector of pairs, where
@@ -60,9 +89,10 @@ pair<Term, vector<int>> TreeWalker::visit(Term & node)
   // initialize child_no before starting the loop
   child_no = 0;
   // push_back all of topmost node's children to prepare for the loop
-  for (auto ttt : node)
+  size_t num_children = node->num_children();
+  for (size_t i = 0; i < num_children; ++i)
   {
-    p1.first = ttt;
+    p1.first = node->get_child(i);
     p1.second = child_no;
     to_visit.push_back(p1);
     child_no++;
@@ -92,6 +122,12 @@ pair<Term, vector<int>> TreeWalker::visit(Term & node)
       // child number for a term gives the last index in treepath, which is a
       // list of child numbers creating a numbered path for an occurrence
       tree_path.push_back(child_no);
+      if (compact())
+      {
+        // record the occurrence as a link to its parent occurrence
+        occurrences_.push_back({ current_occurrence_, child_no });
+        current_occurrence_ = occurrences_.size() - 1;
+      }
       // visit current_term
       visit_term(node, current_term, tree_path);
       // push back new pair with the flag -1 to indicate that it has already
@@ -104,9 +140,10 @@ pair<Term, vector<int>> TreeWalker::visit(Term & node)
       child_no = 0;
       // push back all children of current_term we will need to visit before
       // popping all the way back to the current, parent term with the -1 flag
-      for (auto tt : current_term)
+      num_children = current_term->num_children();
+      for (size_t i = 0; i < num_children; ++i)
       {
-        pn.first = tt;
+        pn.first = current_term->get_child(i);
         pn.second = child_no;
         to_visit.push_back(pn);
         child_no++;
@@ -122,6 +159,10 @@ pair<Term, vector<int>> TreeWalker::visit(Term & node)
       {
         tree_path.pop_back();
       }
+      if (compact())
+      {
+        current_occurrence_ = occurrences_[current_occurrence_].parent;
+      }
     }
   }
 
@@ -140,14 +181,16 @@ TreeWalkerStepResult TreeWalker::visit_term(Term & formula,
   // the formula to a pair giving the full formula in which it occurs and the
   // path indicating its place in the formula
 
-  // occurrence of the term represented by the formula in which it is found and
-  // the path indicating its placement in the formula
-  pair<Term, vector<int>> occ;
-  occ.first = formula;
-  occ.second = path;
   // save mapping from term we're visiting to the pair containing the formula it
   // occurs in and its path indicating its place in the formula
-  save_in_cache(term, occ);
+  if (current_formula_ == &formula && current_path_ == &path)
+  {
+    save_current_occurrence_in_cache(term);
+  }
+  else
+  {
+    save_in_cache(term, { formula, path });
+  }
 
   return TreeWalker_Continue;
 }
@@ -158,6 +201,16 @@ bool TreeWalker::in_cache(const Term & key) const
   {
     return ext_cache_->find(key) != ext_cache_->end();
   }
+  else if (compact())
+  {
+    return cache_kind_ == ID_CACHE
+               ? compact_id_cache_.contains(key)
+               : compact_cache_.find(key) != compact_cache_.end();
+  }
+  else if (cache_kind_ == ID_CACHE)
+  {
+    return id_cache_.contains(key);
+  }
   else
   {
     return cache_.find(key) != cache_.end();
@@ -176,6 +229,35 @@ bool TreeWalker::query_cache(const Term & key,
       return true;
     }
   }
+  else if (compact())
+  {
+    const CompactEntry * entry = nullptr;
+    if (cache_kind_ == ID_CACHE)
+    {
+      entry = compact_id_cache_.find(key);
+    }
+    else
+    {
+      auto it = compact_cache_.find(key);
+      entry = it != compact_cache_.end() ? &it->second : nullptr;
+    }
+    if (entry)
+    {
+      // only materialize the path when it's asked for
+      out.first = entry->formula;
+      get_path(entry->occurrence, out.second);
+      return true;
+    }
+  }
+  else if (cache_kind_ == ID_CACHE)
+  {
+    const pair<Term, vector<int>> * val = id_cache_.find(key);
+    if (val)
+    {
+      out = *val;
+      return true;
+    }
+  }
   else
   {
     auto it = cache_.find(key);
@@ -195,9 +277,79 @@ void TreeWalker::save_in_cache(const Term & key,
   {
     (*ext_cache_)[key] = val;
   }
+  else if (compact())
+  {
+    // reuse the current occurrence if possible
+    // otherwise, the path gets its own occurrences
+    size_t occurrence = (current_formula_ && val.first == *current_formula_
+                         && val.second == *current_path_)
+                            ? current_occurrence_
+                            : add_path(val.second);
+    save_compact_entry(key, { val.first, occurrence });
+  }
+  else if (cache_kind_ == ID_CACHE)
+  {
+    id_cache_[key] = val;
+  }
   else
   {
     cache_[key] = val;
   }
 }
+
+void TreeWalker::save_current_occurrence_in_cache(const Term & key)
+{
+  if (!current_formula_)
+  {
+    throw IncorrectUsageException(
+        "Can only save the current occurrence during a call to visit");
+  }
+
+  if (compact())
+  {
+    save_compact_entry(key, { *current_formula_, current_occurrence_ });
+  }
+  else
+  {
+    save_in_cache(key, { *current_formula_, *current_path_ });
+  }
+}
+
+size_t TreeWalker::add_path(const vector<int> & path)
+{
+  occurrences_.push_back({ no_parent, -1 });
+  for (auto child_no : path)
+  {
+    occurrences_.push_back({ occurrences_.size() - 1, child_no });
+  }
+  return occurrences_.size() - 1;
+}
+
+void TreeWalker::get_path(size_t occurrence, vector<int> & out) const
+{
+  out.clear();
+  while (occurrences_[occurrence].parent != no_parent)
+  {
+    out.push_back(occurrences_[occurrence].child_no);
+    occurrence = occurrences_[occurrence].parent;
+  }
+  // collected from the occurrence up to the topmost node
+  reverse(out.begin(), out.end());
+}
+
+void TreeWalker::save_compact_entry(const Term & key,
+                                    const CompactEntry & entry)
+{
+  num_referenced_occurrences_ =
+      max(num_referenced_occurrences_, entry.occurrence + 1);
+  if (cache_kind_ == ID_CACHE)
+  {
+    compact_id_cache_[key] = entry;
+  }
+  else
+  {
+    compact_cache_[key] = entry;
+  }
+}
+
 }  // namespace smt
@@ -44,9 +44,7 @@ void op_partition(smt::PrimOp o,
       smt::Op op = t->get_op();
       if (op.prim_op == o) {
         // add children to queue
-        for (auto tt : t) {
-          to_visit.push_back(tt);
-        }
+        t->get_children(to_visit);
       } else {
         out.push_back(t);
       }
@@ -131,9 +129,7 @@ void get_matching_terms(const smt::Term & term,
       }
       else
       {  // add children to queue
-        for (auto tt : t) {
-          to_visit.push_back(tt);
-        }
+        t->get_children(to_visit);
       }
     }
   }
@@ -168,14 +164,184 @@ void get_ops(const smt::Term & term, smt::UnorderedOpSet & out)
       if (!op.is_null()) {
         out.insert(t->get_op());
         // add children to queue
-        for (auto tt : t) {
-          to_visit.push_back(tt);
-        }
+        t->get_children(to_visit);
+      }
+    }
+  }
+}
+
+/* TermDag versions */
+
+// the indices of the nodes in the partition
+static void op_partition_nodes(smt::PrimOp o,
+                               const TermDag & dag,
+                               size_t root,
+                               std::vector<size_t> & out)
+{
+  // same traversal order as op_partition
+  std::vector<size_t> to_visit({ root });
+  std::vector<bool> visited(dag.size(), false);
+
+  size_t i;
+  while (to_visit.size())
+  {
+    i = to_visit.back();
+    to_visit.pop_back();
+
+    if (!visited[i])
+    {
+      visited[i] = true;
+
+      if (dag.get_op(i).prim_op == o)
+      {
+        // add children to queue
+        to_visit.insert(
+            to_visit.end(), dag.children_begin(i), dag.children_end(i));
+      }
+      else
+      {
+        out.push_back(i);
+      }
+    }
+  }
+}
+
+void op_partition(smt::PrimOp o,
+                  const TermDag & dag,
+                  size_t root,
+                  smt::TermVec & out)
+{
+  std::vector<size_t> nodes;
+  op_partition_nodes(o, dag, root, nodes);
+  for (auto i : nodes)
+  {
+    out.push_back(dag.get_term(i));
+  }
+}
+
+// shared implementation of conjunctive and disjunctive partition
+static void bool_partition(smt::PrimOp o,
+                           smt::PrimOp bv_o,
+                           const TermDag & dag,
+                           size_t root,
+                           smt::TermVec & out,
+                           bool include_bv)
+{
+  std::vector<size_t> nodes;
+  op_partition_nodes(o, dag, root, nodes);
+  if (!include_bv)
+  {
+    for (auto i : nodes)
+    {
+      out.push_back(dag.get_term(i));
+    }
+    return;
+  }
+
+  std::vector<size_t> bv_nodes;
+  Sort sort;
+  for (auto i : nodes)
+  {
+    sort = dag.get_sort(i);
+    if (sort->get_sort_kind() == BV && sort->get_width() == 1)
+    {
+      bv_nodes.clear();
+      op_partition_nodes(bv_o, dag, i, bv_nodes);
+      for (auto j : bv_nodes)
+      {
+        out.push_back(dag.get_term(j));
+      }
+    }
+    else
+    {
+      out.push_back(dag.get_term(i));
+    }
+  }
+}
+
+void conjunctive_partition(const TermDag & dag,
+                           size_t root,
+                           smt::TermVec & out,
+                           bool include_bvand)
+{
+  bool_partition(smt::And, smt::BVAnd, dag, root, out, include_bvand);
+}
+
+void disjunctive_partition(const TermDag & dag,
+                           size_t root,
+                           smt::TermVec & out,
+                           bool include_bvor)
+{
+  bool_partition(smt::Or, smt::BVOr, dag, root, out, include_bvor);
+}
+
+void get_matching_terms(const TermDag & dag,
+                        size_t root,
+                        smt::UnorderedTermSet & out,
+                        bool (*matching_fun)(const TermDag & dag, size_t i))
+{
+  std::vector<size_t> to_visit({ root });
+  std::vector<bool> visited(dag.size(), false);
+
+  size_t i;
+  while (to_visit.size())
+  {
+    i = to_visit.back();
+    to_visit.pop_back();
+
+    if (!visited[i])
+    {
+      visited[i] = true;
+
+      if (matching_fun(dag, i))
+      {
+        out.insert(dag.get_term(i));
+      }
+      else
+      {
+        // add children to queue
+        to_visit.insert(
+            to_visit.end(), dag.children_begin(i), dag.children_end(i));
       }
     }
   }
 }
 
+void get_free_symbolic_consts(const TermDag & dag, smt::UnorderedTermSet & out)
+{
+  for (size_t i = 0; i < dag.size(); ++i)
+  {
+    if (dag.is_symbolic_const(i))
+    {
+      out.insert(dag.get_term(i));
+    }
+  }
+}
+
+void get_free_symbols(const TermDag & dag, smt::UnorderedTermSet & out)
+{
+  for (size_t i = 0; i < dag.size(); ++i)
+  {
+    if (dag.is_symbol(i))
+    {
+      out.insert(dag.get_term(i));
+    }
+  }
+}
+
+void get_ops(const TermDag & dag, smt::UnorderedOpSet & out)
+{
+  for (size_t i = 0; i < dag.size(); ++i)
+  {
+    // Only add non-null operators to the set
+    const Op & op = dag.get_op(i);
+    if (!op.is_null())
+    {
+      out.insert(op);
+    }
+  }
+}
+
 bool is_lit(const Term & l, const Sort & boolsort)
 {
   // take a boolsort as an argument for sort aliasing solvers
@@ -224,10 +390,7 @@ void cnf_to_dimacs(Term cnf, std::ostringstream & y)
     assert(op.is_null() || op == smt::Or || op == smt::And || op == smt::Not);
     if (op.prim_op == smt::And)
     {
-      for (auto u : t)
-      {
-        before_and_elimination.push_back(u);
-      }
+      t->get_children(before_and_elimination);
     }
     else
     {
@@ -252,10 +415,7 @@ void cnf_to_dimacs(Term cnf, std::ostringstream & y)
 
       if(op.prim_op == smt::Or)
       {
-        for(auto u : t)
-        {
-          before_or_elimination.push_back(u);
-        }
+        t->get_children(before_or_elimination);
       }
       else
       {
@@ -769,10 +929,7 @@ bool is_cnf(Term formula)
     smt::Op op = t->get_op();
     if (op.prim_op == smt::And)
     {
-      for (auto u : t)
-      {
-        before_and_elimination.push_back(u);
-      }
+      t->get_children(before_and_elimination);
     }
     else
     {
@@ -791,10 +948,7 @@ bool is_cnf(Term formula)
       smt::Op op = t->get_op();
       if (op.prim_op == smt::Or)
       {
-        for (auto u : t)
-        {
-          before_or_elimination.push_back(u);
-        }
+        t->get_children(before_or_elimination);
       }
       else
       {
@@ -55,6 +55,33 @@ TEST_P(BVTests, to_int)
 
 }
 
+TEST_P(BVTests, GetValues)
+{
+  Sort bvsort = s->make_sort(BV, 8);
+  TermVec syms;
+  for (int i = 0; i < 10; ++i)
+  {
+    Term x = s->make_symbol("x" + std::to_string(i), bvsort);
+    s->assert_formula(s->make_term(Equal, x, s->make_term(3 * i, bvsort)));
+    syms.push_back(x);
+  }
+  Term y = s->make_term(BVAdd, syms[1], syms[2]);
+  syms.push_back(y);
+  ASSERT_TRUE(s->check_sat().is_sat());
+
+  // values are appended
+  Term b = s->make_term(true);
+  TermVec vals({ b });
+  s->get_values(syms, vals);
+  ASSERT_EQ(vals.size(), syms.size() + 1);
+  ASSERT_EQ(vals[0], b);
+  for (size_t i = 0; i < syms.size(); ++i)
+  {
+    ASSERT_EQ(vals[i + 1], s->get_value(syms[i]));
+  }
+  ASSERT_EQ(vals.back()->to_int(), 9);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedSolverBVTests,
     BVTests,
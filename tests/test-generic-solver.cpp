@@ -40,6 +40,11 @@
 using namespace smt;
 using namespace std;
 
+// whether the solvers created by new_* use the pipelined mode
+// and let terms
+bool pipelined = false;
+bool use_let_terms = false;
+
 void test_bad_cmd(SmtSolver gs)
 {
   cout << "trying a bad command:" << endl;
@@ -53,6 +58,32 @@ void test_bad_cmd(SmtSolver gs)
   }
 }
 
+// in pipelined mode, a failing command is only queued, and its error
+// is read together with the reply of a later command.
+// The error must name the queued command.
+void test_queued_bad_cmd(SmtSolver gs)
+{
+  cout << "trying a bad command before check-sat:" << endl;
+  bool caught = false;
+  try
+  {
+    gs->set_opt("iiiaaaaiiiiaaaa", "aaa");
+    gs->check_sat();
+  }
+  catch (IncorrectUsageException & e)
+  {
+    string msg = e.what();
+    cout << "caught the exception: " << msg << endl;
+    assert(msg.find("iiiaaaaiiiiaaaa") != string::npos);
+    assert(msg.find("check-sat") == string::npos);
+    caught = true;
+  }
+  assert(caught);
+  // the replies are still in sync with the commands
+  Result r = gs->check_sat();
+  assert(r.is_sat());
+}
+
 void test_uf_1(SmtSolver gs)
 {
   Sort s = gs->make_sort("S", 0);
@@ -572,6 +603,85 @@ void test_unsat_assumptions(SmtSolver gs)
   gs->pop(1);
 }
 
+// if set, the commands that the solvers created by new_* receive
+// are also written to this file, one per line
+string input_log;
+
+SmtSolver new_generic_solver(string path,
+                             vector<string> args,
+                             int buffer_size)
+{
+  if (!input_log.empty())
+  {
+    // each line is written to the log before the solver reads it
+    ofstream(input_log, ios::trunc);
+    string cmd = "exec " + path;
+    for (const string & a : args)
+    {
+      cmd += " " + a;
+    }
+    args = { "-c",
+             "while IFS= read -r l; do printf '%s\\n' \"$l\" >> " + input_log
+                 + "; printf '%s\\n' \"$l\"; done | " + cmd };
+    path = "/bin/sh";
+  }
+  return std::make_shared<GenericSolver>(
+      path, args, buffer_size, buffer_size, pipelined, use_let_terms);
+}
+
+// checks the commands that are sent with let terms:
+// a subterm that is referenced twice is bound once with a let,
+// and a definition made in a popped context is not used after the pop
+void test_let_terms(SmtSolver gs)
+{
+  Sort bv_sort = gs->make_sort(BV, 8);
+  Term x = gs->make_symbol("x", bv_sort);
+  Term y = gs->make_symbol("y", bv_sort);
+  Term sum = gs->make_term(BVAdd, x, y);
+
+  gs->push(1);
+  gs->assert_formula(gs->make_term(Equal, gs->make_term(BVMul, sum, sum), x));
+  // sum was sent before, so it is defined now
+  gs->assert_formula(gs->make_term(Equal, sum, y));
+  Result r = gs->check_sat();
+  assert(r.is_sat());
+  gs->pop(1);
+  // the definition of sum is gone, it is sent again.
+  // The solver fails if its old name is used.
+  gs->assert_formula(gs->make_term(Distinct, sum, x));
+  r = gs->check_sat();
+  assert(r.is_sat());
+
+  ifstream log(input_log);
+  string line;
+  size_t num_lets = 0;
+  size_t defs_before_pop = 0;
+  size_t defs_after_pop = 0;
+  bool popped = false;
+  while (getline(log, line))
+  {
+    cout << "sent: " << line << endl;
+    size_t first = line.find("(bvadd |x| |y|)");
+    bool has_sum = first != string::npos;
+    if (line.find("(let (") != string::npos)
+    {
+      num_lets++;
+      // bound once, and referenced by name
+      assert(has_sum);
+      assert(line.find("(bvadd |x| |y|)", first + 1) == string::npos);
+    }
+    else if (has_sum && line.find("(define-fun ") == 0)
+    {
+      (popped ? defs_after_pop : defs_before_pop)++;
+    }
+    popped = popped || line == "(pop 1)";
+  }
+  assert(num_lets == 1);
+  assert(defs_before_pop == 1);
+  assert(defs_after_pop == 1);
+  std::remove(input_log.c_str());
+}
+
 void init_solver(SmtSolver gs)
 {
   gs->set_opt("produce-models", "true");
@@ -585,7 +695,7 @@ void new_btor(SmtSolver & gs, int buffer_size)
   string path = (STRFY(BTOR_HOME));
   path += "/build/bin/boolector";
   vector<string> args = { "--incremental" };
-  gs = std::make_shared<GenericSolver>(path, args, buffer_size, buffer_size);
+  gs = new_generic_solver(path, args, buffer_size);
   init_solver(gs);
 }
 
@@ -595,7 +705,7 @@ void new_msat(SmtSolver & gs, int buffer_size)
   string path = (STRFY(MSAT_HOME));
   path += "/bin/mathsat";
   vector<string> args = { "" };
-  gs = std::make_shared<GenericSolver>(path, args, buffer_size, buffer_size);
+  gs = new_generic_solver(path, args, buffer_size);
   init_solver(gs);
 }
 
@@ -605,7 +715,7 @@ void new_yices2(SmtSolver & gs, int buffer_size)
   string path = (STRFY(YICES2_HOME));
   path += "/build/bin/yices_smt2";
   vector<string> args = { "--incremental" };
-  gs = std::make_shared<GenericSolver>(path, args, buffer_size, buffer_size);
+  gs = new_generic_solver(path, args, buffer_size);
   init_solver(gs);
 }
 
@@ -615,7 +725,7 @@ void new_cvc5(SmtSolver & gs, int buffer_size)
   string path = (STRFY(CVC5_HOME));
   path += "/build/bin/cvc5";
   vector<string> args = { "--lang=smt2", "--incremental", "--dag-thresh=0" };
-  gs = std::make_shared<GenericSolver>(path, args, buffer_size, buffer_size);
+  gs = new_generic_solver(path, args, buffer_size);
   init_solver(gs);
 }
 
@@ -633,6 +743,9 @@ void test_msat(int buffer_size)
   new_msat(gs, buffer_size);
   test_bad_cmd(gs);
 
+  new_msat(gs, buffer_size);
+  test_queued_bad_cmd(gs);
+
   new_msat(gs, buffer_size);
   test_uf_1(gs);
 
@@ -689,6 +802,14 @@ void test_msat(int buffer_size)
 
   new_msat(gs, buffer_size);
   test_unsat_assumptions(gs);
+
+  if (use_let_terms)
+  {
+    input_log = "test-generic-solver-input.smt2";
+    new_msat(gs, buffer_size);
+    test_let_terms(gs);
+    input_log.clear();
+  }
 }
 
 void test_yices2(int buffer_size)
@@ -699,6 +820,9 @@ void test_yices2(int buffer_size)
   new_yices2(gs, buffer_size);
   test_bad_cmd(gs);
 
+  new_yices2(gs, buffer_size);
+  test_queued_bad_cmd(gs);
+
   new_yices2(gs, buffer_size);
   test_bad_term_1(gs);
 
@@ -758,6 +882,14 @@ void test_yices2(int buffer_size)
 
   new_yices2(gs, buffer_size);
   test_unsat_assumptions(gs);
+
+  if (use_let_terms)
+  {
+    input_log = "test-generic-solver-input.smt2";
+    new_yices2(gs, buffer_size);
+    test_let_terms(gs);
+    input_log.clear();
+  }
 }
 
 void test_cvc5(int buffer_size)
@@ -784,6 +916,9 @@ void test_cvc5(int buffer_size)
   new_cvc5(gs, buffer_size);
   test_bad_cmd(gs);
 
+  new_cvc5(gs, buffer_size);
+  test_queued_bad_cmd(gs);
+
   new_cvc5(gs, buffer_size);
   test_bool_1(gs);
 
@@ -831,6 +966,14 @@ void test_cvc5(int buffer_size)
 
   new_cvc5(gs, buffer_size);
   test_unsat_assumptions(gs);
+
+  if (use_let_terms)
+  {
+    input_log = "test-generic-solver-input.smt2";
+    new_cvc5(gs, buffer_size);
+    test_let_terms(gs);
+    input_log.clear();
+  }
 }
 
 void test_btor(int buffer_size)
@@ -847,6 +990,9 @@ void test_btor(int buffer_size)
   new_btor(gs, buffer_size);
   test_bad_cmd(gs);
 
+  new_btor(gs, buffer_size);
+  test_queued_bad_cmd(gs);
+
   new_btor(gs, buffer_size);
   test_bool_1(gs);
 
@@ -882,6 +1028,14 @@ void test_btor(int buffer_size)
 
   new_btor(gs, buffer_size);
   test_unsat_assumptions(gs);
+
+  if (use_let_terms)
+  {
+    input_log = "test-generic-solver-input.smt2";
+    new_btor(gs, buffer_size);
+    test_let_terms(gs);
+    input_log.clear();
+  }
 }
 
 void test_binary(string path, vector<string> args)
@@ -909,10 +1063,10 @@ int main() {
 
   // general tests for all supported functions
   // we test a representative set of buffer sizes,
-  // including smallest and biggest supported,
+  // including very small and large ones,
   // and a mixture of powers of two and non-powers
   // of two.
-  vector<int> buffer_sizes = { 2, 10, 64, 100, 256 };
+  vector<int> buffer_sizes = { 1, 2, 10, 64, 100, 256, 65536 };
   for (int buffer_size : buffer_sizes)
   {
     std::cout << "buffer size: " << buffer_size << std::endl;
@@ -938,6 +1092,31 @@ int main() {
 #if BUILD_BTOR
     std::cout << "testing btor" << std::endl;
     test_btor(buffer_size);
+#endif
+  }
+
+  // the same tests, with commands that only answer `success`
+  // sent in batches, and then with terms sent as let terms
+  [[maybe_unused]] int buffer_size = 65536;
+  for (int mode = 0; mode < 2; mode++)
+  {
+    pipelined = (mode == 0);
+    use_let_terms = (mode == 1);
+    std::cout << (pipelined ? "pipelined" : "let terms") << std::endl;
+#if BUILD_CVC5
+    test_cvc5(buffer_size);
+#endif
+
+#if BUILD_MSAT
+    test_msat(buffer_size);
+#endif
+
+#if BUILD_YICES2
+    test_yices2(buffer_size);
+#endif
+
+#if BUILD_BTOR
+    test_btor(buffer_size);
 #endif
   }
 }
@@ -0,0 +1,112 @@
+/*********************                                                        */
+/*! \file test-interrupt.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Tests for interrupting a running check from another thread.
+**
+**
+**/
+
+#include <math.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "available_solvers.h"
+#include "gtest/gtest.h"
+#include "smt.h"
+
+using namespace smt;
+using namespace std;
+
+namespace smt_tests {
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(InterruptTests);
+class InterruptTests : public ::testing::Test,
+                       public ::testing::WithParamInterface<SolverConfiguration>
+{
+ protected:
+  void SetUp() override
+  {
+    s = create_solver(GetParam());
+    s->set_opt("produce-models", "true");
+    s->set_opt("incremental", "true");
+    bvsort = s->make_sort(BV, 6);
+  }
+  SmtSolver s;
+  Sort bvsort;
+};
+
+TEST_P(InterruptTests, InterruptCheckSat)
+{
+  // interrupting while no check is running does not affect the next check
+  s->interrupt();
+  s->assert_formula(s->make_symbol("b", s->make_sort(BOOL)));
+  ASSERT_TRUE(s->check_sat().is_sat());
+
+  // create a difficult pigeonhole problem
+  size_t width = bvsort->get_width();
+  size_t num_vars = (size_t)pow(2, width) + 1;
+  TermVec vars;
+  vars.reserve(num_vars);
+  for (size_t i = 0; i < num_vars; ++i)
+  {
+    vars.push_back(s->make_symbol("x" + std::to_string(i), bvsort));
+  }
+
+  s->push();
+  for (size_t i = 0; i < num_vars - 1; ++i)
+  {
+    for (size_t j = i + 1; j < num_vars; ++j)
+    {
+      s->assert_formula(s->make_term(Distinct, vars[i], vars[j]));
+    }
+  }
+
+  // keep interrupting until the check returns, in case it had not
+  // started yet when the first interrupt was sent
+  std::atomic<bool> done(false);
+  std::thread interrupter([this, &done]() {
+    while (!done)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      s->interrupt();
+    }
+  });
+
+  auto start = std::chrono::high_resolution_clock::now();
+  Result r = s->check_sat();
+  auto stop = std::chrono::high_resolution_clock::now();
+  done = true;
+  interrupter.join();
+
+  auto duration =
+      std::chrono::duration_cast<std::chrono::seconds>(stop - start);
+  ASSERT_TRUE(r.is_unknown());
+  ASSERT_LT(duration.count(), 2);
+
+  // the generic solver cannot be used after an interrupted check
+  if (s->get_solver_enum() != GENERIC_SOLVER)
+  {
+    s->pop();
+    r = s->check_sat();
+    ASSERT_TRUE(r.is_sat());
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParameterizedInterruptTests,
+    InterruptTests,
+    testing::ValuesIn(filter_solver_configurations({ INTERRUPT })));
+
+}  // namespace smt_tests
@@ -73,6 +73,27 @@ TEST_P(LoggingTests, Children)
   EXPECT_EQ(children[1], one);
 }
 
+TEST_P(LoggingTests, ManyChildren)
+{
+  // more children than are stored inline in a LoggingTerm
+  Sort boolsort = s->make_sort(BOOL);
+  TermVec args;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    args.push_back(s->make_symbol("b" + std::to_string(i), boolsort));
+  }
+  Term conj = s->make_term(And, args);
+  Term conj_2 = s->make_term(And, args);
+  EXPECT_EQ(conj.get(), conj_2.get());
+
+  TermVec children(conj->begin(), conj->end());
+  EXPECT_EQ(children, args);
+
+  args.pop_back();
+  Term smaller_conj = s->make_term(And, args);
+  EXPECT_NE(conj, smaller_conj);
+}
+
 TEST_P(LoggingTests, HashConsing)
 {
   Term xp1 = s->make_term(BVAdd, x, one);
@@ -150,6 +171,45 @@ TEST_P(LoggingTests, Compare)
   EXPECT_EQ(fxv, fyv);
 }
 
+TEST_P(LoggingTests, WeakHashConsing)
+{
+  shared_ptr<LoggingSolver> ws =
+      make_shared<LoggingSolver>(create_solver(GetParam()), true);
+  Sort bvsort = ws->make_sort(BV, 4);
+  Term a = ws->make_symbol("a", bvsort);
+  Term b = ws->make_symbol("b", bvsort);
+  // symbols are kept alive by the symbol table
+  size_t num_base_terms = ws->get_num_live_terms();
+  EXPECT_EQ(ws->get_num_collected_terms(), 0);
+
+  Term apb = ws->make_term(BVAdd, a, b);
+  Term apb_2 = ws->make_term(BVAdd, a, b);
+  EXPECT_EQ(apb.get(), apb_2.get());
+  Term bpa = ws->make_term(BVAdd, b, a);
+  EXPECT_EQ(ws->get_num_live_terms(), num_base_terms + 2);
+
+  apb.reset();
+  // still referenced by apb_2
+  EXPECT_EQ(ws->get_num_live_terms(), num_base_terms + 2);
+  apb_2.reset();
+  EXPECT_EQ(ws->get_num_live_terms(), num_base_terms + 1);
+  EXPECT_EQ(ws->get_num_collected_terms(), 1);
+
+  // recreating the term gives a new, equivalent term
+  apb = ws->make_term(BVAdd, a, b);
+  EXPECT_NE(apb, bpa);
+  EXPECT_EQ(apb->get_op(), BVAdd);
+  EXPECT_EQ(ws->get_num_live_terms(), num_base_terms + 2);
+
+  // strong hash-consing never collects
+  LoggingSolver * ls = static_cast<LoggingSolver *>(s.get());
+  size_t live = ls->get_num_live_terms();
+  Term xpy = s->make_term(BVAdd, x, y);
+  xpy.reset();
+  EXPECT_EQ(ls->get_num_live_terms(), live + 1);
+  EXPECT_EQ(ls->get_num_collected_terms(), 0);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedSolverLoggingTests,
     LoggingTests,
@@ -18,6 +18,10 @@
 #define STRFY(A) STRHELPER(A)
 
 #include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -88,9 +92,44 @@ class StrReaderTests : public ReaderTests
 {
 };
 
+// also parameterized by whether the input is memory-mapped
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(BitVecReaderTests);
-class BitVecReaderTests : public ReaderTests
+class BitVecReaderTests
+    : public ::testing::Test,
+      public ::testing::WithParamInterface<
+          tuple<SolverConfiguration, pair<const string, vector<Result>>, bool>>
 {
+ protected:
+  void SetUp() override
+  {
+    s = create_solver(get<0>(GetParam()));
+    s->set_opt("produce-models", "true");
+    reader = new SmtLibReaderTester(s);
+    reader->set_mmap_input(get<2>(GetParam()));
+  }
+
+  void TearDown() override { delete reader; }
+
+  SmtSolver s;
+  SmtLibReaderTester * reader;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ReaderInputTests);
+class ReaderInputTests : public ::testing::Test,
+                         public ::testing::WithParamInterface<SolverConfiguration>
+{
+ protected:
+  void SetUp() override
+  {
+    s = create_solver(GetParam());
+    s->set_opt("produce-models", "true");
+    reader = new SmtLibReaderTester(s);
+  }
+
+  void TearDown() override { delete reader; }
+
+  SmtSolver s;
+  SmtLibReaderTester * reader;
 };
 
 GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ArrayIntReaderTests);
@@ -160,6 +199,60 @@ TEST_P(BitVecReaderTests, QF_UFBV_Smt2Files)
   }
 }
 
+TEST_P(ReaderInputTests, Stdin)
+{
+  string test = STRFY(SMT_SWITCH_DIR);
+  test += "/tests/smt2/qf_ufbv/test-attr.smt2";
+  ifstream f(test);
+  stringstream ss;
+  ss << f.rdbuf();
+  string input = ss.str();
+
+  // feed the file through a pipe, which can't be memory-mapped
+  // (it's small enough to fit in the pipe buffer)
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(write(fds[1], input.data(), input.size()), input.size());
+  close(fds[1]);
+  int saved_stdin = dup(STDIN_FILENO);
+  dup2(fds[0], STDIN_FILENO);
+  close(fds[0]);
+  reader->parse("-");
+  dup2(saved_stdin, STDIN_FILENO);
+  close(saved_stdin);
+  clearerr(stdin);
+
+  auto results = reader->get_results();
+  auto expected_results = qf_ufbv_tests.at("test-attr.smt2");
+  ASSERT_EQ(results.size(), expected_results.size());
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    EXPECT_EQ(results[i], expected_results[i]);
+  }
+}
+
+TEST_P(ReaderInputTests, ParseAfterError)
+{
+  string bad = testing::TempDir() + "smtlib-reader-bad.smt2";
+  string good = testing::TempDir() + "smtlib-reader-good.smt2";
+  ofstream(bad) << "(set-logic QF_BV)\n"
+                   "(declare-const x (_ BitVec 99999999999999999999))\n";
+  ofstream(good) << "(declare-const y (_ BitVec 8))\n"
+                    "(assert (distinct y y))\n"
+                    "(check-sat)\n";
+
+  // the width is out of range for the solver, the input must
+  // still be released so the next parse reads the new file
+  EXPECT_ANY_THROW(reader->parse(bad));
+  EXPECT_EQ(reader->parse(good), 0);
+  auto results = reader->get_results();
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0], Result(UNSAT));
+
+  remove(bad.c_str());
+  remove(good.c_str());
+}
+
 TEST_P(ArrayIntReaderTests, QF_ALIA_Smt2Files)
 {
   // SMT_SWITCH_DIR is a macro defined at build time
@@ -220,7 +313,13 @@ INSTANTIATE_TEST_SUITE_P(
     BitVecReaderTests,
     testing::Combine(
         testing::ValuesIn(available_non_generic_solver_configurations()),
-        testing::ValuesIn(qf_ufbv_tests.begin(), qf_ufbv_tests.end())));
+        testing::ValuesIn(qf_ufbv_tests.begin(), qf_ufbv_tests.end()),
+        testing::Bool()));
+
+INSTANTIATE_TEST_SUITE_P(
+    ParameterizedSolverReaderInputTests,
+    ReaderInputTests,
+    testing::ValuesIn(filter_non_generic_solver_configurations({ THEORY_BV })));
 
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedSolverArrayIntReaderTests,
@@ -17,6 +17,7 @@
 #include <math.h>
 
 #include <chrono>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -45,32 +46,43 @@ class TimeLimitTests : public ::testing::Test,
   int time_limit = 1;
 };
 
-TEST_P(TimeLimitTests, TestTimeLimit)
+/** Pushes a context with a difficult pigeonhole problem
+ *  @param solver the solver to assert it in
+ *  @param width the bit-width of the pigeonholes
+ */
+void push_pigeonhole(SmtSolver & solver, size_t width)
 {
-  s->set_opt("incremental", "true");
-  s->set_opt("time-limit", std::to_string(time_limit));
-
-  // create a difficult pigeonhole problem
-  size_t width = bvsort->get_width();
-
-  s->assert_formula(s->make_symbol("b", s->make_sort(BOOL)));
-
+  Sort sort = solver->make_sort(BV, width);
   size_t num_vars = (size_t)pow(2, width) + 1;
   TermVec vars;
   vars.reserve(num_vars);
   for (size_t i = 0; i < num_vars; ++i)
   {
-    vars.push_back(s->make_symbol("x" + std::to_string(i), bvsort));
+    vars.push_back(solver->make_symbol("x" + std::to_string(i), sort));
   }
 
-  s->push();
+  solver->push();
   for (size_t i = 0; i < num_vars - 1; ++i)
   {
     for (size_t j = i + 1; j < num_vars; ++j)
     {
-      s->assert_formula(s->make_term(Distinct, vars[i], vars[j]));
+      solver->assert_formula(solver->make_term(Distinct, vars[i], vars[j]));
     }
   }
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ResourceLimitTests);
+class ResourceLimitTests : public TimeLimitTests
+{
+};
+
+TEST_P(TimeLimitTests, TestTimeLimit)
+{
+  s->set_opt("incremental", "true");
+  s->set_opt("time-limit", std::to_string(time_limit));
+
+  s->assert_formula(s->make_symbol("b", s->make_sort(BOOL)));
+  push_pigeonhole(s, bvsort->get_width());
   auto start = std::chrono::high_resolution_clock::now();
   Result r = s->check_sat();
   auto stop = std::chrono::high_resolution_clock::now();
@@ -83,9 +95,59 @@ TEST_P(TimeLimitTests, TestTimeLimit)
   ASSERT_TRUE(r.is_sat());
 }
 
+TEST_P(TimeLimitTests, ConcurrentTimeLimits)
+{
+  // time limits of solvers in different threads don't interfere
+  // the second solver has no time limit and is interrupted instead
+  SmtSolver s2 = create_solver(GetParam());
+  s->set_opt("incremental", "true");
+  s2->set_opt("incremental", "true");
+  s->set_opt("time-limit", std::to_string(time_limit));
+  push_pigeonhole(s, bvsort->get_width());
+  push_pigeonhole(s2, bvsort->get_width());
+
+  Result r2;
+  std::thread t2([&s2, &r2]() { r2 = s2->check_sat(); });
+
+  auto start = std::chrono::high_resolution_clock::now();
+  Result r = s->check_sat();
+  auto stop = std::chrono::high_resolution_clock::now();
+  auto duration =
+      std::chrono::duration_cast<std::chrono::seconds>(stop - start);
+
+  // the time limit should not have stopped the other solver
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  s2->interrupt();
+  t2.join();
+
+  ASSERT_TRUE(r.is_unknown());
+  ASSERT_TRUE((duration.count() - time_limit) < 1);
+  EXPECT_TRUE(r2.is_unknown());
+}
+
+TEST_P(ResourceLimitTests, TestResourceLimit)
+{
+  s->set_opt("incremental", "true");
+  s->set_opt("resource-limit", "10000");
+  s->assert_formula(s->make_symbol("b", s->make_sort(BOOL)));
+  push_pigeonhole(s, bvsort->get_width());
+
+  Result r = s->check_sat();
+  ASSERT_TRUE(r.is_unknown());
+  // the limit applies to each check
+  s->pop();
+  r = s->check_sat();
+  ASSERT_TRUE(r.is_sat());
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedTimeLimitTests,
     TimeLimitTests,
     testing::ValuesIn(filter_solver_configurations({ TIMELIMIT })));
 
+INSTANTIATE_TEST_SUITE_P(
+    ParameterizedResourceLimitTests,
+    ResourceLimitTests,
+    testing::ValuesIn(filter_solver_configurations({ RESOURCELIMIT })));
+
 }  // namespace smt_tests
@@ -0,0 +1,87 @@
+/*********************                                                        */
+/*! \file unit-deadline-timer.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Unit tests for the shared timer used for time limits.
+**
+**
+**/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "deadline_timer.h"
+#include "gtest/gtest.h"
+
+using namespace smt;
+using namespace std;
+
+namespace smt_tests {
+
+TEST(UnitDeadlineTimerTests, Order)
+{
+  DeadlineTimer & timer = DeadlineTimer::get();
+  std::mutex m;
+  vector<int> fired;
+  auto record = [&m, &fired](int i) {
+    return [&m, &fired, i]() {
+      std::lock_guard<std::mutex> lk(m);
+      fired.push_back(i);
+    };
+  };
+
+  DeadlineTimer::Id id2 =
+      timer.schedule(std::chrono::milliseconds(60), record(2));
+  DeadlineTimer::Id id1 =
+      timer.schedule(std::chrono::milliseconds(20), record(1));
+  EXPECT_NE(id1, id2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  // already fired
+  EXPECT_FALSE(timer.cancel(id1));
+  EXPECT_FALSE(timer.cancel(id2));
+  std::lock_guard<std::mutex> lk(m);
+  EXPECT_EQ(fired, vector<int>({ 1, 2 }));
+}
+
+TEST(UnitDeadlineTimerTests, Cancel)
+{
+  DeadlineTimer & timer = DeadlineTimer::get();
+  std::atomic<bool> fired(false);
+  DeadlineTimer::Id id =
+      timer.schedule(std::chrono::seconds(10), [&fired]() { fired = true; });
+  EXPECT_TRUE(timer.cancel(id));
+  EXPECT_FALSE(timer.cancel(id));
+  EXPECT_FALSE(timer.cancel(0));
+  EXPECT_FALSE(fired);
+}
+
+TEST(UnitDeadlineTimerTests, CancelWaitsForCallback)
+{
+  DeadlineTimer & timer = DeadlineTimer::get();
+  std::atomic<bool> started(false);
+  std::atomic<bool> finished(false);
+  DeadlineTimer::Id id = timer.schedule(std::chrono::milliseconds(0), [&]() {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    finished = true;
+  });
+  while (!started)
+  {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(timer.cancel(id));
+  EXPECT_TRUE(finished);
+}
+
+}  // namespace smt_tests
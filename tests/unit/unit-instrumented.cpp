@@ -0,0 +1,129 @@
+/*********************                                                        */
+/*! \file unit-instrumented.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Unit tests for the instrumented solver.
+**
+**
+**/
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "available_solvers.h"
+#include "gtest/gtest.h"
+#include "instrumented_solver.h"
+#include "smt.h"
+
+using namespace smt;
+using namespace std;
+
+namespace smt_tests {
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitInstrumentedTests);
+class UnitInstrumentedTests
+    : public ::testing::Test,
+      public ::testing::WithParamInterface<SolverConfiguration>
+{
+ protected:
+  void SetUp() override
+  {
+    instrumented = make_shared<InstrumentedSolver>(create_solver(GetParam()));
+    s = instrumented;
+    s->set_opt("produce-models", "true");
+    s->set_opt("incremental", "true");
+    bvsort = s->make_sort(BV, 8);
+  }
+  shared_ptr<InstrumentedSolver> instrumented;
+  SmtSolver s;
+  Sort bvsort;
+};
+
+TEST_P(UnitInstrumentedTests, Statistics)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term one = s->make_term(1, bvsort);
+  Term sum = s->make_term(BVAdd, x, one);
+  s->assert_formula(s->make_term(Equal, sum, y));
+  s->push();
+  s->assert_formula(s->make_term(Equal, x, s->make_term(BVAdd, y, y)));
+  ASSERT_TRUE(s->check_sat().is_sat());
+  EXPECT_EQ(s->get_value(sum), s->get_value(y));
+  s->pop();
+
+  EXPECT_EQ(instrumented->get_latencies(MAKE_SYMBOL_CALL).get_count(), 2);
+  EXPECT_EQ(instrumented->get_latencies(MAKE_TERM_CALL).get_count(), 4);
+  EXPECT_EQ(instrumented->get_latencies(ASSERT_FORMULA_CALL).get_count(), 2);
+  EXPECT_EQ(instrumented->get_latencies(CHECK_SAT_CALL).get_count(), 1);
+  EXPECT_EQ(instrumented->get_latencies(GET_VALUE_CALL).get_count(), 2);
+  EXPECT_EQ(instrumented->get_latencies(PUSH_CALL).get_count(), 1);
+  EXPECT_EQ(instrumented->get_num_terms(BVAdd), 2);
+  EXPECT_EQ(instrumented->get_num_terms(Equal), 2);
+
+  map<string, double> stats = instrumented->get_statistics();
+  EXPECT_EQ(stats.at("check_sat.count"), 1);
+  EXPECT_GT(stats.at("check_sat.total_us"), 0);
+  EXPECT_LE(stats.at("check_sat.p50_us"), stats.at("check_sat.max_us"));
+  EXPECT_EQ(stats.at("terms.bvadd"), 2);
+  EXPECT_TRUE(stats.find("reset.count") == stats.end());
+
+  stringstream ss;
+  instrumented->dump_json(ss);
+  string json = ss.str();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_NE(json.find("\"check_sat\": {\"count\": 1"), string::npos);
+  EXPECT_NE(json.find("\"bvadd\": 2"), string::npos);
+
+  // nothing is recorded while disabled
+  instrumented->set_enabled(false);
+  s->make_term(BVAdd, x, y);
+  ASSERT_TRUE(s->check_sat().is_sat());
+  EXPECT_EQ(instrumented->get_num_terms(BVAdd), 2);
+  EXPECT_EQ(instrumented->get_latencies(CHECK_SAT_CALL).get_count(), 1);
+
+  instrumented->reset_statistics();
+  EXPECT_TRUE(instrumented->get_statistics().empty());
+}
+
+TEST(UnitLatencyHistogramTests, Percentiles)
+{
+  LatencyHistogram h;
+  EXPECT_EQ(h.get_percentile(0.5), 0);
+  for (uint64_t i = 1; i <= 1000; ++i)
+  {
+    h.record(i * 1000);
+  }
+  EXPECT_EQ(h.get_count(), 1000);
+  EXPECT_EQ(h.get_total(), 500500000);
+  EXPECT_EQ(h.get_max(), 1000000);
+  EXPECT_EQ(h.get_percentile(1), 1000000);
+  // within the 12.5% precision of the buckets
+  for (double q : { 0.1, 0.5, 0.9, 0.99 })
+  {
+    double exact = q * 1000000;
+    EXPECT_GE(h.get_percentile(q), exact);
+    EXPECT_LE(h.get_percentile(q), exact * 1.125);
+  }
+
+  h.record(3);
+  EXPECT_EQ(h.get_percentile(0), 3);
+  h.clear();
+  EXPECT_EQ(h.get_count(), 0);
+  EXPECT_EQ(h.get_max(), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedUnitInstrumented,
+                         UnitInstrumentedTests,
+                         testing::ValuesIn(filter_solver_configurations(
+                             { THEORY_BV })));
+
+}  // namespace smt_tests
@@ -0,0 +1,126 @@
+/*********************                                                        */
+/*! \file unit-model.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Unit tests for model snapshots.
+**
+**
+**/
+
+#include <utility>
+#include <vector>
+
+#include "available_solvers.h"
+#include "gtest/gtest.h"
+#include "smt.h"
+
+using namespace smt;
+using namespace std;
+
+namespace smt_tests {
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitModelTests);
+class UnitModelTests : public ::testing::Test,
+                       public ::testing::WithParamInterface<SolverConfiguration>
+{
+ protected:
+  void SetUp() override
+  {
+    s = create_solver(GetParam());
+    s->set_opt("produce-models", "true");
+    s->set_opt("incremental", "true");
+
+    boolsort = s->make_sort(BOOL);
+    bvsort = s->make_sort(BV, 8);
+    intsort = s->make_sort(INT);
+  }
+  SmtSolver s;
+  Sort boolsort, bvsort, intsort;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitArrayModelTests);
+class UnitArrayModelTests : public UnitModelTests
+{
+};
+
+TEST_P(UnitModelTests, Snapshot)
+{
+  Term b = s->make_symbol("b", boolsort);
+  Term x = s->make_symbol("x", bvsort);
+  Term i = s->make_symbol("i", intsort);
+  s->assert_formula(b);
+  s->assert_formula(s->make_term(Equal, x, s->make_term(200, bvsort)));
+  s->assert_formula(s->make_term(Equal, i, s->make_term(-7, intsort)));
+  ASSERT_TRUE(s->check_sat().is_sat());
+
+  Model m = s->get_model({ b, x, i });
+  EXPECT_EQ(m.size(), 3);
+  EXPECT_TRUE(m.contains(x));
+  EXPECT_EQ(m.get_symbols(), TermVec({ b, x, i }));
+
+  // the model stays the same after the solver moves on
+  s->push();
+  s->assert_formula(s->make_term(Not, b));
+  s->assert_formula(s->make_term(Equal, x, s->make_term(1, bvsort)));
+  ASSERT_TRUE(s->check_sat().is_unsat());
+  s->pop();
+
+  EXPECT_TRUE(m.get_value(b).get_bool());
+  EXPECT_EQ(m.get_value(x), TermValue::make_bv(8, 200));
+  EXPECT_EQ(m.get_value(i), TermValue::make_int(-7));
+  EXPECT_THROW(m.get_array_value(x), IncorrectUsageException);
+  EXPECT_THROW(m.get_value(s->make_symbol("y", bvsort)),
+               IncorrectUsageException);
+}
+
+TEST_P(UnitArrayModelTests, Arrays)
+{
+  Sort arrsort = s->make_sort(ARRAY, bvsort, bvsort);
+  Term a = s->make_symbol("a", arrsort);
+  Term one = s->make_term(1, bvsort);
+  Term two = s->make_term(2, bvsort);
+  Term constarr = s->make_term(s->make_term(0, bvsort), arrsort);
+  s->assert_formula(
+      s->make_term(Equal, a, s->make_term(Store, constarr, one, two)));
+  ASSERT_TRUE(s->check_sat().is_sat());
+
+  Model m = s->get_model({ a });
+  const ArrayValue & av = m.get_array_value(a);
+  EXPECT_EQ(av.select(TermValue::make_bv(8, 1)), TermValue::make_bv(8, 2));
+  if (!av.default_value.is_null())
+  {
+    EXPECT_EQ(av.select(TermValue::make_bv(8, 5)), TermValue::make_bv(8, 0));
+  }
+}
+
+TEST(UnitArrayValueTests, Select)
+{
+  ArrayValue av;
+  EXPECT_TRUE(av.select(TermValue::make_int(3)).is_null());
+  av.default_value = TermValue::make_bool(false);
+  av.stores[TermValue::make_int(3)] = TermValue::make_bool(true);
+  av.stores[TermValue::make_int(-3)] = TermValue::make_bool(true);
+  EXPECT_EQ(av.stores.size(), 2);
+  EXPECT_TRUE(av.select(TermValue::make_int(3)).get_bool());
+  EXPECT_TRUE(av.select(TermValue::from_string("(- 3)", INT)).get_bool());
+  EXPECT_FALSE(av.select(TermValue::make_int(4)).get_bool());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ParameterizedUnitModel,
+    UnitModelTests,
+    testing::ValuesIn(filter_solver_configurations({ THEORY_INT })));
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedUnitArrayModel,
+                         UnitArrayModelTests,
+                         testing::ValuesIn(filter_solver_configurations(
+                             { CONSTARR, ARRAY_MODELS })));
+
+}  // namespace smt_tests
@@ -0,0 +1,313 @@
+/*********************                                                        */
+/*! \file unit-portfolio.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Unit tests for the incremental portfolio solver.
+**
+**
+**/
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "available_solvers.h"
+#include "gtest/gtest.h"
+#include "instrumented_solver.h"
+#include "portfolio_solver.h"
+#include "smt.h"
+
+using namespace smt;
+using namespace std;
+
+namespace smt_tests {
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitPortfolioTests);
+class UnitPortfolioTests
+    : public ::testing::Test,
+      public ::testing::WithParamInterface<SolverConfiguration>
+{
+ protected:
+  void SetUp() override
+  {
+    vector<SmtSolver> solvers;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      solvers.push_back(create_solver(GetParam()));
+    }
+    portfolio = make_shared<PortfolioSolver>(solvers);
+    s = portfolio;
+    s->set_opt("produce-models", "true");
+    s->set_opt("incremental", "true");
+
+    boolsort = s->make_sort(BOOL);
+    bvsort = s->make_sort(BV, 8);
+  }
+  shared_ptr<PortfolioSolver> portfolio;
+  SmtSolver s;
+  Sort boolsort, bvsort;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitPortfolioUnsatCoreTests);
+class UnitPortfolioUnsatCoreTests : public UnitPortfolioTests
+{
+  void SetUp() override
+  {
+    UnitPortfolioTests::SetUp();
+    s->set_opt("produce-unsat-assumptions", "true");
+  }
+};
+
+TEST_P(UnitPortfolioTests, Incremental)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term one = s->make_term(1, bvsort);
+  s->assert_formula(s->make_term(Equal, s->make_term(BVAdd, x, one), y));
+
+  // the winner may differ between checks
+  for (int64_t i = 0; i < 10; ++i)
+  {
+    s->push();
+    Term xval = s->make_term(i, bvsort);
+    s->assert_formula(s->make_term(Equal, x, xval));
+    ASSERT_TRUE(s->check_sat().is_sat());
+    EXPECT_LT(portfolio->get_winner(), 3);
+    EXPECT_EQ(s->get_value(x), xval);
+    EXPECT_EQ(s->get_value(y), s->make_term(i + 1, bvsort));
+
+    TermVec vals;
+    s->get_values({ x, s->make_term(BVAdd, x, y) }, vals);
+    ASSERT_EQ(vals.size(), 2);
+    EXPECT_EQ(vals[0], xval);
+    EXPECT_EQ(vals[1], s->make_term(2 * i + 1, bvsort));
+
+    Model m = s->get_model({ x, y });
+    EXPECT_EQ(m.get_value(y), TermValue::make_bv(8, i + 1));
+
+    s->assert_formula(s->make_term(Equal, y, xval));
+    ASSERT_TRUE(s->check_sat().is_unsat());
+    s->pop();
+  }
+  EXPECT_EQ(s->get_context_level(), 0);
+  ASSERT_TRUE(s->check_sat().is_sat());
+}
+
+TEST_P(UnitPortfolioUnsatCoreTests, UnsatAssumptions)
+{
+  Term a = s->make_symbol("a", boolsort);
+  Term b = s->make_symbol("b", boolsort);
+  Term c = s->make_symbol("c", boolsort);
+  s->assert_formula(s->make_term(Not, s->make_term(And, a, b)));
+
+  ASSERT_TRUE(s->check_sat_assuming({ a, c }).is_sat());
+  ASSERT_TRUE(s->check_sat_assuming({ a, b, c }).is_unsat());
+
+  UnorderedTermSet core;
+  s->get_unsat_assumptions(core);
+  EXPECT_TRUE(core.find(a) != core.end());
+  EXPECT_TRUE(core.find(b) != core.end());
+  for (const auto & t : core)
+  {
+    // assumptions are reported as the terms that were passed in
+    EXPECT_TRUE(t == a || t == b || t == c);
+  }
+}
+
+TEST_P(UnitPortfolioTests, Scheduling)
+{
+  EXPECT_NO_THROW(portfolio->diversify_seeds());
+  EXPECT_THROW(portfolio->set_solver_opt(3, "produce-models", "true"),
+               IncorrectUsageException);
+  portfolio->set_core_budget(1);
+
+  Term x = s->make_symbol("x", bvsort);
+  s->assert_formula(s->make_term(BVUlt, x, s->make_term(5, bvsort)));
+  string features = portfolio->get_query_features(false);
+
+  // with one core, the solvers run one after the other in schedule order
+  ASSERT_TRUE(s->check_sat().is_sat());
+  EXPECT_EQ(portfolio->get_winner(), 0);
+  shared_ptr<PortfolioScheduler> scheduler = portfolio->get_scheduler();
+  EXPECT_EQ(scheduler->get_wins(features, 0), 1);
+
+  scheduler->record_win(features, 2, 0.1);
+  scheduler->record_win(features, 2, 0.1);
+  ASSERT_TRUE(s->check_sat().is_sat());
+  EXPECT_EQ(portfolio->get_winner(), 2);
+  EXPECT_EQ(scheduler->get_wins(features, 2), 3);
+  EXPECT_LT(s->get_value(x)->to_int(), 5);
+}
+
+/** Blocks checks until it is opened */
+struct CheckGate
+{
+  std::mutex m;
+  std::condition_variable cv;
+  bool open = false;
+  size_t num_checks = 0;  ///< number of checks that have returned
+
+  void set_open()
+  {
+    {
+      std::lock_guard<std::mutex> lk(m);
+      open = true;
+    }
+    cv.notify_all();
+  }
+
+  /** @return true iff num checks returned within a second */
+  bool wait_for_checks(size_t num)
+  {
+    std::unique_lock<std::mutex> lk(m);
+    return cv.wait_for(lk, std::chrono::seconds(1), [&]() {
+      return num_checks >= num;
+    });
+  }
+};
+
+/** A solver without interrupt support whose checks wait for a gate */
+class NoInterruptSolver : public InstrumentedSolver
+{
+ public:
+  NoInterruptSolver(SmtSolver s, shared_ptr<CheckGate> g)
+      : InstrumentedSolver(s), gate(g)
+  {
+  }
+
+  Result check_sat() override
+  {
+    {
+      std::unique_lock<std::mutex> lk(gate->m);
+      gate->cv.wait(lk, [this]() { return gate->open; });
+    }
+    Result r = InstrumentedSolver::check_sat();
+    {
+      std::lock_guard<std::mutex> lk(gate->m);
+      gate->num_checks++;
+    }
+    gate->cv.notify_all();
+    return r;
+  }
+
+  void interrupt() override
+  {
+    throw NotImplementedException("NoInterruptSolver can't be interrupted");
+  }
+
+ private:
+  shared_ptr<CheckGate> gate;
+};
+
+TEST_P(UnitPortfolioTests, NonInterruptibleLoser)
+{
+  auto gate = make_shared<CheckGate>();
+  SmtSolver slow(
+      new NoInterruptSolver(create_solver(GetParam()), gate));
+  slow->set_opt("incremental", "true");
+  auto p = make_shared<PortfolioSolver>(
+      vector<SmtSolver>{ create_solver(GetParam()), slow });
+  p->set_opt("incremental", "true");
+  Sort bv = p->make_sort(BV, 8);
+  Term x = p->make_symbol("x", bv);
+  p->assert_formula(p->make_term(BVUlt, x, p->make_term(5, bv)));
+
+  // returns with the first solver's answer while the other still runs
+  ASSERT_TRUE(p->check_sat().is_sat());
+  EXPECT_EQ(p->get_winner(), 0);
+  EXPECT_EQ(gate->num_checks, 0);
+
+  // queued for the running solver, which sits out the next check
+  p->push();
+  p->assert_formula(p->make_term(Equal, x, p->make_term(7, bv)));
+  ASSERT_TRUE(p->check_sat().is_unsat());
+  EXPECT_EQ(p->get_winner(), 0);
+
+  gate->set_open();
+  ASSERT_TRUE(gate->wait_for_checks(1));
+  // let the background thread mark the solver as finished
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  // the queued commands are applied before the solver checks again,
+  // it is scheduled first and run alone here
+  p->set_core_budget(1);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    p->get_scheduler()->record_win(p->get_query_features(false), 1, 0.1);
+  }
+  ASSERT_TRUE(p->check_sat().is_unsat());
+  EXPECT_EQ(p->get_winner(), 1);
+  p->pop();
+  for (size_t i = 0; i < 4; ++i)
+  {
+    p->get_scheduler()->record_win(p->get_query_features(false), 1, 0.1);
+  }
+  ASSERT_TRUE(p->check_sat().is_sat());
+  EXPECT_EQ(p->get_winner(), 1);
+
+  // a solver still running when the portfolio is destroyed
+  // finishes in the background
+  auto gate2 = make_shared<CheckGate>();
+  SmtSolver slow2(
+      new NoInterruptSolver(create_solver(GetParam()), gate2));
+  auto p2 = make_shared<PortfolioSolver>(
+      vector<SmtSolver>{ create_solver(GetParam()), slow2 });
+  p2->assert_formula(p2->make_term(true));
+  ASSERT_TRUE(p2->check_sat().is_sat());
+  p2.reset();
+  slow2.reset();
+  gate2->set_open();
+  EXPECT_TRUE(gate2->wait_for_checks(1));
+}
+
+TEST(UnitPortfolioSchedulerTests, Schedule)
+{
+  PortfolioScheduler scheduler;
+  EXPECT_EQ(scheduler.schedule("QF_BV:check-sat:1", 3),
+            vector<size_t>({ 0, 1, 2 }));
+
+  scheduler.record_win("QF_BV:check-sat:1", 1, 2.0);
+  scheduler.record_win("QF_BV:check-sat:1", 2, 1.0);
+  scheduler.record_win("QF_LIA:check-sat:1", 2, 1.0);
+  // equal wins, solver 2 was faster
+  EXPECT_EQ(scheduler.schedule("QF_BV:check-sat:1", 3),
+            vector<size_t>({ 2, 1, 0 }));
+  EXPECT_EQ(scheduler.get_wins("QF_BV:check-sat:1", 1), 1);
+  EXPECT_EQ(scheduler.get_wins("QF_BV:check-sat:1", 0), 0);
+
+  // unseen features fall back to the wins over all queries
+  EXPECT_EQ(scheduler.schedule("QF_ABV:check-sat:4", 3),
+            vector<size_t>({ 2, 1, 0 }));
+  EXPECT_EQ(scheduler.get_wins("QF_ABV:check-sat:4", 2), 0);
+}
+
+TEST(UnitPortfolioConstructorTests, Empty)
+{
+  EXPECT_THROW(PortfolioSolver p{ vector<SmtSolver>() },
+               IncorrectUsageException);
+}
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedUnitPortfolio,
+                         UnitPortfolioTests,
+                         testing::ValuesIn(
+                             filter_non_generic_solver_configurations(
+                                 { THEORY_BV })));
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedUnitPortfolioUnsatCore,
+                         UnitPortfolioUnsatCoreTests,
+                         testing::ValuesIn(
+                             filter_non_generic_solver_configurations(
+                                 { UNSAT_CORE })));
+
+}  // namespace smt_tests
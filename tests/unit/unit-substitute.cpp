@@ -122,6 +122,27 @@ TEST_P(UnitSubstituteTests, SimpleSubstitutionWalker)
   EXPECT_EQ(apb, apb_spec);
 }
 
+TEST_P(UnitSubstituteIterTests, IdCacheSubstitutionWalker)
+{
+  // build a DAG with a lot of sharing
+  Term t = xpy;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    t = s->make_term(BVMul, s->make_term(BVAdd, t, x), t);
+  }
+
+  UnorderedTermMap subs_map({ { x, a }, { y, b } });
+  SubstitutionWalker hash_sw(s, subs_map);
+  SubstitutionWalker id_sw(s, subs_map, ID_CACHE);
+
+  Term expected = hash_sw.visit(t);
+  EXPECT_EQ(expected, s->substitute(t, subs_map));
+  EXPECT_EQ(id_sw.visit(t), expected);
+  // visit a second time to check the cache
+  EXPECT_EQ(id_sw.visit(t), expected);
+  EXPECT_EQ(id_sw.visit(xpy), s->make_term(BVAdd, a, b));
+}
+
 TEST_P(UnitSubstituteTests, BadSubstitution)
 {
   Sort diff_bvsort = s->make_sort(BV, bvsort->get_width() + 1);
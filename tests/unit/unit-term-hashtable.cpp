@@ -71,6 +71,48 @@ TEST_P(UnitTestsHashTable, HashTable)
   ASSERT_EQ(cp_xp1_2.use_count(), 1);
 }
 
+TEST_P(UnitTestsHashTable, FindOrInsert)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term one = s->make_term(1, bvsort);
+  Term xp1 = s->make_term(BVAdd, x, one);
+  Term xp1_2 = s->make_term(BVAdd, x, one);
+  ASSERT_NE(xp1.get(), xp1_2.get());
+
+  ASSERT_FALSE(table.find_or_insert(xp1));
+  ASSERT_EQ(table.size(), 1);
+  ASSERT_TRUE(table.find_or_insert(xp1_2));
+  ASSERT_EQ(xp1.get(), xp1_2.get());
+  ASSERT_EQ(table.size(), 1);
+
+  // insert enough terms to force the table to grow several times
+  TermVec terms;
+  for (int64_t i = 0; i < 500; ++i)
+  {
+    Term y = s->make_symbol("y" + std::to_string(i), bvsort);
+    Term t = s->make_term(BVAdd, x, y);
+    terms.push_back(t);
+    table.insert(t);
+  }
+  ASSERT_EQ(table.size(), 501);
+
+  // erase every other term and check the rest are still found
+  for (size_t i = 0; i < terms.size(); i += 2)
+  {
+    table.erase(terms[i]);
+  }
+  ASSERT_EQ(table.size(), 251);
+  for (size_t i = 0; i < terms.size(); ++i)
+  {
+    ASSERT_EQ(table.contains(terms[i]), i % 2 == 1);
+  }
+  ASSERT_TRUE(table.contains(xp1));
+
+  table.clear();
+  ASSERT_EQ(table.size(), 0);
+  ASSERT_FALSE(table.contains(xp1));
+}
+
 // similarly to logging solvers, generic solvers
 // increase the usage count and so we ignore
 // them in this test
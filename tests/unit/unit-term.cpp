@@ -64,6 +64,46 @@ TEST_P(UnitTermTests, Array)
   ASSERT_TRUE(arr->is_symbolic_const());
 }
 
+TEST_P(UnitTermTests, MakeTerms)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term f = s->make_symbol("f", funsort);
+
+  // 0: x, 1: y, 2: f
+  // 3: x + y, 4: f(x + y), 5: extract(f(x + y)), 6: (x + y) = f(x + y)
+  // 7: x + y + f(x + y)
+  TermVec leaves({ x, y, f });
+  vector<Op> ops({ BVAdd, Apply, Op(Extract, 1, 0), Equal, BVAdd });
+  vector<size_t> child_offsets({ 0, 2, 4, 5, 7, 10 });
+  vector<size_t> children({ 0, 1, 2, 3, 4, 3, 4, 0, 1, 4 });
+
+  Term old = s->make_term(true);
+  TermVec out({ old });
+  s->make_terms(leaves, ops, child_offsets, children, out);
+  ASSERT_EQ(out.size(), ops.size() + 1);
+  // results are appended
+  EXPECT_EQ(out[0], old);
+
+  Term xpy = s->make_term(BVAdd, x, y);
+  Term fxpy = s->make_term(Apply, f, xpy);
+  EXPECT_EQ(out[1], xpy);
+  EXPECT_EQ(out[2], fxpy);
+  EXPECT_EQ(out[3], s->make_term(Op(Extract, 1, 0), fxpy));
+  EXPECT_EQ(out[4], s->make_term(Equal, xpy, fxpy));
+  EXPECT_EQ(out[5], s->make_term(BVAdd, TermVec{ x, y, fxpy }));
+  EXPECT_EQ(out[3]->get_sort(), s->make_sort(BV, 2));
+  EXPECT_EQ(out[4]->get_sort(), boolsort);
+
+  // children must refer to leaves or earlier terms
+  TermVec bad_out;
+  EXPECT_THROW(s->make_terms(leaves, { BVAdd }, { 0, 2 }, { 0, 3 }, bad_out),
+               IncorrectUsageException);
+  EXPECT_THROW(s->make_terms(leaves, { BVAdd }, { 0, 1 }, { 0, 1 }, bad_out),
+               IncorrectUsageException);
+  EXPECT_EQ(bad_out.size(), 0);
+}
+
 INSTANTIATE_TEST_SUITE_P(ParameterizedSolverUnitTerm,
                          UnitTermTests,
                          testing::ValuesIn(available_solver_configurations()));
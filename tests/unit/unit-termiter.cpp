@@ -105,6 +105,39 @@ TEST_P(UnitTests, InputIterator)
   ASSERT_EQ(children[1], x);
 }
 
+TEST_P(UnitTests, ChildAccess)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term f = s->make_symbol("f", funsort);
+  Term fx = s->make_term(Apply, f, x);
+  Term sum = s->make_term(BVAdd, fx, y);
+
+  EXPECT_EQ(x->num_children(), 0);
+  EXPECT_EQ(f->num_children(), 0);
+
+  for (auto t : { fx, sum })
+  {
+    TermVec iter_children(t->begin(), t->end());
+    ASSERT_EQ(t->num_children(), iter_children.size());
+    for (size_t i = 0; i < iter_children.size(); ++i)
+    {
+      EXPECT_EQ(t->get_child(i), iter_children[i]);
+    }
+    EXPECT_THROW(t->get_child(iter_children.size()), IncorrectUsageException);
+
+    // get_children appends to the output vector
+    TermVec children({ x });
+    t->get_children(children);
+    ASSERT_EQ(children.size(), iter_children.size() + 1);
+    EXPECT_EQ(children[0], x);
+    for (size_t i = 0; i < iter_children.size(); ++i)
+    {
+      EXPECT_EQ(children[i + 1], iter_children[i]);
+    }
+  }
+}
+
 TEST_P(UnitTests, CopyIter)
 {
   Term x = s->make_symbol("x", bvsort);
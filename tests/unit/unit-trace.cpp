@@ -0,0 +1,137 @@
+/*********************                                                        */
+/*! \file unit-trace.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann
+** This file is part of the smt-switch project.
+** Copyright (c) 2020 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Unit tests for the trace-event export.
+**
+**
+**/
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "available_solvers.h"
+#include "gtest/gtest.h"
+#include "instrumented_solver.h"
+#include "portfolio_solver.h"
+#include "smt.h"
+#include "trace_recorder.h"
+
+using namespace smt;
+using namespace std;
+
+namespace smt_tests {
+
+/** @return the number of occurrences of sub in s */
+size_t count_occurrences(const string & s, const string & sub)
+{
+  size_t n = 0;
+  for (size_t pos = s.find(sub); pos != string::npos;
+       pos = s.find(sub, pos + 1))
+  {
+    n++;
+  }
+  return n;
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitTraceTests);
+class UnitTraceTests : public ::testing::Test,
+                       public ::testing::WithParamInterface<SolverConfiguration>
+{
+ protected:
+  void SetUp() override
+  {
+    filename = testing::TempDir() + "smt-switch-trace.json";
+  }
+
+  string read_trace()
+  {
+    ifstream f(filename);
+    stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+  }
+
+  string filename;
+};
+
+TEST_P(UnitTraceTests, SolverCalls)
+{
+  SmtSolver s = create_instrumented_solver(create_solver(GetParam()));
+  s->set_opt("produce-models", "true");
+  Sort bvsort = s->make_sort(BV, 8);
+  Term x = s->make_symbol("x", bvsort);
+
+  // nothing is recorded before starting
+  TraceRecorder & recorder = TraceRecorder::get();
+  recorder.start(filename);
+  EXPECT_TRUE(recorder.is_started());
+  EXPECT_THROW(recorder.start(filename), IncorrectUsageException);
+
+  s->assert_formula(s->make_term(BVUlt, x, s->make_term(3, bvsort)));
+  ASSERT_TRUE(s->check_sat().is_sat());
+  s->get_value(x);
+
+  SmtSolver s2 = create_solver(GetParam());
+  TermTranslator tt(s2);
+  tt.transfer_term(x);
+
+  recorder.stop();
+  EXPECT_FALSE(recorder.is_started());
+  // spans after stopping are not recorded
+  s->check_sat();
+
+  string trace = read_trace();
+  EXPECT_EQ(trace.find("{\"traceEvents\": ["), 0);
+  EXPECT_EQ(count_occurrences(trace, "\"name\": \"make_symbol\""), 0);
+  EXPECT_EQ(count_occurrences(trace, "\"name\": \"check_sat\""), 1);
+  EXPECT_EQ(count_occurrences(trace, "\"name\": \"assert_formula\""), 1);
+  EXPECT_EQ(count_occurrences(trace, "\"name\": \"get_value\""), 1);
+  EXPECT_EQ(count_occurrences(trace, "\"name\": \"transfer_term\""), 1);
+  EXPECT_EQ(count_occurrences(trace, "\"ph\": \"X\""),
+            count_occurrences(trace, "\"name\": "));
+  EXPECT_NE(trace.find("\"solver\": \"" + to_string(s->get_solver_enum())),
+            string::npos);
+  EXPECT_NE(trace.find("]"), string::npos);
+  EXPECT_EQ(recorder.get_num_dropped(), 0);
+}
+
+TEST_P(UnitTraceTests, PortfolioWorkers)
+{
+  vector<SmtSolver> solvers;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    solvers.push_back(create_solver(GetParam()));
+  }
+  PortfolioSolver p(solvers);
+  p.assert_formula(p.make_symbol("b", p.make_sort(BOOL)));
+
+  TraceRecorder::get().start(filename);
+  ASSERT_TRUE(p.check_sat().is_sat());
+  TraceRecorder::get().stop();
+
+  string trace = read_trace();
+  // one span per worker thread, possibly skipped if the other one
+  // answered before it started
+  size_t workers = count_occurrences(trace, "\"name\": \"portfolio_worker\"");
+  EXPECT_GE(workers, 1);
+  EXPECT_LE(workers, 2);
+  EXPECT_NE(trace.find("\"index\": "), string::npos);
+}
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedUnitTrace,
+                         UnitTraceTests,
+                         testing::ValuesIn(
+                             filter_non_generic_solver_configurations(
+                                 { THEORY_BV })));
+
+}  // namespace smt_tests
@@ -48,6 +48,16 @@ class UnitQuantifierTransferTests : public UnitTransferTests
 {
 };
 
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitValueTransferTests);
+class UnitValueTransferTests : public UnitTransferTests
+{
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(UnitNativeTransferTests);
+class UnitNativeTransferTests : public UnitTransferTests
+{
+};
+
 // TODO: Eventually test transferring terms between each pair of solvers
 
 TEST_P(UnitTransferTests, SimpleUFTransfer)
@@ -69,6 +79,42 @@ TEST_P(UnitTransferTests, SimpleUFTransfer)
   EXPECT_EQ(a2, children[1]);
 }
 
+TEST_P(UnitTransferTests, TransferTerms)
+{
+  Term a = s->make_symbol("a", bvsort);
+  Term b = s->make_symbol("b", bvsort);
+  Term f = s->make_symbol("f", funsort);
+  Term fa = s->make_term(Apply, f, a);
+  Term sum = s->make_term(BVAdd, fa, b);
+  Term lt = s->make_term(BVUlt, sum, fa);
+  Term eq = s->make_term(Equal, sum, a);
+
+  SmtSolver s2 = create_solver(GetParam());
+  TermTranslator tr(s2);
+  TermVec res = tr.transfer_terms({ lt, eq });
+  ASSERT_EQ(res.size(), 2);
+  // a, b, f, fa, sum, lt, eq
+  EXPECT_EQ(tr.get_stats().nodes_created, 7);
+
+  Term a2 = s2->get_symbol("a");
+  Term fa2 = s2->make_term(Apply, s2->get_symbol("f"), a2);
+  Term sum2 = s2->make_term(BVAdd, fa2, s2->get_symbol("b"));
+  EXPECT_EQ(res[0], s2->make_term(BVUlt, sum2, fa2));
+  EXPECT_EQ(res[1], s2->make_term(Equal, sum2, a2));
+
+  // everything is cached now
+  EXPECT_EQ(tr.transfer_terms({ eq, sum, lt }),
+            TermVec({ res[1], sum2, res[0] }));
+  EXPECT_EQ(tr.get_stats().nodes_created, 0);
+  EXPECT_EQ(tr.get_stats().cache_hits, 3);
+
+  Term fb = s->make_term(Apply, f, b);
+  EXPECT_EQ(tr.transfer_term(fb),
+            s2->make_term(Apply, s2->get_symbol("f"), s2->get_symbol("b")));
+  EXPECT_EQ(tr.get_stats().nodes_created, 1);
+  EXPECT_EQ(tr.get_stats().cache_hits, 2);
+}
+
 TEST_P(UnitTransferTests, MonotonicUF)
 {
   Term x = s->make_param("x", bvsort);
@@ -87,6 +133,157 @@ TEST_P(UnitTransferTests, MonotonicUF)
   // EXPECT_NO_THROW(tr.transfer_term(fx_le_fy));
 }
 
+TEST_P(UnitValueTransferTests, Values)
+{
+  Sort intsort = s->make_sort(INT);
+  Sort realsort = s->make_sort(REAL);
+  Sort widesort = s->make_sort(BV, 100);
+  // 2^99 + 5
+  string wide = "1" + string(96, '0') + "101";
+
+  TermVec vals({ s->make_term(true),
+                 s->make_term(false),
+                 s->make_term(11, bvsort),
+                 s->make_term(wide, widesort, 2),
+                 s->make_term(-7, intsort),
+                 s->make_term("123456789012345678901234567890", intsort),
+                 s->make_term("1/3", realsort),
+                 s->make_term(Negate, s->make_term("5/2", realsort)) });
+
+  SmtSolver s2 = create_solver(GetParam());
+  TermTranslator tr(s2);
+
+  TermValue v, v2;
+  for (const auto & val : vals)
+  {
+    Term val2 = tr.transfer_term(val);
+    EXPECT_EQ(val2->get_sort(), tr.transfer_sort(val->get_sort()));
+    if (val->export_value(v))
+    {
+      ASSERT_TRUE(val2->export_value(v2));
+      EXPECT_EQ(v, v2);
+    }
+  }
+
+  TermValue wide_val;
+  if (vals[3]->export_value(wide_val))
+  {
+    EXPECT_EQ(wide_val.width, 100);
+    EXPECT_EQ(wide_val.num, vector<uint64_t>({ 5, 1ULL << 35 }));
+    EXPECT_EQ(s->import_value(wide_val, widesort), vals[3]);
+  }
+
+  // Bool and (_ BitVec 1) values can be imported as each other
+  Sort bv1sort = s->make_sort(BV, 1);
+  Term one = s->import_value(TermValue::make_bool(true), bv1sort);
+  EXPECT_EQ(one, s->make_term(1, bv1sort));
+  EXPECT_EQ(s->import_value(TermValue::make_bv(1, 0), boolsort),
+            s->make_term(false));
+  EXPECT_THROW(s->import_value(TermValue::make_bv(4, 1), boolsort),
+               IncorrectUsageException);
+}
+
+TEST_P(UnitNativeTransferTests, SameSolver)
+{
+  Term a = s->make_symbol("a", bvsort);
+  Term b = s->make_symbol("b", bvsort);
+  Term f = s->make_symbol("f", funsort);
+  Term fa = s->make_term(Apply, f, a);
+  Term lt = s->make_term(BVUlt, s->make_term(BVAdd, fa, b), fa);
+
+  SmtSolver s2 = create_solver(GetParam());
+  TermTranslator tr(s2, s);
+  TermVec res = tr.transfer_terms({ lt, fa });
+  ASSERT_EQ(res.size(), 2);
+  if (!GetParam().is_logging_solver)
+  {
+    // one native translation per root
+    EXPECT_EQ(tr.get_stats().nodes_created, 2);
+  }
+
+  // the symbols are declared in the new solver
+  Term a2 = s2->get_symbol("a");
+  Term b2 = s2->get_symbol("b");
+  Term f2 = s2->get_symbol("f");
+  Term fa2 = s2->make_term(Apply, f2, a2);
+  EXPECT_EQ(res[0], s2->make_term(BVUlt, s2->make_term(BVAdd, fa2, b2), fa2));
+  EXPECT_EQ(res[1], fa2);
+  EXPECT_EQ(tr.transfer_term(f), f2);
+  EXPECT_EQ(tr.transfer_term(fa), fa2);
+
+  // mappings in the cache are still respected
+  Term c2 = s2->make_symbol("c", s2->make_sort(BV, 4));
+  TermTranslator tr2(s2, s);
+  tr2.get_cache()[a] = c2;
+  EXPECT_EQ(tr2.transfer_term(s->make_term(BVAdd, a, b)),
+            s2->make_term(BVAdd, c2, b2));
+}
+
+TEST(UnitTermValueTests, FromString)
+{
+  EXPECT_EQ(TermValue::from_string("true", BOOL), TermValue::make_bool(true));
+  EXPECT_EQ(TermValue::from_string("#b1", BOOL), TermValue::make_bool(true));
+  EXPECT_EQ(TermValue::from_string("#b0101", BV), TermValue::make_bv(4, 5));
+  EXPECT_EQ(TermValue::from_string("#x0f", BV), TermValue::make_bv(8, 15));
+  EXPECT_EQ(TermValue::from_string("(_ bv12 8)", BV),
+            TermValue::make_bv(8, 12));
+  EXPECT_EQ(TermValue::from_string("12", BV, 8), TermValue::make_bv(8, 12));
+
+  TermValue big = TermValue::from_string("18446744073709551621", INT);
+  EXPECT_EQ(big.num, vector<uint64_t>({ 5, 1 }));
+  EXPECT_EQ(big.num_to_string(), "18446744073709551621");
+  EXPECT_FALSE(big.num_fits_int64());
+
+  TermValue neg = TermValue::make_int(-3);
+  EXPECT_EQ(TermValue::from_string("(- 3)", INT), neg);
+  EXPECT_EQ(TermValue::from_string("-3", INT), neg);
+  EXPECT_EQ(neg.get_int64(), -3);
+  EXPECT_EQ(neg.to_string(), "(- 3)");
+  EXPECT_EQ(TermValue::make_int(INT64_MIN).get_int64(), INT64_MIN);
+
+  TermValue third = TermValue::make_real(-1, 3);
+  EXPECT_EQ(TermValue::from_string("(- (/ 1 3))", REAL), third);
+  EXPECT_EQ(TermValue::from_string("(/ (- 1) 3)", REAL), third);
+  EXPECT_EQ(TermValue::from_string("(/ (- 1.0) 3.0)", REAL), third);
+  EXPECT_EQ(TermValue::from_string("-1/3", REAL), third);
+  EXPECT_EQ(third.to_string(), "(- (/ 1.0 3.0))");
+  EXPECT_EQ(TermValue::from_string("2.50", REAL), TermValue::make_real(5, 2));
+  EXPECT_EQ(TermValue::from_string("4.0", REAL), TermValue::make_real(4, 1));
+  EXPECT_EQ(TermValue::from_string("0.00", REAL), TermValue::make_real(0, 1));
+
+  // rationals are canonical, so equal values are equal and hash the same
+  TermValue two_thirds = TermValue::make_real(2, 3);
+  EXPECT_EQ(TermValue::make_real(6, 9), two_thirds);
+  EXPECT_EQ(TermValue::from_string("6/9", REAL), two_thirds);
+  EXPECT_EQ(TermValue::from_string("(/ 14 21)", REAL), two_thirds);
+  EXPECT_EQ(TermValue::from_string("0.666", REAL),
+            TermValue::make_real(333, 500));
+  EXPECT_EQ(TermValue::make_real(6, 9).hash(), two_thirds.hash());
+  // with a common factor larger than a word
+  TermValue big_third = TermValue::from_string(
+      "(/ 340282366920938463463374607431768211457 "
+      "1020847100762815390390123822295304634371)",
+      REAL);
+  EXPECT_EQ(big_third, TermValue::make_real(1, 3));
+  EXPECT_EQ(big_third.hash(), TermValue::make_real(1, 3).hash());
+
+  EXPECT_THROW(TermValue::from_string("1/2", INT), IncorrectUsageException);
+  EXPECT_THROW(TermValue::from_string("#b012", BV), IncorrectUsageException);
+  EXPECT_THROW(TermValue::make_real(1, 0), IncorrectUsageException);
+}
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedNativeTransferUnit,
+                         UnitNativeTransferTests,
+                         testing::ValuesIn(
+                             filter_non_generic_solver_configurations(
+                                 { TERMITER })));
+
+INSTANTIATE_TEST_SUITE_P(
+    ParameterizedValueTransferUnit,
+    UnitValueTransferTests,
+    testing::ValuesIn(filter_non_generic_solver_configurations(
+        { FULL_TRANSFER, THEORY_INT, THEORY_REAL })));
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedTransferUnit,
     UnitTransferTests,
@@ -14,6 +14,7 @@
 **
 **/
 
+#include <algorithm>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -135,6 +136,117 @@ TEST_P(UnitUtilTests, DisjunctivePartition)
   }
 }
 
+TEST_P(UnitUtilTests, TermDag)
+{
+  Term conjunction = symbols[0];
+  for (size_t j = 1; j < 10; ++j)
+  {
+    conjunction = s->make_term(And, conjunction, symbols[j]);
+  }
+  Term disjunction = s->make_term(Or, symbols[10], conjunction);
+  Term other = s->make_term(Xor, symbols[11], symbols[12]);
+
+  // counts the distinct subterms of some terms
+  auto num_subterms = [](const TermVec & roots) {
+    UnorderedTermSet visited;
+    TermVec to_visit(roots);
+    while (to_visit.size())
+    {
+      Term t = to_visit.back();
+      to_visit.pop_back();
+      if (visited.insert(t).second)
+      {
+        t->get_children(to_visit);
+      }
+    }
+    return visited.size();
+  };
+
+  TermDag dag({ conjunction, disjunction });
+  ASSERT_EQ(dag.get_roots().size(), 2);
+  size_t conj_idx = dag.get_roots()[0];
+  size_t disj_idx = dag.get_roots()[1];
+  EXPECT_EQ(dag.get_term(conj_idx), conjunction);
+  EXPECT_EQ(dag.find(disjunction), disj_idx);
+  EXPECT_EQ(dag.find(other), TermDag::npos);
+  EXPECT_EQ(dag.size(), num_subterms({ conjunction, disjunction }));
+
+  // nodes are topologically ordered
+  for (size_t i = 0; i < dag.size(); ++i)
+  {
+    EXPECT_EQ(dag.get_sort(i), dag.get_term(i)->get_sort());
+    ASSERT_EQ(dag.num_children(i), dag.get_term(i)->num_children());
+    size_t k = 0;
+    for (const size_t * c = dag.children_begin(i); c != dag.children_end(i);
+         ++c)
+    {
+      EXPECT_LT(*c, i);
+      EXPECT_EQ(dag.get_term(*c), dag.get_term(i)->get_child(k++));
+    }
+  }
+
+  // adding a root only adds the new nodes
+  EXPECT_EQ(dag.add_root(conjunction), conj_idx);
+  size_t other_idx = dag.add_root(other);
+  EXPECT_EQ(dag.size(), num_subterms({ conjunction, disjunction, other }));
+  EXPECT_EQ(other_idx, dag.size() - 1);
+
+  // the fast passes agree with the term versions
+  for (auto idx : { conj_idx, disj_idx, other_idx })
+  {
+    Term t = dag.get_term(idx);
+    TermVec expected, res;
+    conjunctive_partition(t, expected, true);
+    conjunctive_partition(dag, idx, res, true);
+    EXPECT_EQ(res, expected);
+
+    expected.clear();
+    res.clear();
+    disjunctive_partition(t, expected);
+    disjunctive_partition(dag, idx, res);
+    EXPECT_EQ(res, expected);
+  }
+
+  UnorderedTermSet expected_symbols, symbols_res;
+  for (auto r : { conjunction, disjunction, other })
+  {
+    get_free_symbols(r, expected_symbols);
+  }
+  get_free_symbols(dag, symbols_res);
+  EXPECT_EQ(symbols_res, expected_symbols);
+  EXPECT_EQ(symbols_res.size(), 13);
+
+  symbols_res.clear();
+  get_free_symbolic_consts(dag, symbols_res);
+  EXPECT_EQ(symbols_res, expected_symbols);
+
+  UnorderedOpSet expected_ops, ops_res;
+  for (auto r : { conjunction, disjunction, other })
+  {
+    get_ops(r, expected_ops);
+  }
+  get_ops(dag, ops_res);
+  EXPECT_EQ(ops_res, expected_ops);
+
+  expected_symbols.clear();
+  symbols_res.clear();
+  get_matching_terms(disjunction, expected_symbols, [](const Term & t) {
+    return t->is_symbolic_const();
+  });
+  get_matching_terms(
+      dag, disj_idx, symbols_res, [](const TermDag & d, size_t i) {
+        return d.is_symbolic_const(i);
+      });
+  EXPECT_EQ(symbols_res, expected_symbols);
+
+  vector<bool> in_cone;
+  dag.get_cone({ other_idx }, in_cone);
+  EXPECT_EQ(count(in_cone.begin(), in_cone.end(), true),
+            num_subterms({ other }));
+  EXPECT_TRUE(in_cone[other_idx]);
+  EXPECT_FALSE(in_cone[conj_idx]);
+}
+
 TEST_P(UnitUtilIntTests, Oracles)
 {
   SolverConfiguration c = GetParam();
@@ -175,6 +175,192 @@ TEST_P(UnitWalkerTests, FunSubstitution)
   EXPECT_EQ(fy, iw.visit(fx));
 }
 
+TEST_P(UnitWalkerTests, IdCache)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term f = s->make_symbol("f", funsort);
+  Term fx = s->make_term(Apply, f, x);
+  Term t = s->make_term(BVAdd, fx, s->make_term(BVMul, fx, y));
+
+  IdentityWalker iw(s, false, ID_CACHE);
+  EXPECT_EQ(t, iw.visit(t));
+  // visit a second time
+  EXPECT_EQ(t, iw.visit(t));
+  EXPECT_EQ(fx, iw.visit(fx));
+
+  IdentityWalker clearing_iw(s, true, ID_CACHE);
+  EXPECT_EQ(t, clearing_iw.visit(t));
+  EXPECT_EQ(t, clearing_iw.visit(t));
+
+  // the tree walker gives the same first occurrences with either cache
+  TreeWalker hash_tw(s, false, HASH_CACHE);
+  TreeWalker id_tw(s, false, ID_CACHE);
+  hash_tw.visit(t);
+  id_tw.visit(t);
+  for (auto sub : { t, fx, y })
+  {
+    pair<Term, vector<int>> hash_occ = hash_tw.visit(sub);
+    pair<Term, vector<int>> id_occ = id_tw.visit(sub);
+    EXPECT_EQ(hash_occ.first, t);
+    EXPECT_EQ(id_occ.first, hash_occ.first);
+    EXPECT_EQ(id_occ.second, hash_occ.second);
+  }
+}
+
+/* Custom Tree Walker that maps each term to the path of its parent
+ * occurrence instead of its own. Used to check that COMPACT_PATHS also
+ * handles paths other than the one currently being visited.
+ */
+class ParentPathTreeWalker : public TreeWalker
+{
+  using TreeWalker::TreeWalker;
+
+  TreeWalkerStepResult visit_term(smt::Term & formula,
+                                  smt::Term & term,
+                                  std::vector<int> & path) override
+  {
+    vector<int> parent_path(path);
+    if (!parent_path.empty())
+    {
+      parent_path.pop_back();
+    }
+    save_in_cache(term, { formula, parent_path });
+    return TreeWalker_Continue;
+  }
+};
+
+TEST_P(UnitWalkerTests, CompactPaths)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  TermVec subterms({ x, y });
+  Term t = x;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    t = s->make_term(i % 2 ? BVAdd : BVSub, y, t);
+    subterms.push_back(t);
+  }
+  Term t2 = s->make_term(BVMul, t, s->make_term(BVAdd, x, x));
+
+  for (auto cache_kind : { HASH_CACHE, ID_CACHE })
+  {
+    UnorderedTermPairMap passed_map;
+    TreeWalker full_tw(s, false, &passed_map);
+    TreeWalker compact_tw(s, false, cache_kind, COMPACT_PATHS);
+    full_tw.visit(t);
+    full_tw.visit(t2);
+    EXPECT_EQ(compact_tw.visit(t).first, t);
+    // not cleared, so occurrences from both formulas are kept
+    EXPECT_EQ(compact_tw.visit(t2).first, t2);
+
+    for (auto sub : subterms)
+    {
+      pair<Term, vector<int>> occ = compact_tw.visit(sub);
+      EXPECT_EQ(occ.first, passed_map.at(sub).first);
+      EXPECT_EQ(occ.second, passed_map.at(sub).second);
+    }
+
+    ParentPathTreeWalker full_pw(s, false, cache_kind);
+    ParentPathTreeWalker compact_pw(s, false, cache_kind, COMPACT_PATHS);
+    full_pw.visit(t);
+    compact_pw.visit(t);
+    for (auto sub : subterms)
+    {
+      pair<Term, vector<int>> full_occ = full_pw.visit(sub);
+      pair<Term, vector<int>> compact_occ = compact_pw.visit(sub);
+      EXPECT_EQ(compact_occ.first, full_occ.first);
+      EXPECT_EQ(compact_occ.second, full_occ.second);
+    }
+  }
+}
+
+/* Custom Tree Walker that throws when it reaches a given term
+ * Used to check that the walker can be used again after an exception.
+ */
+class ThrowingTreeWalker : public TreeWalker
+{
+ public:
+  using TreeWalker::TreeWalker;
+
+  Term throw_at;
+
+  /** only allowed during a traversal, i.e. throws otherwise */
+  void save_outside_visit(const Term & t)
+  {
+    save_current_occurrence_in_cache(t);
+  }
+
+ protected:
+  TreeWalkerStepResult visit_term(smt::Term & formula,
+                                  smt::Term & term,
+                                  std::vector<int> & path) override
+  {
+    if (throw_at && term == throw_at)
+    {
+      throw SmtException("stop");
+    }
+    return TreeWalker::visit_term(formula, term, path);
+  }
+};
+
+TEST_P(UnitWalkerTests, ExceptionInVisitTerm)
+{
+  Term x = s->make_symbol("x", bvsort);
+  Term y = s->make_symbol("y", bvsort);
+  Term xy = s->make_term(BVAdd, x, y);
+  Term t = s->make_term(BVMul, xy, y);
+
+  for (auto path_mode : { FULL_PATHS, COMPACT_PATHS })
+  {
+    ThrowingTreeWalker tw(s, false, HASH_CACHE, path_mode);
+    tw.throw_at = x;
+    EXPECT_THROW(tw.visit(t), SmtException);
+    // the traversal isn't current anymore
+    EXPECT_THROW(tw.save_outside_visit(x), IncorrectUsageException);
+
+    // the cached occurrences from before the exception are still valid
+    tw.throw_at = nullptr;
+    Term t2 = s->make_term(BVSub, y, x);
+    EXPECT_EQ(tw.visit(t2).first, t2);
+    pair<Term, vector<int>> occ = tw.visit(xy);
+    EXPECT_EQ(occ.first, t);
+    EXPECT_EQ(occ.second, vector<int>({ 0 }));
+    occ = tw.visit(x);
+    EXPECT_EQ(occ.first, t2);
+    EXPECT_EQ(occ.second, vector<int>({ 1 }));
+  }
+}
+
+TEST_P(UnitWalkerTests, TermIdMap)
+{
+  TermIdMap<int> m;
+  EXPECT_TRUE(m.empty());
+  TermVec terms;
+  for (size_t i = 0; i < 200; ++i)
+  {
+    terms.push_back(s->make_symbol("v" + std::to_string(i), bvsort));
+    EXPECT_TRUE(m.insert(terms.back(), i));
+  }
+  EXPECT_EQ(m.size(), terms.size());
+  for (size_t i = 0; i < terms.size(); ++i)
+  {
+    ASSERT_TRUE(m.contains(terms[i]));
+    EXPECT_EQ(*m.find(terms[i]), i);
+  }
+  // insert doesn't overwrite, but operator[] does
+  EXPECT_FALSE(m.insert(terms[0], 1000));
+  EXPECT_EQ(*m.find(terms[0]), 0);
+  m[terms[0]] = 1000;
+  EXPECT_EQ(*m.find(terms[0]), 1000);
+  EXPECT_EQ(m.size(), terms.size());
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_FALSE(m.contains(terms[0]));
+  EXPECT_EQ(m.find(terms[1]), nullptr);
+}
+
 /* helper function to test equivalency of passed_map that TreeWalker builds up
  * against expected_map that should have been built up. gets used for all tests
  * using TreeWalker */
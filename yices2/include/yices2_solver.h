@@ -17,6 +17,8 @@
 #pragma once
 
 #include <gmp.h>
+
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -28,6 +30,7 @@
 #include "yices2_sort.h"
 #include "yices2_term.h"
 
+#include "deadline_timer.h"
 #include "exceptions.h"
 #include "result.h"
 #include "smt.h"
@@ -45,7 +48,9 @@ class Yices2Solver : public AbsSmtSolver
       : AbsSmtSolver(YICES2),
         pushes_after_unsat(0),
         context_level(0),
-        time_limit(0)
+        time_limit(0),
+        timelimit_id(0),
+        timed_out(false)
   {
     // Had to move yices_init to the Factory
     // yices_init();
@@ -56,6 +61,7 @@ class Yices2Solver : public AbsSmtSolver
   Yices2Solver & operator=(const Yices2Solver &) = delete;
   ~Yices2Solver()
   {
+    DeadlineTimer::get().cancel(timelimit_id);
     // need to destruct all stored terms in symbol_table
     symbol_table.clear();
 
@@ -73,10 +79,12 @@ class Yices2Solver : public AbsSmtSolver
   Result check_sat_assuming(const TermVec & assumptions) override;
   Result check_sat_assuming_list(const TermList & assumptions) override;
   Result check_sat_assuming_set(const UnorderedTermSet & assumptions) override;
+  void interrupt() override;
   void push(uint64_t num = 1) override;
   void pop(uint64_t num = 1) override;
   uint64_t get_context_level() const override;
   Term get_value(const Term & t) const override;
+  void get_values(const TermVec & terms, TermVec & out) const override;
   UnorderedTermMap get_array_values(const Term & arr,
                                     Term & out_const_base) const override;
   void get_unsat_assumptions(UnorderedTermSet & out) override;
@@ -111,6 +119,7 @@ class Yices2Solver : public AbsSmtSolver
                  const Sort & sort,
                  uint64_t base = 10) const override;
   Term make_term(const Term & val, const Sort & sort) const override;
+  Term import_value(const TermValue & val, const Sort & sort) const override;
   Term make_symbol(const std::string name, const Sort & sort) override;
   Term get_symbol(const std::string & name) override;
   Term make_param(const std::string name, const Sort & sort) override;
@@ -122,6 +131,12 @@ class Yices2Solver : public AbsSmtSolver
                  const Term & t1,
                  const Term & t2) const override;
   Term make_term(Op op, const TermVec & terms) const override;
+  void make_terms(const TermVec & leaves,
+                  const std::vector<Op> & ops,
+                  const std::vector<std::size_t> & child_offsets,
+                  const std::vector<std::size_t> & children,
+                  TermVec & out) const override;
+  Term translate_native(const Term & t, const AbsSmtSolver & source) override;
   void reset() override;
   void reset_assertions() override;
   Term substitute(const Term term,
@@ -139,6 +154,8 @@ class Yices2Solver : public AbsSmtSolver
   uint64_t context_level;  ///< incremental solving context
 
   uint64_t time_limit;
+  DeadlineTimer::Id timelimit_id;  ///< deadline of the running query
+  std::atomic<bool> timed_out;     ///< set when the time limit is reached
 
   std::unordered_map<std::string, Term> symbol_table;
   ///< Keep track of declared symbols to avoid re-declaration
@@ -169,6 +186,10 @@ class Yices2Solver : public AbsSmtSolver
     {
       return Result(UNSAT);
     }
+    else if (res == STATUS_INTERRUPTED && !tl_triggered)
+    {
+      return Result(UNKNOWN, "Interrupted.");
+    }
     else
     {
       return Result(UNKNOWN);
@@ -176,7 +197,7 @@ class Yices2Solver : public AbsSmtSolver
   }
 
   /** Helper function for managing time limits (if one is set)
-   *  Registers a signal handler to use with alarm
+   *  Schedules a deadline that stops the search of this context.
    */
   void timelimit_start();
 
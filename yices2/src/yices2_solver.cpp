@@ -17,8 +17,6 @@
 #include "yices2_solver.h"
 
 #include <inttypes.h>
-#include <signal.h>
-#include <unistd.h>
 
 #include "solver_utils.h"
 #include "yices.h"
@@ -28,18 +26,6 @@ using namespace std;
 
 namespace smt {
 
-// global variables for signal handling
-// (used to support time limit)
-context_t * running_ctx = nullptr;
-bool yices2_terminated = false;
-
-void yices2_timelimit_handler(int signum)
-{
-  assert(running_ctx != nullptr);
-  yices_stop_search(running_ctx);
-  yices2_terminated = true;
-}
-
 /* Yices2 Op mappings */
 typedef term_t (*yices_un_fun)(term_t);
 typedef term_t (*yices_bin_fun)(term_t, term_t);
@@ -248,6 +234,82 @@ Term Yices2Solver::make_term(int64_t i, const Sort & sort) const
   return std::make_shared<Yices2Term> (y_term);
 }
 
+Term Yices2Solver::import_value(const TermValue & val, const Sort & sort) const
+{
+  TermValue v = cast_value_for_import(val, sort);
+  term_t y_term;
+
+  if (v.kind == BOOL)
+  {
+    y_term = v.get_bool() ? yices_true() : yices_false();
+  }
+  else if (v.kind == BV)
+  {
+    if (v.width <= 64)
+    {
+      y_term = yices_bvconst_uint64(v.width, v.get_uint64());
+    }
+    else
+    {
+      std::vector<int32_t> bits(v.width);
+      for (uint64_t i = 0; i < v.width; ++i)
+      {
+        bits[i] = (v.num[i / 64] >> (i % 64)) & 1;
+      }
+      y_term = yices_bvconst_from_array(v.width, bits.data());
+    }
+  }
+  else
+  {
+    assert(v.kind == INT || v.kind == REAL);
+    bool integral = (v.kind == INT || v.den == std::vector<uint64_t>({ 1 }));
+    if (integral && v.num_fits_int64())
+    {
+      y_term = yices_int64(v.get_int64());
+    }
+    else if (v.num_fits_int64() && v.den_fits_int64())
+    {
+      y_term = yices_rational64(v.get_int64(), v.get_den_int64());
+    }
+    else
+    {
+      mpq_t q;
+      mpq_init(q);
+      mpz_import(mpq_numref(q),
+                 v.num.size(),
+                 -1,
+                 sizeof(uint64_t),
+                 0,
+                 0,
+                 v.num.data());
+      if (v.negative)
+      {
+        mpz_neg(mpq_numref(q), mpq_numref(q));
+      }
+      if (v.kind == REAL)
+      {
+        mpz_import(mpq_denref(q),
+                   v.den.size(),
+                   -1,
+                   sizeof(uint64_t),
+                   0,
+                   0,
+                   v.den.data());
+      }
+      y_term = yices_mpq(q);
+      mpq_clear(q);
+    }
+  }
+
+  if (yices_error_code() != 0)
+  {
+    std::string msg(yices_error_string());
+    throw InternalSolverException(msg.c_str());
+  }
+
+  return std::make_shared<Yices2Term>(y_term);
+}
+
 Term Yices2Solver::make_term(const std::string val,
                              const Sort & sort,
                              uint64_t base) const
@@ -338,12 +400,22 @@ Result Yices2Solver::check_sat()
   {
     return Result(UNKNOWN, "Time limit reached.");
   }
+  else if (res == STATUS_INTERRUPTED)
+  {
+    return Result(UNKNOWN, "Interrupted.");
+  }
   else
   {
     return Result(UNKNOWN);
   }
 }
 
+void Yices2Solver::interrupt()
+{
+  // no-op if the context is not currently searching
+  yices_stop_search(ctx);
+}
+
 Result Yices2Solver::check_sat_assuming(const TermVec & assumptions)
 {
   vector<term_t> y_assumps;
@@ -440,6 +512,40 @@ Term Yices2Solver::get_value(const Term & t) const
   }
 }
 
+void Yices2Solver::get_values(const TermVec & terms, TermVec & out) const
+{
+  std::vector<term_t> yterms;
+  yterms.reserve(terms.size());
+  for (const auto & t : terms)
+  {
+    term_t yt = static_pointer_cast<Yices2Term>(t)->term;
+    if (yices_term_is_function(yt))
+    {
+      throw NotImplementedException(
+          "Yices does not support get-value for arrays.");
+    }
+    yterms.push_back(yt);
+  }
+
+  // evaluate all terms in a single model
+  model_t * model = yices_get_model(ctx, true);
+  std::vector<term_t> yvals(yterms.size());
+  int32_t res = yices_term_array_value(
+      model, yterms.size(), yterms.data(), yvals.data());
+  yices_free_model(model);
+  if (res < 0)
+  {
+    throw InternalSolverException("Yices get_values failed: "
+                                  + string(yices_error_string()));
+  }
+
+  out.reserve(out.size() + yvals.size());
+  for (auto v : yvals)
+  {
+    out.push_back(std::make_shared<Yices2Term>(v));
+  }
+}
+
 UnorderedTermMap Yices2Solver::get_array_values(const Term & arr,
                                                 Term & out_const_base) const
 {
@@ -1009,6 +1115,200 @@ Term Yices2Solver::make_term(Op op, const TermVec & terms) const
   return std::make_shared<Yices2Term> (res);
 }
 
+// helper for make_terms
+// applies an operator with an n-ary Yices constructor to args
+// (which may be reordered by Yices)
+// returns NULL_TERM if there is no such constructor for the operator
+static term_t make_nary_term(PrimOp po, vector<term_t> & args)
+{
+  uint32_t n = args.size();
+  term_t * a = args.data();
+  switch (po)
+  {
+    case And: return yices_and(n, a);
+    case Or: return yices_or(n, a);
+    case Xor: return yices_xor(n, a);
+    case Distinct: return yices_distinct(n, a);
+    case Plus: return yices_sum(n, a);
+    case Mult: return yices_product(n, a);
+    case Concat: return yices_bvconcat(n, a);
+    case BVAnd: return yices_bvand(n, a);
+    case BVOr: return yices_bvor(n, a);
+    case BVXor: return yices_bvxor(n, a);
+    case BVAdd: return yices_bvsum(n, a);
+    case BVMul: return yices_bvproduct(n, a);
+    default: return NULL_TERM;
+  }
+}
+
+void Yices2Solver::make_terms(const TermVec & leaves,
+                              const vector<Op> & ops,
+                              const vector<size_t> & child_offsets,
+                              const vector<size_t> & children,
+                              TermVec & out) const
+{
+  check_make_terms_args(leaves.size(), ops, child_offsets, children);
+
+  size_t num_leaves = leaves.size();
+  size_t out_start = out.size();
+  out.reserve(out_start + ops.size());
+  auto get_node = [&](size_t idx) -> const Term & {
+    return idx < num_leaves ? leaves[idx] : out[out_start + idx - num_leaves];
+  };
+
+  // reused for every operator, instead of a TermVec per term
+  vector<term_t> yargs;
+  TermVec args;
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    size_t begin = child_offsets[i];
+    size_t end = child_offsets[i + 1];
+    if (!ops[i].num_idx && end - begin >= 2)
+    {
+      yargs.clear();
+      for (size_t j = begin; j < end; ++j)
+      {
+        yargs.push_back(
+            static_pointer_cast<Yices2Term>(get_node(children[j]))->term);
+      }
+      term_t res = make_nary_term(ops[i].prim_op, yargs);
+      if (yices_error_code() != 0)
+      {
+        std::string msg(yices_error_string());
+        throw InternalSolverException(msg.c_str());
+      }
+      if (res != NULL_TERM)
+      {
+        out.push_back(std::make_shared<Yices2Term>(res));
+        continue;
+      }
+    }
+
+    // no n-ary constructor, build it like make_term
+    args.clear();
+    for (size_t j = begin; j < end; ++j)
+    {
+      args.push_back(get_node(children[j]));
+    }
+    out.push_back(Yices2Solver::make_term(ops[i], args));
+  }
+}
+
+// helper for translate_native
+// collects all uninterpreted terms (symbols) that occur in t
+static void collect_uninterpreted_terms(term_t t, vector<term_t> & out)
+{
+  unordered_set<term_t> visited;
+  vector<term_t> to_visit({ t });
+  vector<int32_t> bv_coeff;
+  mpq_t coeff;
+  mpq_init(coeff);
+  term_t child;
+  uint32_t exp;
+  while (to_visit.size())
+  {
+    term_t cur = to_visit.back();
+    to_visit.pop_back();
+    if (cur == NULL_TERM || !visited.insert(cur).second)
+    {
+      continue;
+    }
+
+    term_constructor_t tc = yices_term_constructor(cur);
+    int32_t num_children = yices_term_num_children(cur);
+    if (tc == YICES_UNINTERPRETED_TERM)
+    {
+      out.push_back(cur);
+    }
+    else if (tc == YICES_SELECT_TERM || tc == YICES_BIT_TERM)
+    {
+      to_visit.push_back(yices_proj_arg(cur));
+    }
+    else if (tc == YICES_ARITH_SUM)
+    {
+      for (int32_t i = 0; i < num_children; ++i)
+      {
+        yices_sum_component(cur, i, coeff, &child);
+        to_visit.push_back(child);
+      }
+    }
+    else if (tc == YICES_BV_SUM)
+    {
+      bv_coeff.resize(yices_term_bitsize(cur));
+      for (int32_t i = 0; i < num_children; ++i)
+      {
+        yices_bvsum_component(cur, i, bv_coeff.data(), &child);
+        to_visit.push_back(child);
+      }
+    }
+    else if (tc == YICES_POWER_PRODUCT)
+    {
+      for (int32_t i = 0; i < num_children; ++i)
+      {
+        yices_product_component(cur, i, &child, &exp);
+        to_visit.push_back(child);
+      }
+    }
+    else if (yices_term_is_composite(cur))
+    {
+      for (int32_t i = 0; i < num_children; ++i)
+      {
+        to_visit.push_back(yices_term_child(cur, i));
+      }
+    }
+  }
+  mpq_clear(coeff);
+}
+
+Term Yices2Solver::translate_native(const Term & t,
+                                    const AbsSmtSolver & source)
+{
+  const Yices2Solver * src = dynamic_cast<const Yices2Solver *>(&source);
+  shared_ptr<Yices2Term> yt = dynamic_pointer_cast<Yices2Term>(t);
+  if (!src || !yt)
+  {
+    return Term();
+  }
+
+  // yices terms live in a global term table shared by all contexts
+  // so the term itself can be reused, only the symbols need to be
+  // registered with this solver
+  vector<term_t> uninterpreted;
+  collect_uninterpreted_terms(yt->term, uninterpreted);
+  vector<pair<string, Term>> new_symbols;
+  for (auto u : uninterpreted)
+  {
+    const char * name = yices_get_term_name(u);
+    if (!name)
+    {
+      continue;
+    }
+    auto it = src->symbol_table.find(name);
+    if (it == src->symbol_table.end()
+        || static_pointer_cast<Yices2Term>(it->second)->term != u)
+    {
+      continue;
+    }
+
+    auto existing = symbol_table.find(name);
+    if (existing == symbol_table.end())
+    {
+      new_symbols.push_back(*it);
+    }
+    else if (static_pointer_cast<Yices2Term>(existing->second)->term != u)
+    {
+      // this solver has a different symbol with the same name
+      return Term();
+    }
+  }
+
+  for (const auto & elem : new_symbols)
+  {
+    symbol_table[elem.first] = elem.second;
+  }
+  return t;
+}
+
 void Yices2Solver::reset()
 {
   yices_reset();
@@ -1062,11 +1362,15 @@ void Yices2Solver::timelimit_start()
 {
   if (time_limit)
   {
-    signal(SIGALRM, yices2_timelimit_handler);
-    assert(running_ctx == nullptr);
-    assert(!yices2_terminated);
-    running_ctx = ctx;
-    alarm(time_limit);
+    // a previous query might have thrown before timelimit_end
+    DeadlineTimer::get().cancel(timelimit_id);
+    timed_out = false;
+    // yices_stop_search is a no-op if the context is not searching
+    timelimit_id = DeadlineTimer::get().schedule(
+        std::chrono::seconds(time_limit), [this]() {
+          timed_out = true;
+          yices_stop_search(ctx);
+        });
   }
 }
 
@@ -1075,10 +1379,11 @@ bool Yices2Solver::timelimit_end()
   bool res = false;
   if (time_limit)
   {
-    res |= yices2_terminated;
-    yices2_terminated = false;
-    running_ctx = nullptr;
-    alarm(0);
+    // waits for the deadline callback if it is running
+    DeadlineTimer::get().cancel(timelimit_id);
+    timelimit_id = 0;
+    res |= timed_out;
+    timed_out = false;
   }
   return res;
 }
@@ -472,6 +472,24 @@ TermIter Yices2Term::end()
   // return TermIter(new Yices2TermIter(term, yices_term_num_children(term)));
 }
 
+size_t Yices2Term::num_children()
+{
+  throw NotImplementedException(
+      "Term iteration not implemented for Yices backend.");
+}
+
+Term Yices2Term::get_child(size_t i)
+{
+  throw NotImplementedException(
+      "Term iteration not implemented for Yices backend.");
+}
+
+void Yices2Term::get_children(TermVec & out)
+{
+  throw NotImplementedException(
+      "Term iteration not implemented for Yices backend.");
+}
+
 std::string Yices2Term::print_value_as(SortKind sk)
 {
   if (!is_value())
@@ -482,6 +500,64 @@ std::string Yices2Term::print_value_as(SortKind sk)
   return to_string();
 }
 
+// helper for export_value
+// returns the words of the magnitude of z, least significant first
+static std::vector<uint64_t> mpz_to_words(const mpz_t z)
+{
+  std::vector<uint64_t> words((mpz_sizeinbase(z, 2) + 63) / 64);
+  size_t count;
+  mpz_export(words.data(), &count, -1, sizeof(uint64_t), 0, 0, z);
+  words.resize(count);
+  return words;
+}
+
+bool Yices2Term::export_value(TermValue & out)
+{
+  term_constructor_t tc = yices_term_constructor(term);
+  if (tc == YICES_BOOL_CONSTANT)
+  {
+    int32_t val;
+    yices_bool_const_value(term, &val);
+    out = TermValue::make_bool(val);
+  }
+  else if (tc == YICES_BV_CONSTANT)
+  {
+    uint32_t width = yices_term_bitsize(term);
+    std::vector<int32_t> bits(width);
+    yices_bv_const_value(term, bits.data());
+    std::vector<uint64_t> words((width + 63) / 64, 0);
+    for (uint32_t i = 0; i < width; ++i)
+    {
+      words[i / 64] |= (uint64_t)(bits[i] & 1) << (i % 64);
+    }
+    out = TermValue::make_bv(width, words);
+  }
+  else if (tc == YICES_ARITH_CONSTANT)
+  {
+    mpq_t q;
+    mpq_init(q);
+    yices_rational_const_value(term, q);
+    std::vector<uint64_t> num = mpz_to_words(mpq_numref(q));
+    std::vector<uint64_t> den = mpz_to_words(mpq_denref(q));
+    bool negative = mpq_sgn(q) < 0;
+    mpq_clear(q);
+
+    if (yices_term_is_int(term))
+    {
+      out = TermValue::make_int(negative, num);
+    }
+    else
+    {
+      out = TermValue::make_real(negative, num, den);
+    }
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
 string Yices2Term::const_to_string() const
 {
   term_constructor_t tc = yices_term_constructor(term);
@@ -92,7 +92,11 @@ class Z3Term : public AbsTerm
   /* Iterators for traversing the children */
   TermIter begin() override;
   TermIter end() override;
+  std::size_t num_children() override;
+  Term get_child(std::size_t i) override;
+  void get_children(TermVec & out) override;
   std::string print_value_as(SortKind sk) override;
+  bool export_value(TermValue & out) override;
 
   // getters for solver-specific objects (EXPERTS only)
   expr get_z3_expr()
@@ -146,6 +146,14 @@ void Z3Solver::set_opt(const std::string option, const std::string value)
     unsigned milliseconds = stoi(value)*1000;
     slv.set("timeout", milliseconds);
   }
+  else if (option == "resource-limit")
+  {
+    slv.set("rlimit", static_cast<unsigned>(stoul(value)));
+  }
+  else if (option == "random-seed")
+  {
+    slv.set("random_seed", static_cast<unsigned>(stoul(value)));
+  }
   else if (option == "produce-unsat-assumptions")
   {
     if (value == "true")
@@ -348,6 +356,58 @@ Term Z3Solver::make_term(const std::string val,
   return std::make_shared<Z3Term>(z_term, ctx);
 }
 
+Term Z3Solver::import_value(const TermValue & val, const Sort & sort) const
+{
+  TermValue v = cast_value_for_import(val, sort);
+  expr z_term = expr(ctx);
+
+  if (v.kind == BOOL)
+  {
+    z_term = ctx.bool_val(v.get_bool());
+  }
+  else if (v.kind == BV)
+  {
+    if (v.width <= 64)
+    {
+      z_term = ctx.bv_val(v.get_uint64(), v.width);
+    }
+    else
+    {
+      std::unique_ptr<bool[]> bits(new bool[v.width]);
+      for (uint64_t i = 0; i < v.width; ++i)
+      {
+        bits[i] = (v.num[i / 64] >> (i % 64)) & 1;
+      }
+      z_term = ctx.bv_val((unsigned)v.width, bits.get());
+    }
+  }
+  else
+  {
+    assert(v.kind == INT || v.kind == REAL);
+    bool integral = (v.kind == INT || v.den == std::vector<uint64_t>({ 1 }));
+    if (integral && v.num_fits_int64())
+    {
+      z_term = (v.kind == INT) ? ctx.int_val(v.get_int64())
+                               : ctx.real_val(v.get_int64());
+    }
+    else
+    {
+      std::string sval = (v.negative ? "-" : "") + v.num_to_string();
+      if (v.kind == INT)
+      {
+        z_term = ctx.int_val(sval.c_str());
+      }
+      else
+      {
+        sval += "/" + v.den_to_string();
+        z_term = ctx.real_val(sval.c_str());
+      }
+    }
+  }
+
+  return std::make_shared<Z3Term>(z_term, ctx);
+}
+
 Term Z3Solver::make_term(const Term & val, const Sort & sort) const
 {
   std::shared_ptr<Z3Term> zterm = std::static_pointer_cast<Z3Term>(val);
@@ -456,6 +516,8 @@ Result Z3Solver::check_sat_assuming_set(const UnorderedTermSet & assumptions)
   return check_sat_assuming(z3assumps);
 }
 
+void Z3Solver::interrupt() { Z3_solver_interrupt(ctx, slv); }
+
 void Z3Solver::push(uint64_t num)
 {
   for (int i = 0; i < num; i++)
@@ -485,6 +547,23 @@ Term Z3Solver::get_value(const Term & t) const
   return std::make_shared<Z3Term>(eval, ctx);
 }
 
+void Z3Solver::get_values(const TermVec & terms, TermVec & out) const
+{
+  // get the model once and evaluate all terms in it
+  z3::model model = slv.get_model();
+  out.reserve(out.size() + terms.size());
+  for (const auto & t : terms)
+  {
+    shared_ptr<Z3Term> zterm = static_pointer_cast<Z3Term>(t);
+    if (zterm->is_function)
+    {
+      throw IncorrectUsageException("Cannot evaluate a function.");
+    }
+    expr eval = model.eval(zterm->term, true);
+    out.push_back(std::make_shared<Z3Term>(eval, ctx));
+  }
+}
+
 UnorderedTermMap Z3Solver::get_array_values(const Term & arr,
                                             Term & out_const_base) const
 {
@@ -1085,6 +1164,127 @@ Term Z3Solver::make_term(Op op, const TermVec & terms) const
   }
 }
 
+// helper for translate_native
+// collects the declarations of all uninterpreted constants and functions
+// that occur in e
+static void collect_uninterpreted_decls(const expr & e,
+                                        vector<func_decl> & out)
+{
+  unordered_set<unsigned> visited;
+  vector<expr> to_visit({ e });
+  while (to_visit.size())
+  {
+    expr cur = to_visit.back();
+    to_visit.pop_back();
+    if (!visited.insert(cur.id()).second)
+    {
+      continue;
+    }
+
+    if (cur.is_app())
+    {
+      func_decl decl = cur.decl();
+      if (decl.decl_kind() == Z3_OP_UNINTERPRETED)
+      {
+        out.push_back(decl);
+      }
+      for (unsigned i = 0; i < cur.num_args(); ++i)
+      {
+        to_visit.push_back(cur.arg(i));
+      }
+    }
+    else if (cur.is_quantifier())
+    {
+      to_visit.push_back(cur.body());
+    }
+  }
+}
+
+Term Z3Solver::translate_native(const Term & t, const AbsSmtSolver & source)
+{
+  const Z3Solver * src = dynamic_cast<const Z3Solver *>(&source);
+  shared_ptr<Z3Term> zt = dynamic_pointer_cast<Z3Term>(t);
+  if (!src || !zt || zt->is_parameter)
+  {
+    return Term();
+  }
+  else if (src == this)
+  {
+    return t;
+  }
+
+  Z3_context src_ctx = src->ctx;
+  auto translate_decl = [&](const func_decl & decl) {
+    Z3_ast a = Z3_translate(src_ctx, Z3_func_decl_to_ast(src_ctx, decl), ctx);
+    return func_decl(ctx, Z3_to_func_decl(ctx, a));
+  };
+  // the declaration of a symbol term
+  auto get_decl = [](const Term & sym) {
+    shared_ptr<Z3Term> zsym = static_pointer_cast<Z3Term>(sym);
+    return zsym->is_function ? zsym->z_func : zsym->term.decl();
+  };
+
+  vector<func_decl> decls;
+  if (zt->is_function)
+  {
+    // only function symbols can be translated
+    auto it = src->symbol_table.find(zt->z_func.name().str());
+    if (it == src->symbol_table.end()
+        || get_decl(it->second).id() != zt->z_func.id())
+    {
+      return Term();
+    }
+    decls.push_back(zt->z_func);
+  }
+  else
+  {
+    collect_uninterpreted_decls(zt->term, decls);
+  }
+
+  // find the symbols of the source solver and check that they
+  // don't clash with symbols of this solver
+  // other uninterpreted constants are (unbound) parameters
+  vector<pair<string, Term>> new_symbols;
+  for (const auto & decl : decls)
+  {
+    string name = decl.name().str();
+    auto it = src->symbol_table.find(name);
+    if (it == src->symbol_table.end()
+        || get_decl(it->second).id() != decl.id())
+    {
+      continue;
+    }
+
+    func_decl new_decl = translate_decl(decl);
+    auto existing = symbol_table.find(name);
+    if (existing != symbol_table.end())
+    {
+      if (get_decl(existing->second).id() != new_decl.id())
+      {
+        return Term();
+      }
+      continue;
+    }
+
+    new_symbols.push_back(
+        { name,
+          new_decl.arity() ? make_shared<Z3Term>(new_decl, ctx)
+                           : make_shared<Z3Term>(new_decl(), ctx) });
+  }
+
+  for (const auto & elem : new_symbols)
+  {
+    symbol_table[elem.first] = elem.second;
+  }
+
+  if (zt->is_function)
+  {
+    return symbol_table.at(zt->z_func.name().str());
+  }
+  expr res(ctx, Z3_translate(src_ctx, zt->term, ctx));
+  return make_shared<Z3Term>(res, ctx);
+}
+
 void Z3Solver::reset() { slv.reset(); }
 
 void Z3Solver::reset_assertions() { slv.reset(); }
@@ -10,6 +10,30 @@ using namespace std;
 
 namespace smt {
 
+// helpers
+
+// smt-switch treats the function of an uninterpreted function
+// application as the first child
+static bool is_function_app(const expr & e)
+{
+  return e.is_app() && (e.decl().decl_kind() == Z3_OP_UNINTERPRETED)
+         && !e.is_const();
+}
+
+static Term make_child(const expr & e, bool fun_app, uint32_t pos)
+{
+  if (!pos && fun_app)
+  {
+    return std::make_shared<Z3Term>(e.decl(), e.ctx());
+  }
+  else
+  {
+    uint32_t actual_idx = fun_app ? pos - 1 : pos;
+    expr z_child = e.arg(actual_idx);
+    return std::make_shared<Z3Term>(z_child, z_child.ctx());
+  }
+}
+
 // Z3TermIter implementation
 
 Z3TermIter & Z3TermIter::operator=(const Z3TermIter & it)
@@ -25,19 +49,7 @@ void Z3TermIter::operator++() { pos++; }
 const Term Z3TermIter::operator*()
 {
   assert(!null_term);
-  bool is_function_app = term.is_app()
-                         && (term.decl().decl_kind() == Z3_OP_UNINTERPRETED)
-                         && !term.is_const();
-  if (!pos && is_function_app)
-  {
-    return std::make_shared<Z3Term>(term.decl(), term.ctx());
-  }
-  else
-  {
-    uint32_t actual_idx = is_function_app ? pos - 1 : pos;
-    expr z_child = term.arg(actual_idx);
-    return std::make_shared<Z3Term>(z_child, z_child.ctx());
-  }
+  return make_child(term, is_function_app(term), pos);
 }
 
 TermIterBase * Z3TermIter::clone() const
@@ -379,11 +391,8 @@ TermIter Z3Term::end()
     return TermIter(new Z3TermIter(term, 0, true));
   }
 
-  bool is_function_app = term.is_app()
-                         && (term.decl().decl_kind() == Z3_OP_UNINTERPRETED)
-                         && !term.is_const();
   uint32_t num_args = term.num_args();
-  if (is_function_app)
+  if (is_function_app(term))
   {
     // smt-switch treats the function as an argument
     num_args++;
@@ -392,6 +401,49 @@ TermIter Z3Term::end()
   return TermIter(new Z3TermIter(term, num_args));
 }
 
+size_t Z3Term::num_children()
+{
+  if (is_function)
+  {
+    return 0;
+  }
+
+  if (term.is_quantifier())
+  {
+    throw NotImplementedException(
+        string("Z3 backend does not currently ")
+        + "support getting parameters from quantified "
+        + "expression. Use logging if required.");
+  }
+  size_t num_args = term.num_args();
+  return is_function_app(term) ? num_args + 1 : num_args;
+}
+
+Term Z3Term::get_child(size_t i)
+{
+  if (i >= num_children())
+  {
+    throw IncorrectUsageException("Child index " + std::to_string(i)
+                                  + " out of range in get_child");
+  }
+  return make_child(term, is_function_app(term), i);
+}
+
+void Z3Term::get_children(TermVec & out)
+{
+  size_t num_args = num_children();
+  if (!num_args)
+  {
+    return;
+  }
+
+  bool fun_app = is_function_app(term);
+  for (size_t i = 0; i < num_args; ++i)
+  {
+    out.push_back(make_child(term, fun_app, i));
+  }
+}
+
 std::string Z3Term::print_value_as(SortKind sk)
 {
   if (!is_value())
@@ -402,6 +454,66 @@ std::string Z3Term::print_value_as(SortKind sk)
   return term.to_string();
 }
 
+bool Z3Term::export_value(TermValue & out)
+{
+  if (is_function)
+  {
+    return false;
+  }
+  else if (term.is_true() || term.is_false())
+  {
+    out = TermValue::make_bool(term.is_true());
+    return true;
+  }
+  else if (!term.is_numeral())
+  {
+    return false;
+  }
+
+  if (term.is_bv())
+  {
+    uint64_t width = term.get_sort().bv_size();
+    uint64_t val;
+    if (width <= 64 && Z3_get_numeral_uint64(*ctx, term, &val))
+    {
+      out = TermValue::make_bv(width, val);
+    }
+    else
+    {
+      out = TermValue::from_string(
+          Z3_get_numeral_string(*ctx, term), BV, width);
+    }
+    return true;
+  }
+  else if (term.is_int())
+  {
+    int64_t val;
+    if (Z3_get_numeral_int64(*ctx, term, &val))
+    {
+      out = TermValue::make_int(val);
+    }
+    else
+    {
+      out = TermValue::from_string(Z3_get_numeral_string(*ctx, term), INT);
+    }
+    return true;
+  }
+  else if (term.is_real())
+  {
+    int64_t num, den;
+    if (Z3_get_numeral_rational_int64(*ctx, term, &num, &den))
+    {
+      out = TermValue::make_real(num, den);
+    }
+    else
+    {
+      out = TermValue::from_string(Z3_get_numeral_string(*ctx, term), REAL);
+    }
+    return true;
+  }
+  return false;
+}
+
 // string Z3Term::const_to_string() const {
 //	return term.to_string();
 //}